@@ -1,13 +1,186 @@
 #pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "simd.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
 
 namespace ft {
 
+namespace detail {
+
+template <class ForwardIterator, class T>
+void fill(
+	ForwardIterator first, ForwardIterator last, const T &value, false_type) {
+	while (first != last) {
+		*first++ = value;
+	}
+}
+
+template <class U, class Size, class T>
+U *fill_n(U *first, Size count, const T &value, true_type);
+
+template <class U, class T>
+void fill(U *first, U *last, const T &value, true_type) {
+	fill_n(first, last - first, value, true_type());
+}
+
+template <class OutputIterator, class Size, class T>
+OutputIterator fill_n(
+	OutputIterator first, Size count, const T &value, false_type) {
+	for (Size i = 0; i < count; i++) {
+		*first++ = value;
+	}
+	return first;
+}
+
+// Repeats the bytes of the value over 16 bytes and stores that, memset for
+// single bytes
+template <class U, class Size, class T>
+U *fill_n(U *first, Size count, const T &value, true_type) {
+	if (!(count > 0)) {
+		return first;
+	}
+	const U       element = value;
+	unsigned char pattern[16];
+	for (std::size_t i = 0; i < sizeof(pattern); i += sizeof(U)) {
+		std::memcpy(pattern + i, &element, sizeof(U));
+	}
+	if (sizeof(U) == 1) {
+		std::memset(first, pattern[0], count);
+	} else {
+		fill_pattern(first, count * sizeof(U), pattern);
+	}
+	return first + count;
+}
+
+template <class InputIterator, class OutputIterator>
+OutputIterator copy(InputIterator first, InputIterator last,
+	OutputIterator d_first, false_type) {
+	while (first != last) {
+		*d_first++ = *first++;
+	}
+	return d_first;
+}
+
+// memmove rather than memcpy, the ranges may overlap as long as d_first is
+// not inside [first, last), which copy allows
+template <class T, class U>
+U *copy(T *first, T *last, U *d_first, true_type) {
+	const std::ptrdiff_t n = last - first;
+
+	if (n > 0) {
+		std::memmove(d_first, first, n * sizeof(U));
+	}
+	return d_first + n;
+}
+
+template <class BidirIt1, class BidirIt2>
+BidirIt2 copy_backward(
+	BidirIt1 first, BidirIt1 last, BidirIt2 d_last, false_type) {
+	while (first != last) {
+		*--d_last = *--last;
+	}
+	return d_last;
+}
+
+template <class T, class U>
+U *copy_backward(T *first, T *last, U *d_last, true_type) {
+	const std::ptrdiff_t n = last - first;
+
+	if (n > 0) {
+		std::memmove(d_last - n, first, n * sizeof(U));
+	}
+	return d_last - n;
+}
+
+template <class InputIterator, class OutputIterator>
+OutputIterator move(InputIterator first, InputIterator last,
+	OutputIterator d_first, false_type) {
+	while (first != last) {
+		*d_first++ = FT_MOVE(*first++);
+	}
+	return d_first;
+}
+
+template <class T, class U>
+U *move(T *first, T *last, U *d_first, true_type) {
+	return copy(first, last, d_first, true_type());
+}
+
+template <class BidirIt1, class BidirIt2>
+BidirIt2 move_backward(
+	BidirIt1 first, BidirIt1 last, BidirIt2 d_last, false_type) {
+	while (first != last) {
+		*--d_last = FT_MOVE(*--last);
+	}
+	return d_last;
+}
+
+template <class T, class U>
+U *move_backward(T *first, T *last, U *d_last, true_type) {
+	return copy_backward(first, last, d_last, true_type());
+}
+
+template <class InputIt1, class InputIt2>
+bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+	InputIt2 first2, InputIt2 last2, false_type) {
+	while (first1 != last1 && first2 != last2) {
+		if (*first1 < *first2) {
+			return true;
+		}
+		if (*first2 < *first1) {
+			return false;
+		}
+		first1++;
+		first2++;
+	}
+	return (first1 == last1) && (first2 != last2);
+}
+
+// Finds the first element that differs with vector compares, only it is
+// compared as a number
+template <class T, class U>
+bool lexicographical_compare(
+	T *first1, T *last1, U *first2, U *last2, true_type) {
+	const std::size_t n1 = last1 - first1;
+	const std::size_t n2 = last2 - first2;
+	const std::size_t n = n1 < n2 ? n1 : n2;
+	const std::size_t i = mismatch_bytes(first1, first2, n * sizeof(T))
+		/ sizeof(T);
+	if (i < n) {
+		return first1[i] < first2[i];
+	}
+	return n1 < n2;
+}
+
+template <class InputIt1, class InputIt2>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, false_type) {
+	while (first1 != last1) {
+		if (!(*first1++ == *first2++)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class T, class U>
+bool equal(T *first1, T *last1, U *first2, true_type) {
+	return first1 == last1
+		|| std::memcmp(first1, first2, (last1 - first1) * sizeof(T)) == 0;
+}
+
+}  // namespace detail
+
 // Swaps the values of two objects
 template <typename T>
 void swap(T &a, T &b) {
-	T tmp = a;
-	a = b;
-	b = tmp;
+	T tmp = FT_MOVE(a);
+	a = FT_MOVE(b);
+	b = FT_MOVE(tmp);
 }
 
 // Returns the lowest of the given values
@@ -26,31 +199,30 @@ const T &max(const T &a, const T &b) {
 	return a;
 }
 
-// Copy-assigns the given value to every element in a range
+// Copy-assigns the given value to every element in a range, memset or
+// vector stores for arithmetic types
 template <class ForwardIterator, class T>
 void fill(ForwardIterator first, ForwardIterator last, const T &value) {
-	while (first != last) {
-		*first++ = value;
-	}
+	detail::fill(first, last, value,
+		typename detail::is_pattern_fillable<ForwardIterator>::type());
 }
 
-// Copy-assigns the given value to N elements
+// Copy-assigns the given value to N elements, memset or vector stores for
+// arithmetic types
 template <class OutputIterator, class Size, class T>
 OutputIterator fill_n(OutputIterator first, Size count, const T &value) {
-	for (Size i = 0; i < count; i++) {
-		*first++ = value;
-	}
-	return first;
+	return detail::fill_n(first, count, value,
+		typename detail::is_pattern_fillable<OutputIterator>::type());
 }
 
-// Copies a range of elements to a new location
+// Copies a range of elements to a new location,
+// memmove for pointers to trivially copyable types
 template <class InputIterator, class OutputIterator>
 OutputIterator copy(
 	InputIterator first, InputIterator last, OutputIterator d_first) {
-	while (first != last) {
-		*d_first++ = *first++;
-	}
-	return d_first;
+	return detail::copy(first, last, d_first,
+		typename detail::is_bitwise_copyable<InputIterator,
+			OutputIterator>::type());
 }
 
 // Copies a number of elements to a new location
@@ -62,41 +234,575 @@ OutputIt copy_n(InputIt first, Size count, OutputIt result) {
 	return result;
 }
 
-// Copies a range of elements in backwards order
+// Copies a range of elements in backwards order,
+// memmove for pointers to trivially copyable types
 template <class BidirIt1, class BidirIt2>
 BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last) {
-	while (first != last) {
-		*--d_last = *--last;
+	return detail::copy_backward(first, last, d_last,
+		typename detail::is_bitwise_copyable<BidirIt1, BidirIt2>::type());
+}
+
+// Moves a range of elements to a new location, copies them in C++98
+template <class InputIterator, class OutputIterator>
+OutputIterator move(
+	InputIterator first, InputIterator last, OutputIterator d_first) {
+	return detail::move(first, last, d_first,
+		typename detail::is_bitwise_copyable<InputIterator,
+			OutputIterator>::type());
+}
+
+// Moves a range of elements in backwards order, copies them in C++98
+template <class BidirIt1, class BidirIt2>
+BidirIt2 move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last) {
+	return detail::move_backward(first, last, d_last,
+		typename detail::is_bitwise_copyable<BidirIt1, BidirIt2>::type());
+}
+
+// Reverses the order of the elements in a range
+template <class BidirIt>
+void reverse(BidirIt first, BidirIt last) {
+	while (first != last && first != --last) {
+		ft::swap(*first++, *last);
 	}
-	return d_last;
 }
 
-// Returns true if one range is lexicographically less than another
+// Rotates a range so that middle becomes its first element
+template <class BidirIt>
+void rotate(BidirIt first, BidirIt middle, BidirIt last) {
+	ft::reverse(first, middle);
+	ft::reverse(middle, last);
+	ft::reverse(first, last);
+}
+
+// Returns true if one range is lexicographically less than another,
+// vectorized for contiguous ranges of integers
 template <class InputIt1, class InputIt2>
 bool lexicographical_compare(
 	InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
-	while (first1 != last1 && first2 != last2) {
-		if (*first1 < *first2) {
-			return true;
+	return detail::lexicographical_compare(first1, last1, first2, last2,
+		typename detail::is_bitwise_comparable<InputIt1, InputIt2>::type());
+}
+
+// Determines if two sets of elements are the same, memcmp for contiguous
+// ranges of integers
+template <class InputIt1, class InputIt2>
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+	return detail::equal(first1, last1, first2,
+		typename detail::is_bitwise_comparable<InputIt1, InputIt2>::type());
+}
+
+// Applies f to every element of a range
+template <class InputIt, class UnaryFunction>
+UnaryFunction for_each(InputIt first, InputIt last, UnaryFunction f) {
+	for (; first != last; ++first) {
+		f(*first);
+	}
+	return f;
+}
+
+// Stores op applied to every element of a range into another
+template <class InputIt, class OutputIt, class UnaryOperation>
+OutputIt transform(
+	InputIt first, InputIt last, OutputIt d_first, UnaryOperation op) {
+	for (; first != last; ++first, ++d_first) {
+		*d_first = op(*first);
+	}
+	return d_first;
+}
+
+// Returns the first element of a range pred is true for, last if none
+template <class InputIt, class UnaryPredicate>
+InputIt find_if(InputIt first, InputIt last, UnaryPredicate pred) {
+	for (; first != last; ++first) {
+		if (pred(*first)) {
+			break;
 		}
-		if (*first2 < *first1) {
-			return false;
+	}
+	return first;
+}
+
+// Folds a range into init with op, which the parallel overload assumes to
+// be associative and commutative
+template <class InputIt, class T, class BinaryOperation>
+T reduce(InputIt first, InputIt last, T init, BinaryOperation op) {
+	for (; first != last; ++first) {
+		init = op(init, *first);
+	}
+	return init;
+}
+
+template <class InputIt, class T>
+T reduce(InputIt first, InputIt last, T init) {
+	return ft::reduce(first, last, init, ft::plus<T>());
+}
+
+// Sorting
+
+namespace detail {
+
+// Below this many elements a range is insertion sorted
+static const std::ptrdiff_t insertion_sort_threshold = 24;
+// Above this many the pivot is the median of three medians of three
+static const std::ptrdiff_t ninther_threshold = 128;
+// Runs sorted by insertion before stable_sort starts merging
+static const std::ptrdiff_t merge_run_length = 32;
+
+template <class Size>
+int floor_log2(Size n) {
+	int log = 0;
+	while (n > 1) {
+		n /= 2;
+		log++;
+	}
+	return log;
+}
+
+template <class RandomIt, class Compare>
+void sort2(RandomIt a, RandomIt b, Compare comp) {
+	if (comp(*b, *a)) {
+		ft::swap(*a, *b);
+	}
+}
+
+template <class RandomIt, class Compare>
+void sort3(RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+	detail::sort2(a, b, comp);
+	detail::sort2(b, c, comp);
+	detail::sort2(a, b, comp);
+}
+
+// Stable, equal elements are never moved past each other
+template <class RandomIt, class Compare>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	if (first == last) {
+		return;
+	}
+	for (RandomIt i = first + 1; i != last; ++i) {
+		if (comp(*i, *first)) {
+			value_type value = FT_MOVE(*i);
+			ft::move_backward(first, i, i + 1);
+			*first = FT_MOVE(value);
+		} else if (comp(*i, *(i - 1))) {
+			value_type value = FT_MOVE(*i);
+			RandomIt   j = i;
+			do {
+				*j = FT_MOVE(*(j - 1));
+				--j;
+			} while (comp(value, *(j - 1)));
+			*j = FT_MOVE(value);
 		}
-		first1++;
-		first2++;
 	}
-	return (first1 == last1) && (first2 != last2);
 }
 
-// Determines if two sets of elements are the same
-template <class InputIt1, class InputIt2>
-bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
-	while (first1 != last1) {
-		if (!(*first1++ == *first2++)) {
+// Insertion sort without the bound check, an element not greater than any
+// in the range must precede it
+template <class RandomIt, class Compare>
+void unguarded_insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	for (RandomIt i = first; i != last; ++i) {
+		if (comp(*i, *(i - 1))) {
+			value_type value = FT_MOVE(*i);
+			RandomIt   j = i;
+			do {
+				*j = FT_MOVE(*(j - 1));
+				--j;
+			} while (comp(value, *(j - 1)));
+			*j = FT_MOVE(value);
+		}
+	}
+}
+
+// Insertion sort that gives up once it has moved a few elements, false
+// if the range is left unsorted
+template <class RandomIt, class Compare>
+bool partial_insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	const std::ptrdiff_t limit = 8;
+	std::ptrdiff_t       moves = 0;
+	if (first == last) {
+		return true;
+	}
+	for (RandomIt i = first + 1; i != last; ++i) {
+		if (!comp(*i, *(i - 1))) {
+			continue;
+		}
+		value_type value = FT_MOVE(*i);
+		RandomIt   j = i;
+		do {
+			*j = FT_MOVE(*(j - 1));
+			--j;
+		} while (j != first && comp(value, *(j - 1)));
+		*j = FT_MOVE(value);
+		moves += i - j;
+		if (moves > limit) {
 			return false;
 		}
 	}
 	return true;
 }
 
+template <class RandomIt, class Distance, class Compare>
+void sift_down(RandomIt first, Distance hole, Distance len, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	value_type value = FT_MOVE(first[hole]);
+	for (;;) {
+		Distance child = 2 * hole + 1;
+		if (child >= len) {
+			break;
+		}
+		if (child + 1 < len && comp(first[child], first[child + 1])) {
+			++child;
+		}
+		if (!comp(value, first[child])) {
+			break;
+		}
+		first[hole] = FT_MOVE(first[child]);
+		hole = child;
+	}
+	first[hole] = FT_MOVE(value);
+}
+
+template <class RandomIt, class Compare>
+void make_heap(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+	const difference_type len = last - first;
+	for (difference_type i = len / 2; i-- > 0;) {
+		detail::sift_down(first, i, len, comp);
+	}
+}
+
+template <class RandomIt, class Compare>
+void sort_heap(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+	for (difference_type len = last - first; len > 1; --len) {
+		ft::swap(first[0], first[len - 1]);
+		detail::sift_down(first, difference_type(0), len - 1, comp);
+	}
+}
+
+// Partitions around *first, elements equal to the pivot go right. *first
+// must not be greater than *(last - 1). Returns the final place of the
+// pivot; already_partitioned is set when no element had to be swapped.
+template <class RandomIt, class Compare>
+RandomIt partition_right(RandomIt first, RandomIt last, Compare comp,
+	bool &already_partitioned) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	value_type pivot = FT_MOVE(*first);
+	RandomIt   i = first;
+	RandomIt   j = last;
+	while (comp(*++i, pivot)) {
+	}
+	if (i - 1 == first) {
+		while (i < j && !comp(*--j, pivot)) {
+		}
+	} else {
+		while (!comp(*--j, pivot)) {
+		}
+	}
+	already_partitioned = i >= j;
+	while (i < j) {
+		ft::swap(*i, *j);
+		while (comp(*++i, pivot)) {
+		}
+		while (!comp(*--j, pivot)) {
+		}
+	}
+	RandomIt pivot_position = i - 1;
+	*first = FT_MOVE(*pivot_position);
+	*pivot_position = FT_MOVE(pivot);
+	return pivot_position;
+}
+
+// Partitions around *first with the elements equal to the pivot going left,
+// used when the pivot equals the element before the range: they are all in
+// place already and only the right part is left to sort
+template <class RandomIt, class Compare>
+RandomIt partition_left(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	value_type pivot = FT_MOVE(*first);
+	RandomIt   i = first;
+	RandomIt   j = last;
+	while (comp(pivot, *--j)) {
+	}
+	if (j + 1 == last) {
+		while (i < j && !comp(pivot, *++i)) {
+		}
+	} else {
+		while (!comp(pivot, *++i)) {
+		}
+	}
+	while (i < j) {
+		ft::swap(*i, *j);
+		while (comp(pivot, *--j)) {
+		}
+		while (!comp(pivot, *++i)) {
+		}
+	}
+	*first = FT_MOVE(*j);
+	*j = FT_MOVE(pivot);
+	return j;
+}
+
+// Swaps a few elements of a part left badly unbalanced, so that the next
+// pivot comes from elsewhere
+template <class RandomIt>
+void break_patterns(RandomIt first, RandomIt last) {
+	const std::ptrdiff_t size = last - first;
+	if (size < insertion_sort_threshold) {
+		return;
+	}
+	ft::swap(*first, *(first + size / 4));
+	ft::swap(*(last - 1), *(last - size / 4));
+	if (size > ninther_threshold) {
+		ft::swap(*(first + 1), *(first + (size / 4 + 1)));
+		ft::swap(*(first + 2), *(first + (size / 4 + 2)));
+		ft::swap(*(last - 2), *(last - (size / 4 + 1)));
+		ft::swap(*(last - 3), *(last - (size / 4 + 2)));
+	}
+}
+
+// Pattern-defeating quicksort: sorted and reversed runs are finished by
+// insertion sort, runs of equal elements are skipped in one partition, and
+// after bad_allowed unbalanced partitions the range is heap sorted
+template <class RandomIt, class Compare>
+void pdq_sort(RandomIt first, RandomIt last, Compare comp, int bad_allowed,
+	bool leftmost) {
+	for (;;) {
+		const std::ptrdiff_t size = last - first;
+		if (size < insertion_sort_threshold) {
+			if (leftmost) {
+				detail::insertion_sort(first, last, comp);
+			} else {
+				detail::unguarded_insertion_sort(first, last, comp);
+			}
+			return;
+		}
+		const std::ptrdiff_t half = size / 2;
+		if (size > ninther_threshold) {
+			detail::sort3(first, first + half, last - 1, comp);
+			detail::sort3(first + 1, first + (half - 1), last - 2, comp);
+			detail::sort3(first + 2, first + (half + 1), last - 3, comp);
+			detail::sort3(
+				first + (half - 1), first + half, first + (half + 1), comp);
+			ft::swap(*first, *(first + half));
+		} else {
+			detail::sort3(first + half, first, last - 1, comp);
+		}
+		if (!leftmost && !comp(*(first - 1), *first)) {
+			first = detail::partition_left(first, last, comp) + 1;
+			continue;
+		}
+		bool           already_partitioned;
+		const RandomIt pivot =
+			detail::partition_right(first, last, comp, already_partitioned);
+		const std::ptrdiff_t left_size = pivot - first;
+		const std::ptrdiff_t right_size = last - (pivot + 1);
+		if (left_size < size / 8 || right_size < size / 8) {
+			if (--bad_allowed == 0) {
+				detail::make_heap(first, last, comp);
+				detail::sort_heap(first, last, comp);
+				return;
+			}
+			detail::break_patterns(first, pivot);
+			detail::break_patterns(pivot + 1, last);
+		} else if (already_partitioned
+				   && detail::partial_insertion_sort(first, pivot, comp)
+				   && detail::partial_insertion_sort(pivot + 1, last, comp)) {
+			return;
+		}
+		detail::pdq_sort(first, pivot, comp, bad_allowed, leftmost);
+		first = pivot + 1;
+		leftmost = false;
+	}
+}
+
+// Scratch space for stable_sort, elements are moved in and out of it
+template <class T>
+class merge_buffer {
+  public:
+	explicit merge_buffer(std::size_t capacity)
+		: m_data(m_allocator.allocate(capacity)), m_capacity(capacity),
+		  m_size(0) {}
+	~merge_buffer() {
+		clear();
+		m_allocator.deallocate(m_data, m_capacity);
+	}
+
+	template <class InputIt>
+	T *assign(InputIt first, InputIt last) {
+		clear();
+		for (; first != last; ++first) {
+			m_allocator.construct(m_data + m_size, FT_MOVE(*first));
+			++m_size;
+		}
+		return m_data + m_size;
+	}
+
+	T *begin() {
+		return m_data;
+	}
+
+	void clear() {
+		for (; m_size > 0; --m_size) {
+			m_allocator.destroy(m_data + m_size - 1);
+		}
+	}
+
+  private:
+	std::allocator<T> m_allocator;
+	T                *m_data;
+	std::size_t       m_capacity;
+	std::size_t       m_size;
+
+	merge_buffer(const merge_buffer &);
+	merge_buffer &operator=(const merge_buffer &);
+};
+
+// Merges the sorted runs [first, middle) and [middle, last), moving the
+// shorter one to the buffer
+template <class RandomIt, class T, class Compare>
+void merge_adjacent(RandomIt first, RandomIt middle, RandomIt last,
+	merge_buffer<T> &buffer, Compare comp) {
+	if (!comp(*middle, *(middle - 1))) {
+		return;
+	}
+	if (middle - first <= last - middle) {
+		T       *b = buffer.begin();
+		T *const buffer_end = buffer.assign(first, middle);
+		RandomIt out = first;
+		while (b != buffer_end && middle != last) {
+			if (comp(*middle, *b)) {
+				*out++ = FT_MOVE(*middle++);
+			} else {
+				*out++ = FT_MOVE(*b++);
+			}
+		}
+		ft::move(b, buffer_end, out);
+	} else {
+		T *const buffer_begin = buffer.begin();
+		T       *b = buffer.assign(middle, last);
+		RandomIt out = last;
+		while (b != buffer_begin && first != middle) {
+			if (comp(*(b - 1), *(middle - 1))) {
+				*--out = FT_MOVE(*--middle);
+			} else {
+				*--out = FT_MOVE(*--b);
+			}
+		}
+		ft::move_backward(buffer_begin, b, out);
+	}
+	buffer.clear();
+}
+
+}  // namespace detail
+
+// Sorts a range in ascending order, not stable. O(n log n) comparisons in
+// the worst case, linear on sorted, reversed and constant ranges.
+template <class RandomIt, class Compare>
+void sort(RandomIt first, RandomIt last, Compare comp) {
+	if (last - first > 1) {
+		detail::pdq_sort(
+			first, last, comp, detail::floor_log2(last - first), true);
+	}
+}
+
+template <class RandomIt>
+void sort(RandomIt first, RandomIt last) {
+	ft::sort(first, last,
+		ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// Sorts a range keeping equal elements in their order: insertion sorted
+// runs, merged bottom up through a buffer of half the range
+template <class RandomIt, class Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	const std::ptrdiff_t size = last - first;
+	for (std::ptrdiff_t i = 0; i < size; i += detail::merge_run_length) {
+		detail::insertion_sort(first + i,
+			first + ft::min(i + detail::merge_run_length, size), comp);
+	}
+	if (size <= detail::merge_run_length) {
+		return;
+	}
+	detail::merge_buffer<value_type> buffer(size / 2);
+	for (std::ptrdiff_t width = detail::merge_run_length; width < size;
+		 width *= 2) {
+		for (std::ptrdiff_t i = 0; i + width < size; i += 2 * width) {
+			detail::merge_adjacent(first + i, first + (i + width),
+				first + ft::min(i + 2 * width, size), buffer, comp);
+		}
+	}
+}
+
+template <class RandomIt>
+void stable_sort(RandomIt first, RandomIt last) {
+	ft::stable_sort(first, last,
+		ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// Sorts the middle - first smallest elements of a range into [first,
+// middle), the others are left in an unspecified order. A heap of them is
+// kept while the rest of the range is scanned.
+template <class RandomIt, class Compare>
+void partial_sort(
+	RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+	typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+	const difference_type len = middle - first;
+	if (len == 0) {
+		return;
+	}
+	detail::make_heap(first, middle, comp);
+	for (RandomIt i = middle; i < last; ++i) {
+		if (comp(*i, *first)) {
+			ft::swap(*i, *first);
+			detail::sift_down(first, difference_type(0), len, comp);
+		}
+	}
+	detail::sort_heap(first, middle, comp);
+}
+
+template <class RandomIt>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+	ft::partial_sort(first, middle, last,
+		ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// Puts in nth the element a sort would put there, with no greater element
+// before it and no smaller one after. Quickselect, with a heap select once
+// too many partitions went badly.
+template <class RandomIt, class Compare>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+	if (nth == last) {
+		return;
+	}
+	int depth_allowed = 2 * detail::floor_log2(last - first);
+	while (last - first > detail::insertion_sort_threshold) {
+		if (depth_allowed-- == 0) {
+			ft::partial_sort(first, nth + 1, last, comp);
+			return;
+		}
+		detail::sort3(first + (last - first) / 2, first, last - 1, comp);
+		bool           already_partitioned;
+		const RandomIt pivot =
+			detail::partition_right(first, last, comp, already_partitioned);
+		if (pivot == nth) {
+			return;
+		}
+		if (nth < pivot) {
+			last = pivot;
+		} else {
+			first = pivot + 1;
+		}
+	}
+	detail::insertion_sort(first, last, comp);
+}
+
+template <class RandomIt>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+	ft::nth_element(first, nth, last,
+		ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
 }  // namespace ft
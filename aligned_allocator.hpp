@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "atomic.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+
+// An allocator whose blocks start on a multiple of Alignment bytes, a cache
+// line by default: a loop over the block never splits its first elements
+// across two lines, and the compiler can use aligned vector loads once it is
+// told with __builtin_assume_aligned. Alignment is a power of two and a
+// multiple of sizeof(void *).
+template <class T, std::size_t Alignment = cache_line_size>
+class aligned_allocator {
+  public:
+	typedef T              *pointer;
+	typedef const T        *const_pointer;
+	typedef T              &reference;
+	typedef const T        &const_reference;
+	typedef T               value_type;
+	typedef std::size_t     size_type;
+	typedef std::ptrdiff_t  difference_type;
+
+	template <class U>
+	struct rebind {
+		typedef aligned_allocator<U, Alignment> other;
+	};
+
+	static const std::size_t alignment = Alignment;
+
+	aligned_allocator() {}
+	template <class U>
+	aligned_allocator(const aligned_allocator<U, Alignment> &) {}
+
+	pointer address(reference x) const {
+		return &x;
+	}
+
+	const_pointer address(const_reference x) const {
+		return &x;
+	}
+
+	pointer allocate(size_type n, const void * = 0) {
+		if (n == 0) {
+			return 0;
+		}
+		if (n > max_size()) {
+			throw std::bad_alloc();
+		}
+		void *p = NULL;
+		if (posix_memalign(&p, Alignment, n * sizeof(T)) != 0) {
+			throw std::bad_alloc();
+		}
+		return static_cast<pointer>(p);
+	}
+
+	void deallocate(pointer p, size_type) {
+		std::free(p);
+	}
+
+	size_type max_size() const {
+		return static_cast<size_type>(-1) / sizeof(T);
+	}
+
+	void construct(pointer p, const T &value) {
+		new (static_cast<void *>(p)) T(value);
+	}
+
+#if __cplusplus >= 201103L
+	template <class U, class... Args>
+	void construct(U *p, Args &&...args) {
+		new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+	}
+#endif
+
+	void destroy(pointer p) {
+		p->~T();
+	}
+};
+
+template <class T, std::size_t Alignment>
+const std::size_t aligned_allocator<T, Alignment>::alignment;
+
+template <class T, class U, std::size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment> &,
+	const aligned_allocator<U, Alignment> &) {
+	return true;
+}
+
+template <class T, class U, std::size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment> &,
+	const aligned_allocator<U, Alignment> &) {
+	return false;
+}
+
+// It holds no state
+template <class T, std::size_t Alignment>
+struct is_trivially_relocatable<aligned_allocator<T, Alignment> >
+	: public true_type {};
+
+namespace detail {
+
+// Constructs with placement new and destroys with the destructor, like
+// std::allocator, so the bitwise fast paths apply
+template <class T, std::size_t Alignment>
+struct is_std_allocator<aligned_allocator<T, Alignment> > : public true_type {};
+
+}  // namespace detail
+
+}  // namespace ft
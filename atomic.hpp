@@ -0,0 +1,99 @@
+#pragma once
+#include <sched.h>
+
+namespace ft {
+
+// Thin wrappers over the GCC/Clang __atomic builtins, so the concurrent
+// containers work in the C++98 build where <atomic> does not exist
+enum memory_order {
+	memory_order_relaxed = __ATOMIC_RELAXED,
+	memory_order_consume = __ATOMIC_CONSUME,
+	memory_order_acquire = __ATOMIC_ACQUIRE,
+	memory_order_release = __ATOMIC_RELEASE,
+	memory_order_acq_rel = __ATOMIC_ACQ_REL,
+	memory_order_seq_cst = __ATOMIC_SEQ_CST
+};
+
+// Size of the destructive interference range, used to pad data written by
+// different threads onto separate cache lines
+enum { cache_line_size = 64 };
+
+template <class T>
+inline T atomic_load(
+	const T *object, memory_order order = memory_order_seq_cst) {
+	return __atomic_load_n(object, order);
+}
+
+template <class T>
+inline void atomic_store(
+	T *object, T desired, memory_order order = memory_order_seq_cst) {
+	__atomic_store_n(object, desired, order);
+}
+
+template <class T>
+inline T atomic_exchange(
+	T *object, T desired, memory_order order = memory_order_seq_cst) {
+	return __atomic_exchange_n(object, desired, order);
+}
+
+// On failure expected is updated with the value found in object
+template <class T>
+inline bool atomic_compare_exchange(T *object, T &expected, T desired,
+	memory_order success = memory_order_seq_cst,
+	memory_order failure = memory_order_seq_cst) {
+	return __atomic_compare_exchange_n(
+		object, &expected, desired, false, success, failure);
+}
+
+template <class T>
+inline T atomic_fetch_add(
+	T *object, T arg, memory_order order = memory_order_seq_cst) {
+	return __atomic_fetch_add(object, arg, order);
+}
+
+template <class T>
+inline T atomic_fetch_sub(
+	T *object, T arg, memory_order order = memory_order_seq_cst) {
+	return __atomic_fetch_sub(object, arg, order);
+}
+
+inline void atomic_thread_fence(memory_order order = memory_order_seq_cst) {
+	__atomic_thread_fence(order);
+}
+
+// Hint to the CPU that we are spinning on a contended location
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#endif
+}
+
+// Waits between the attempts of a spin loop: pauses twice as long each round
+// for the first ones, then gives the CPU to the other threads, which may be
+// the ones the loop waits for
+class backoff {
+  public:
+	backoff() : m_round(0) {}
+
+	void wait() {
+		if (m_round < spin_rounds) {
+			for (int i = 0; i < 1 << m_round; i++) {
+				cpu_relax();
+			}
+			m_round++;
+		} else {
+			sched_yield();
+		}
+	}
+
+	void reset() {
+		m_round = 0;
+	}
+
+  private:
+	enum { spin_rounds = 6 };
+
+	int m_round;
+};
+
+}  // namespace ft
@@ -0,0 +1,1520 @@
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <time.h>
+#include <vector>
+#include "algorithm.hpp"
+#include "execution.hpp"
+#include "list.hpp"
+#include "malloc_allocator.hpp"
+#include "map.hpp"
+#include "mmap_allocator.hpp"
+#include "mmap_vector.hpp"
+#include "mpmc_queue.hpp"
+#include "queue.hpp"
+#include "radix_sort.hpp"
+#include "ring_buffer.hpp"
+#include "skiplist_map.hpp"
+#include "small_map.hpp"
+#include "small_vector.hpp"
+#include "soa_vector.hpp"
+#include "spsc_queue.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+static volatile long g_sink;
+
+static double now_seconds() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_result(const char *benchmark, const char *variant, long n,
+	long ops, double seconds) {
+	std::cout << benchmark << '\t' << variant << "\tn=" << n << '\t'
+			  << (seconds * 1e9 / ops) << " ns/op\n";
+}
+
+static ft::vector<int> shuffled_keys(int n) {
+	ft::vector<int> keys;
+
+	for (int i = 0; i < n; i++) {
+		keys.push_back(i * 7);
+	}
+	for (int i = n - 1; i > 0; i--) {
+		ft::swap(keys[i], keys[std::rand() % (i + 1)]);
+	}
+	return keys;
+}
+
+// One "session": build a map of n entries, look every key up a few times,
+// then destroy it. This is the lifecycle small_map is optimized for.
+template <class Map>
+static void bench_map_session(const char *variant, int n) {
+	const ft::vector<int> keys = shuffled_keys(n);
+	const long            rounds = 2000000 / n;
+	long                  sum = 0;
+
+	double                start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		Map m;
+		for (int i = 0; i < n; i++) {
+			m.insert(ft::make_pair(keys[i], i));
+		}
+		for (int k = 0; k < 4; k++) {
+			for (int i = 0; i < n; i++) {
+				sum += m.find(keys[i])->second;
+			}
+		}
+	}
+	double elapsed = now_seconds() - start;
+	g_sink = sum;
+	print_result("map_session", variant, n, rounds * n * 5, elapsed);
+}
+
+static void bench_small_map() {
+	static const int sizes[] = {1, 2, 4, 8, 12, 16, 24, 32};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_map_session<ft::map<int, int> >("ft::map", sizes[i]);
+		bench_map_session<ft::small_map<int, int, 8> >(
+			"ft::small_map<8>", sizes[i]);
+		bench_map_session<ft::small_map<int, int, 32> >(
+			"ft::small_map<32>", sizes[i]);
+	}
+}
+
+// Draws n ranks in [0, universe) following a Zipf distribution with
+// exponent s, rank 0 being the most popular
+static ft::vector<int> zipf_ranks(int universe, double s, int n) {
+	ft::vector<double> cdf(universe);
+	double             total = 0;
+
+	for (int i = 0; i < universe; i++) {
+		total += 1.0 / std::pow(i + 1.0, s);
+		cdf[i] = total;
+	}
+	ft::vector<int> ranks;
+	ranks.reserve(n);
+	for (int i = 0; i < n; i++) {
+		double u = total * std::rand() / (RAND_MAX + 1.0);
+		int    lo = 0;
+		int    hi = universe - 1;
+		while (lo < hi) {
+			int mid = lo + (hi - lo) / 2;
+			if (cdf[mid] < u) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		ranks.push_back(lo);
+	}
+	return ranks;
+}
+
+template <class Map>
+static void bench_map_lookups(const char *benchmark, const char *variant,
+	const ft::vector<int> &keys, const ft::vector<int> &queries) {
+	Map  m;
+	long sum = 0;
+
+	for (std::size_t i = 0; i < keys.size(); i++) {
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	}
+	double start = now_seconds();
+	for (std::size_t i = 0; i < queries.size(); i++) {
+		sum += m.find(queries[i])->second;
+	}
+	double elapsed = now_seconds() - start;
+	g_sink = sum;
+	print_result(benchmark, variant, keys.size(), queries.size(), elapsed);
+}
+
+static void bench_splay() {
+	typedef ft::map<int, int, ft::less<int>,
+		std::allocator<ft::pair<const int, int> >, ft::bst_splay_access>
+		splay_map;
+	typedef ft::map<int, int, ft::less<int>,
+		std::allocator<ft::pair<const int, int> >, ft::bst_semi_splay_access>
+		semi_splay_map;
+
+	const int             universe = 100000;
+	const ft::vector<int> keys = shuffled_keys(universe);
+	const ft::vector<int> by_popularity = shuffled_keys(universe);
+	const ft::vector<int> ranks = zipf_ranks(universe, 1.1, 2000000);
+	ft::vector<int>       zipf_queries;
+	ft::vector<int>       uniform_queries;
+
+	// Popularity is unrelated to key and insertion order,
+	// so hot keys are spread all over the tree
+	for (std::size_t i = 0; i < ranks.size(); i++) {
+		zipf_queries.push_back(by_popularity[ranks[i]]);
+		uniform_queries.push_back(keys[std::rand() % universe]);
+	}
+	bench_map_lookups<ft::map<int, int> >(
+		"zipf_find", "plain", keys, zipf_queries);
+	bench_map_lookups<splay_map>("zipf_find", "splay", keys, zipf_queries);
+	bench_map_lookups<semi_splay_map>(
+		"zipf_find", "semi_splay", keys, zipf_queries);
+	bench_map_lookups<ft::map<int, int> >(
+		"uniform_find", "plain", keys, uniform_queries);
+	bench_map_lookups<splay_map>(
+		"uniform_find", "splay", keys, uniform_queries);
+	bench_map_lookups<semi_splay_map>(
+		"uniform_find", "semi_splay", keys, uniform_queries);
+}
+
+// ft::map behind a single mutex, the baseline skiplist_map has to beat
+class locked_map {
+  public:
+	locked_map() {
+		pthread_mutex_init(&m_mutex, NULL);
+	}
+	~locked_map() {
+		pthread_mutex_destroy(&m_mutex);
+	}
+
+	void insert(int key) {
+		pthread_mutex_lock(&m_mutex);
+		m_map.insert(ft::make_pair(key, key));
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	void erase(int key) {
+		pthread_mutex_lock(&m_mutex);
+		m_map.erase(key);
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	bool contains(int key) {
+		pthread_mutex_lock(&m_mutex);
+		bool found = m_map.find(key) != m_map.end();
+		pthread_mutex_unlock(&m_mutex);
+		return found;
+	}
+
+  private:
+	pthread_mutex_t     m_mutex;
+	ft::map<int, int> m_map;
+};
+
+class concurrent_skiplist_map {
+  public:
+	void insert(int key) {
+		m_map.insert(ft::make_pair(key, key));
+	}
+
+	void erase(int key) {
+		m_map.erase(key);
+	}
+
+	bool contains(int key) {
+		return m_map.find(key) != m_map.end();
+	}
+
+  private:
+	ft::skiplist_map<int, int> m_map;
+};
+
+template <class Map>
+struct concurrent_worker {
+	Map     *map;
+	unsigned seed;
+	long     ops;
+	int      universe;
+	int      read_percent;
+	long     found;
+};
+
+// xorshift32, rand() takes a lock in glibc and would dominate the timings
+static unsigned next_random(unsigned &state) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// Writes are split evenly between inserts and erases so the map keeps
+// about half of the universe
+template <class Map>
+static void *concurrent_worker_run(void *arg) {
+	concurrent_worker<Map> *w = static_cast<concurrent_worker<Map> *>(arg);
+	long                    found = 0;
+
+	for (long i = 0; i < w->ops; i++) {
+		int      key = next_random(w->seed) % w->universe;
+		unsigned op = next_random(w->seed) % 200;
+		if (op < 2U * w->read_percent) {
+			found += w->map->contains(key);
+		} else if (op % 2) {
+			w->map->insert(key);
+		} else {
+			w->map->erase(key);
+		}
+	}
+	w->found = found;
+	return NULL;
+}
+
+template <class Map>
+static void bench_concurrent_map(
+	const char *variant, int threads, int read_percent) {
+	const int                     universe = 100000;
+	const long                    total_ops = 1000000;
+	Map                           m;
+	ft::vector<pthread_t>         ids(threads);
+	ft::vector<concurrent_worker<Map> > workers(threads);
+
+	// Shuffled so the unbalanced ft::map does not degenerate into a list
+	const ft::vector<int> keys = shuffled_keys(universe / 2);
+	for (std::size_t i = 0; i < keys.size(); i++) {
+		m.insert(keys[i] / 7 * 2);
+	}
+	double start = now_seconds();
+	for (int i = 0; i < threads; i++) {
+		concurrent_worker<Map> w = {
+			&m, 2463534242U + i * 7919U, total_ops / threads, universe,
+			read_percent, 0};
+		workers[i] = w;
+		pthread_create(&ids[i], NULL, concurrent_worker_run<Map>, &workers[i]);
+	}
+	long found = 0;
+	for (int i = 0; i < threads; i++) {
+		pthread_join(ids[i], NULL);
+		found += workers[i].found;
+	}
+	double elapsed = now_seconds() - start;
+	g_sink = found;
+	std::cout << "concurrent_map\t" << variant << "\tthreads=" << threads
+			  << "\treads=" << read_percent << "%\t"
+			  << (total_ops / elapsed) << " ops/s\n";
+}
+
+static void bench_skiplist() {
+	static const int threads[] = {1, 2, 4, 8, 16, 32, 64};
+	static const int read_percents[] = {100, 90, 50, 10};
+
+	for (std::size_t r = 0; r < sizeof(read_percents) / sizeof(*read_percents);
+		 r++) {
+		for (std::size_t t = 0; t < sizeof(threads) / sizeof(*threads); t++) {
+			bench_concurrent_map<locked_map>(
+				"locked ft::map", threads[t], read_percents[r]);
+			bench_concurrent_map<concurrent_skiplist_map>(
+				"ft::skiplist_map", threads[t], read_percents[r]);
+		}
+	}
+}
+
+// Times n push_backs onto an empty vector, then replays the growth to find
+// the peak footprint: while reallocating, the old and the new block are both
+// alive. Pushes about budget elements in total.
+template <class Policy>
+static void bench_vector_growth(const char *variant, long n, long budget) {
+	typedef ft::vector<long, std::allocator<long>, Policy> vector;
+	const long rounds = ft::max(1L, budget / n);
+	long       sum = 0;
+
+	double     start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		vector v;
+		for (long i = 0; i < n; i++) {
+			v.push_back(i);
+		}
+		sum += v.back();
+	}
+	double elapsed = now_seconds() - start;
+	g_sink = sum;
+	print_result("growth", variant, n, rounds * n, elapsed);
+
+	vector      v;
+	std::size_t peak = 0;
+	long        reallocations = 0;
+	for (long i = 0; i < n; i++) {
+		const std::size_t capacity = v.capacity();
+		v.push_back(i);
+		if (v.capacity() != capacity) {
+			peak = ft::max(peak, (capacity + v.capacity()) * sizeof(long));
+			reallocations++;
+		}
+	}
+	std::cout << "growth\t" << variant << "\tn=" << n << "\tpeak "
+			  << peak / 1048576.0 << " MiB, final "
+			  << v.capacity() * sizeof(long) / 1048576.0 << " MiB for "
+			  << n * sizeof(long) / 1048576.0 << " MiB of data, "
+			  << reallocations << " reallocations\n";
+}
+
+static void bench_growth() {
+	static const long sizes[] = {1000, 100000, 10000000, 50000000};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_vector_growth<ft::vector_growth_2x>("2x", sizes[i], 50000000);
+		bench_vector_growth<ft::vector_growth_1_5x>(
+			"1.5x", sizes[i], 50000000);
+		bench_vector_growth<ft::vector_growth_size_class>(
+			"size class", sizes[i], 50000000);
+		// Quadratic, only run where it finishes
+		if (sizes[i] <= 100000) {
+			bench_vector_growth<ft::vector_growth_exact>(
+				"exact", sizes[i], 100000);
+		}
+	}
+}
+
+// push_back of n ints into a vector that was reserve()d, so only the fast
+// path runs, or into an empty one
+template <class Vector>
+static void bench_push_back(const char *variant, long n, bool reserved) {
+	const long rounds = 50000000 / n;
+	long       sum = 0;
+
+	double     start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		Vector v;
+		if (reserved) {
+			v.reserve(n);
+		}
+		for (long i = 0; i < n; i++) {
+			v.push_back(static_cast<int>(i));
+		}
+		sum += v.back();
+	}
+	double elapsed = now_seconds() - start;
+	g_sink = sum;
+	print_result(reserved ? "push_back reserved" : "push_back", variant, n,
+		rounds * n, elapsed);
+}
+
+static void bench_push_back() {
+	static const long sizes[] = {16, 1000, 1000000};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_push_back<ft::vector<int> >("ft::vector", sizes[i], true);
+		bench_push_back<std::vector<int> >("std::vector", sizes[i], true);
+		bench_push_back<ft::vector<int> >("ft::vector", sizes[i], false);
+		bench_push_back<std::vector<int> >("std::vector", sizes[i], false);
+	}
+}
+
+// n push_backs of longs in a child process, so that its peak resident size
+// can be read back on its own
+template <class Vector>
+static void bench_vector_relocation(const char *variant, long n) {
+	std::cout.flush();
+	pid_t pid = fork();
+
+	if (pid == 0) {
+		double start = now_seconds();
+		Vector v;
+		for (long i = 0; i < n; i++) {
+			v.push_back(i);
+		}
+		double elapsed = now_seconds() - start;
+		g_sink = v.back();
+		print_result("realloc", variant, n, n, elapsed);
+		std::cout.flush();
+		std::_Exit(0);
+	}
+	struct rusage usage;
+	int           status;
+	wait4(pid, &status, 0, &usage);
+	std::cout << "realloc\t" << variant << "\tn=" << n << "\tpeak rss "
+			  << usage.ru_maxrss / 1024 << " MiB for "
+			  << n * sizeof(long) / 1048576 << " MiB of data\n";
+}
+
+static void bench_realloc() {
+	static const long sizes[] = {100000, 10000000, 100000000};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_vector_relocation<ft::vector<long> >(
+			"std::allocator", sizes[i]);
+		bench_vector_relocation<ft::vector<long, ft::malloc_allocator<long> > >(
+			"ft::malloc_allocator", sizes[i]);
+	}
+}
+
+// std::allocator that counts the blocks it hands out
+template <class T>
+struct counting_allocator : public std::allocator<T> {
+	static long allocations;
+
+	template <class U>
+	struct rebind {
+		typedef counting_allocator<U> other;
+	};
+
+	counting_allocator() {}
+	template <class U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T *allocate(std::size_t n, const void * = 0) {
+		++allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+template <class T>
+long counting_allocator<T>::allocations = 0;
+
+// Builds and destroys many vectors of n ints, the small vector only
+// allocates past its inline capacity
+template <class Vector>
+static void bench_small_vector(const char *variant, long n) {
+	const long rounds = 20000000 / n;
+	long       sum = 0;
+
+	counting_allocator<int>::allocations = 0;
+	double start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		Vector v;
+		for (long i = 0; i < n; i++) {
+			v.push_back(static_cast<int>(i + r));
+		}
+		sum += v.back();
+	}
+	double elapsed = now_seconds() - start;
+	double allocations = counting_allocator<int>::allocations;
+	g_sink = sum;
+	print_result("small_vector", variant, n, rounds, elapsed);
+	std::cout << "small_vector\t" << variant << "\tn=" << n << '\t'
+			  << allocations / rounds << " allocations/vector\n";
+}
+
+static void bench_small_vector() {
+	typedef counting_allocator<int> allocator;
+	static const long               sizes[] = {1, 4, 8, 16, 17, 32};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_small_vector<ft::vector<int, allocator> >(
+			"ft::vector", sizes[i]);
+		bench_small_vector<ft::small_vector<int, 16, allocator> >(
+			"ft::small_vector<16>", sizes[i]);
+	}
+}
+
+// Fills a buffer the way read() would, one pass of stores
+struct sequence_writer {
+	std::size_t operator()(int *first, std::size_t n) const {
+		for (std::size_t i = 0; i < n; i++) {
+			first[i] = static_cast<int>(i);
+		}
+		return n;
+	}
+};
+
+// Sizes a buffer of n ints and writes it: resize() zero fills it first,
+// resize_uninitialized() and append_with() leave the stores to the writer
+static void bench_resize(const char *variant, long n, int mode) {
+	const long      rounds = 5;
+	sequence_writer writer;
+	long            sum = 0;
+
+	double start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		ft::vector<int> v;
+		if (mode == 0) {
+			v.resize(n);
+			writer(&v[0], n);
+		} else if (mode == 1) {
+			v.resize_uninitialized(n);
+			writer(&v[0], n);
+		} else {
+			v.append_with(n, writer);
+		}
+		sum += v.back();
+	}
+	double elapsed = now_seconds() - start;
+	g_sink = sum;
+	print_result("resize", variant, n, rounds * n, elapsed);
+}
+
+static void bench_resize() {
+	static const long sizes[] = {1000000, 64000000};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_resize("resize", sizes[i], 0);
+		bench_resize("resize_uninitialized", sizes[i], 1);
+		bench_resize("append_with", sizes[i], 2);
+	}
+}
+
+// Fills a vector of n longs, then reads it at random indices: with 4 KiB
+// pages nearly every access misses the TLB once the vector is large
+template <class Allocator>
+static void bench_random_access(
+	const char *variant, long n, const Allocator &allocator) {
+	const long accesses = 20000000;
+	long       sum = 0;
+
+	double start = now_seconds();
+	ft::vector<long, Allocator> v(n, 1, allocator);
+	double elapsed = now_seconds() - start;
+	print_result("huge_pages fill", variant, n, n, elapsed);
+	unsigned long index = 1;
+	start = now_seconds();
+	for (long i = 0; i < accesses; i++) {
+		index = index * 6364136223846793005UL + 1442695040888963407UL;
+		sum += v[(index >> 16) % n];
+	}
+	elapsed = now_seconds() - start;
+	g_sink = sum;
+	print_result("huge_pages random", variant, n, accesses, elapsed);
+}
+
+static void bench_huge_pages() {
+	typedef ft::mmap_allocator<long> allocator;
+	static const long                sizes[] = {1000000, 64000000};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_random_access(
+			"std::allocator", sizes[i], std::allocator<long>());
+		bench_random_access("ft::mmap_allocator", sizes[i], allocator(0));
+		bench_random_access("ft::mmap_allocator huge pages", sizes[i],
+			allocator(ft::mmap_huge_pages));
+		bench_random_access("ft::mmap_allocator huge pages populate",
+			sizes[i], allocator(ft::mmap_huge_pages | ft::mmap_populate));
+	}
+}
+
+// Loads a file of n longs and sums them: parsed element by element with
+// fread, read() in one go into a vector, or mapped with mmap_vector where
+// opening reads nothing and the scan faults the pages in
+static void bench_mmap_load(const char *path, long n) {
+	double           start = now_seconds();
+	long             sum = 0;
+	FILE            *file = std::fopen(path, "rb");
+	ft::vector<long> v1;
+	long             value;
+	while (std::fread(&value, sizeof(value), 1, file) == 1) {
+		v1.push_back(value);
+	}
+	std::fclose(file);
+	double loaded = now_seconds();
+	for (std::size_t i = 0; i < v1.size(); i++) {
+		sum += v1[i];
+	}
+	double elapsed = now_seconds();
+	print_result("mmap_vector load", "fread", n, n, loaded - start);
+	print_result("mmap_vector load+scan", "fread", n, n, elapsed - start);
+
+	start = now_seconds();
+	int              fd = open(path, O_RDONLY);
+	ft::vector<long> v2;
+	v2.resize_uninitialized(n);
+	g_sink = read(fd, &v2[0], n * sizeof(long));
+	close(fd);
+	loaded = now_seconds();
+	for (std::size_t i = 0; i < v2.size(); i++) {
+		sum += v2[i];
+	}
+	elapsed = now_seconds();
+	print_result("mmap_vector load", "read", n, n, loaded - start);
+	print_result("mmap_vector load+scan", "read", n, n, elapsed - start);
+
+	start = now_seconds();
+	ft::mmap_vector<long> v3(path);
+	loaded = now_seconds();
+	for (std::size_t i = 0; i < v3.size(); i++) {
+		sum += v3[i];
+	}
+	elapsed = now_seconds();
+	g_sink = sum;
+	print_result("mmap_vector load", "mmap_vector", n, n, loaded - start);
+	print_result(
+		"mmap_vector load+scan", "mmap_vector", n, n, elapsed - start);
+}
+
+static void bench_mmap_vector() {
+	static const long sizes[] = {1000000, 32000000};
+	char              path[] = "/tmp/ft_bench_mmap_vector_XXXXXX";
+	const int         fd = mkstemp(path);
+
+	close(fd);
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		{
+			ft::mmap_vector<long> v(path, ft::mmap_read_write);
+			v.reserve(sizes[i]);
+			for (long j = v.size(); j < sizes[i]; j++) {
+				v.push_back(j);
+			}
+		}
+		bench_mmap_load(path, sizes[i]);
+	}
+	unlink(path);
+}
+
+// ==, < and fill over two vectors of n elements that only differ in the
+// last one
+template <class Vector>
+static void bench_compare(const char *type, const char *variant, long n) {
+	const long rounds = 200000000 / n;
+	Vector     a(n, 1);
+	Vector     b(n, 1);
+	long       count = 0;
+
+	b.back() = 2;
+	double start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		// Written every round so the comparison cannot be hoisted
+		b.back() = static_cast<typename Vector::value_type>(2 + (r & 1));
+		count += a == b;
+	}
+	double elapsed = now_seconds() - start;
+	print_result((std::string("compare == ") + type).c_str(), variant, n,
+		rounds * n, elapsed);
+	start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		b.back() = static_cast<typename Vector::value_type>(2 + (r & 1));
+		count += a < b;
+	}
+	elapsed = now_seconds() - start;
+	print_result((std::string("compare < ") + type).c_str(), variant, n,
+		rounds * n, elapsed);
+	start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		a.assign(n, static_cast<typename Vector::value_type>(r));
+		count += a[r % n];
+	}
+	elapsed = now_seconds() - start;
+	g_sink = count;
+	print_result((std::string("compare fill ") + type).c_str(), variant, n,
+		rounds * n, elapsed);
+}
+
+static void bench_compare() {
+	static const long sizes[] = {64, 4096, 1000000};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_compare<ft::vector<char> >("char", "ft::vector", sizes[i]);
+		bench_compare<std::vector<char> >("char", "std::vector", sizes[i]);
+		bench_compare<ft::vector<int> >("int", "ft::vector", sizes[i]);
+		bench_compare<std::vector<int> >("int", "std::vector", sizes[i]);
+	}
+}
+
+// The sorts under test behind one signature, middle is the k of
+// partial_sort and nth_element
+typedef void (*sort_function)(int *first, int *middle, int *last);
+
+static void ft_sort(int *first, int *, int *last) {
+	ft::sort(first, last);
+}
+
+static void std_sort(int *first, int *, int *last) {
+	std::sort(first, last);
+}
+
+static void ft_stable_sort(int *first, int *, int *last) {
+	ft::stable_sort(first, last);
+}
+
+static void std_stable_sort(int *first, int *, int *last) {
+	std::stable_sort(first, last);
+}
+
+static void ft_partial_sort(int *first, int *middle, int *last) {
+	ft::partial_sort(first, middle, last);
+}
+
+static void std_partial_sort(int *first, int *middle, int *last) {
+	std::partial_sort(first, middle, last);
+}
+
+static void ft_nth_element(int *first, int *middle, int *last) {
+	ft::nth_element(first, middle, last);
+}
+
+static void std_nth_element(int *first, int *middle, int *last) {
+	std::nth_element(first, middle, last);
+}
+
+// Times sorting copies of input, ns per element
+static void bench_sort(const char *name, const char *variant,
+	const std::vector<int> &input, sort_function sort) {
+	const long       n = input.size();
+	const int        rounds = 5;
+	std::vector<int> values(input);
+	double           elapsed = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		values = input;
+		const double start = now_seconds();
+		sort(&values[0], &values[0] + n / 100, &values[0] + n);
+		elapsed += now_seconds() - start;
+		g_sink += values[n / 100];
+	}
+	print_result(name, variant, n, rounds * n, elapsed);
+}
+
+static void bench_sort() {
+	static const char *const patterns[] = {
+		"random", "sorted", "reversed", "duplicates"};
+	static const struct {
+		const char   *name;
+		sort_function ft_function;
+		sort_function std_function;
+	} sorts[] = {
+		{"sort", ft_sort, std_sort},
+		{"stable_sort", ft_stable_sort, std_stable_sort},
+		{"partial_sort", ft_partial_sort, std_partial_sort},
+		{"nth_element", ft_nth_element, std_nth_element},
+	};
+	const int n = 1000000;
+
+	for (int p = 0; p < 4; p++) {
+		std::vector<int> input(n);
+		for (int i = 0; i < n; i++) {
+			input[i] = p == 3 ? std::rand() % 100 : std::rand();
+		}
+		if (p == 1) {
+			std::sort(input.begin(), input.end());
+		} else if (p == 2) {
+			std::sort(input.rbegin(), input.rend());
+		}
+		for (std::size_t s = 0; s < sizeof(sorts) / sizeof(*sorts); s++) {
+			const std::string name =
+				std::string(sorts[s].name) + ' ' + patterns[p];
+			bench_sort(name.c_str(), "ft", input, sorts[s].ft_function);
+			bench_sort(name.c_str(), "std", input, sorts[s].std_function);
+		}
+	}
+}
+
+// Sorts n 64-bit keys spread over bits bits, the low ones of timestamps or
+// ids only vary
+template <class Sort>
+static void bench_radix_sort(
+	const char *variant, long n, int bits, Sort sort) {
+	std::vector<unsigned long> input(n);
+	for (long i = 0; i < n; i++) {
+		const unsigned long r = (unsigned long)std::rand() << 31 ^ std::rand();
+		input[i] = bits == 64 ? r << 2 ^ std::rand() : r >> (62 - bits);
+	}
+	std::vector<unsigned long> values(input);
+	double                     elapsed = 0;
+	const int                  rounds = 3;
+	for (int r = 0; r < rounds; r++) {
+		values = input;
+		const double start = now_seconds();
+		sort(values.begin(), values.end());
+		elapsed += now_seconds() - start;
+		g_sink += values[n / 2];
+	}
+	print_result(
+		bits == 64 ? "radix_sort 64 bit keys" : "radix_sort 40 bit keys",
+		variant, n, rounds * n, elapsed);
+}
+
+typedef std::vector<unsigned long>::iterator ulong_iterator;
+
+static void ft_sort_ulong(ulong_iterator first, ulong_iterator last) {
+	ft::sort(first, last);
+}
+
+static void std_sort_ulong(ulong_iterator first, ulong_iterator last) {
+	std::sort(first, last);
+}
+
+static void radix_sort_ulong(ulong_iterator first, ulong_iterator last) {
+	ft::radix_sort(first, last);
+}
+
+static void parallel_radix_sort_ulong(
+	ulong_iterator first, ulong_iterator last) {
+	ft::parallel_radix_sort(first, last);
+}
+
+static void bench_radix_sort() {
+	static const long sizes[] = {10000, 1000000, 4000000};
+	static const int  bits[] = {40, 64};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		for (std::size_t b = 0; b < sizeof(bits) / sizeof(*bits); b++) {
+			bench_radix_sort("ft::sort", sizes[i], bits[b], ft_sort_ulong);
+			bench_radix_sort("std::sort", sizes[i], bits[b], std_sort_ulong);
+			bench_radix_sort(
+				"ft::radix_sort", sizes[i], bits[b], radix_sort_ulong);
+			bench_radix_sort("ft::parallel_radix_sort", sizes[i], bits[b],
+				parallel_radix_sort_ulong);
+		}
+	}
+}
+
+struct scale {
+	void operator()(double &x) const {
+		x = x * 1.0001 + 1;
+	}
+};
+
+struct square {
+	double operator()(double x) const {
+		return x * x;
+	}
+};
+
+struct is_negative {
+	bool operator()(double x) const {
+		return x < 0;
+	}
+};
+
+// Times the algorithms over a and b, or over values for sort, with the
+// parallel overloads when par is set
+static void time_parallel_algorithms(const ft::parallel_policy *par,
+	ft::vector<double> &a, ft::vector<double> &b, ft::vector<int> &values,
+	double *seconds) {
+	double start = now_seconds();
+	if (par != NULL) {
+		ft::for_each(*par, a.begin(), a.end(), scale());
+	} else {
+		ft::for_each(a.begin(), a.end(), scale());
+	}
+	seconds[0] = now_seconds() - start;
+	start = now_seconds();
+	if (par != NULL) {
+		ft::transform(*par, a.begin(), a.end(), b.begin(), square());
+	} else {
+		ft::transform(a.begin(), a.end(), b.begin(), square());
+	}
+	seconds[1] = now_seconds() - start;
+	start = now_seconds();
+	g_sink += par != NULL ? ft::reduce(*par, b.begin(), b.end(), 0.0)
+						  : ft::reduce(b.begin(), b.end(), 0.0);
+	seconds[2] = now_seconds() - start;
+	start = now_seconds();
+	if (par != NULL) {
+		ft::copy(*par, a.begin(), a.end(), b.begin());
+	} else {
+		ft::copy(a.begin(), a.end(), b.begin());
+	}
+	seconds[3] = now_seconds() - start;
+	start = now_seconds();
+	if (par != NULL) {
+		ft::fill(*par, b.begin(), b.end(), 2.0);
+	} else {
+		ft::fill(b.begin(), b.end(), 2.0);
+	}
+	seconds[4] = now_seconds() - start;
+	start = now_seconds();
+	if (par != NULL) {
+		g_sink +=
+			ft::find_if(*par, a.begin(), a.end(), is_negative()) - a.begin();
+	} else {
+		g_sink += ft::find_if(a.begin(), a.end(), is_negative()) - a.begin();
+	}
+	seconds[5] = now_seconds() - start;
+	start = now_seconds();
+	if (par != NULL) {
+		ft::sort(*par, values.begin(), values.end());
+	} else {
+		ft::sort(values.begin(), values.end());
+	}
+	seconds[6] = now_seconds() - start;
+	g_sink += values[values.size() / 2];
+}
+
+// The parallel algorithms over a 16M element ft::vector on pools of 1, 2,
+// 4 ... threads up to the processors online, the thread that waits
+// included, against the sequential ones
+static void bench_parallel() {
+	const long         n = 16 * 1024 * 1024;
+	const char *const  names[] = {"for_each", "transform", "reduce", "copy",
+		 "fill", "find_if", "sort"};
+	const std::size_t  processors = ft::thread_pool::hardware_threads();
+	ft::vector<double> a(n, 1.0);
+	ft::vector<double> b(n);
+	ft::vector<int>    input(n / 4);
+	double             sequential[7];
+
+	for (long i = 0; i < n / 4; i++) {
+		input[i] = std::rand();
+	}
+	// Sequential first, as threads 0
+	for (std::size_t threads = 0; threads <= processors;
+		 threads = threads == 0 ? 1 : threads * 2) {
+		ft::thread_pool           pool(threads == 0 ? 0 : threads - 1);
+		const ft::parallel_policy par = ft::par.on(pool);
+		ft::vector<int>           values(input);
+		double                    seconds[7];
+		time_parallel_algorithms(
+			threads == 0 ? NULL : &par, a, b, values, seconds);
+		for (int i = 0; i < 7; i++) {
+			std::ostringstream variant;
+			if (threads == 0) {
+				sequential[i] = seconds[i];
+				variant << "sequential";
+			} else {
+				variant << "par " << threads << " threads, speedup "
+						<< sequential[i] / seconds[i];
+			}
+			const long count = i == 6 ? n / 4 : n;
+			print_result((std::string("parallel ") + names[i]).c_str(),
+				variant.str().c_str(), count, count, seconds[i]);
+		}
+	}
+}
+
+static void empty_task(void *) {}
+
+static void bench_task_done(void *pending) {
+	ft::atomic_fetch_sub(static_cast<long *>(pending), 1L,
+		ft::memory_order_release);
+}
+
+// The owner end of the two deques of thread_pool, the locked one only has
+// one end
+static bool owner_take(
+	ft::detail::work_stealing_deque &deque, ft::detail::pool_task &task) {
+	return deque.pop(task);
+}
+
+static bool owner_take(
+	ft::detail::locked_deque &deque, ft::detail::pool_task &task) {
+	return deque.steal(task);
+}
+
+template <class Deque>
+struct bench_thief {
+	Deque *deque;
+	long  *done;
+	long   stolen;
+};
+
+template <class Deque>
+static void *bench_thief_run(void *arg) {
+	bench_thief<Deque>   *thief = static_cast<bench_thief<Deque> *>(arg);
+	ft::detail::pool_task task;
+	while (ft::atomic_load(thief->done, ft::memory_order_relaxed) == 0) {
+		if (thief->deque->steal(task)) {
+			thief->stolen++;
+		}
+	}
+	return NULL;
+}
+
+// The owner pushes tasks in batches of 64 and takes them back while thieves
+// steal from the other end, ns per task
+template <class Deque>
+static void bench_deque(const char *variant, int thieves) {
+	const long                      tasks = 4000000;
+	const ft::detail::pool_task     task = {empty_task, NULL};
+	Deque                           deque;
+	long                            done = 0;
+	long                            taken = 0;
+	ft::vector<pthread_t>           ids(thieves);
+	ft::vector<bench_thief<Deque> > workers(thieves);
+	ft::detail::pool_task           out;
+
+	for (int i = 0; i < thieves; i++) {
+		bench_thief<Deque> thief = {&deque, &done, 0};
+		workers[i] = thief;
+		pthread_create(&ids[i], NULL, bench_thief_run<Deque>, &workers[i]);
+	}
+	const double start = now_seconds();
+	for (long i = 0; i < tasks; i += 64) {
+		for (int j = 0; j < 64; j++) {
+			deque.push(task);
+		}
+		while (owner_take(deque, out)) {
+			taken++;
+		}
+	}
+	const double elapsed = now_seconds() - start;
+	ft::atomic_store(&done, 1L);
+	for (int i = 0; i < thieves; i++) {
+		pthread_join(ids[i], NULL);
+		taken += workers[i].stolen;
+	}
+	g_sink += taken;
+	std::ostringstream name;
+	name << "thread_pool deque, " << thieves << " thieves";
+	print_result(name.str().c_str(), variant, tasks, tasks, elapsed);
+}
+
+// Fork-join recursion through task groups, counting the tasks submitted
+struct bench_fibonacci {
+	ft::thread_pool *pool;
+	int              n;
+	long            *result;
+	long            *tasks;
+
+	void operator()() const {
+		if (n < 16) {
+			*result = fibonacci(n);
+			return;
+		}
+		long            a;
+		long            b;
+		bench_fibonacci left = {pool, n - 1, &a, tasks};
+		bench_fibonacci right = {pool, n - 2, &b, tasks};
+		ft::atomic_fetch_add(tasks, 1L, ft::memory_order_relaxed);
+		ft::task_group group(*pool);
+		group.submit(left);
+		right();
+		group.wait();
+		*result = a + b;
+	}
+
+	static long fibonacci(int n) {
+		return n < 2 ? n : fibonacci(n - 1) + fibonacci(n - 2);
+	}
+};
+
+// The contention on the deques of a thread_pool: the lock-free deque of the
+// workers against the locked one of the submissions from outside, with
+// thieves stealing, then fork-join through task groups and tasks submitted
+// from outside the pool, on pools of 1, 2, 4 ... threads
+static void bench_thread_pool() {
+	for (int thieves = 0; thieves <= 3; thieves++) {
+		bench_deque<ft::detail::work_stealing_deque>("chase-lev", thieves);
+		bench_deque<ft::detail::locked_deque>("locked", thieves);
+	}
+	const std::size_t processors = ft::thread_pool::hardware_threads();
+	for (std::size_t threads = 1; threads <= processors; threads *= 2) {
+		ft::thread_pool    pool(threads - 1);
+		std::ostringstream variant;
+		long               result = 0;
+		long               tasks = 0;
+		bench_fibonacci    fib = {&pool, 32, &result, &tasks};
+		variant << threads << " threads";
+		double start = now_seconds();
+		fib();
+		double elapsed = now_seconds() - start;
+		g_sink += result;
+		print_result("thread_pool fork-join", variant.str().c_str(), tasks,
+			tasks, elapsed);
+		const long submitted = 1000000;
+		long       pending = submitted;
+		start = now_seconds();
+		for (long i = 0; i < submitted; i++) {
+			pool.submit(bench_task_done, &pending);
+		}
+		pool.wait_for(&pending);
+		elapsed = now_seconds() - start;
+		print_result("thread_pool submit", variant.str().c_str(), submitted,
+			submitted, elapsed);
+	}
+}
+
+// A bitmap of n flags with one in sixteen set, packed by ft::vector<bool>
+// and one byte per flag as the generic template stored it: the memory used,
+// setting the flags, counting them, walking them in order and ANDing two
+static void bench_vector_bool(long n) {
+	typedef ft::vector<bool>          packed_vector;
+	typedef ft::vector<unsigned char> byte_vector;
+	ft::vector<long>                  positions;
+	packed_vector                     packed(n);
+	packed_vector                     packed_mask(n, true);
+	byte_vector                       bytes(n);
+	byte_vector                       byte_mask(n, 1);
+	long                              sum = 0;
+
+	for (long i = 0; i < n / 16; i++) {
+		positions.push_back((long(std::rand()) << 16 ^ std::rand()) % n);
+	}
+	std::cout << "vector_bool\tft::vector<bool>\tn=" << n << '\t'
+			  << packed.capacity() / 8 << " bytes\n";
+	std::cout << "vector_bool\tbyte per flag\tn=" << n << '\t'
+			  << bytes.capacity() << " bytes\n";
+
+	double start = now_seconds();
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		packed[positions[i]] = true;
+	}
+	print_result("vector_bool set", "ft::vector<bool>", n, positions.size(),
+		now_seconds() - start);
+	start = now_seconds();
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		bytes[positions[i]] = 1;
+	}
+	print_result("vector_bool set", "byte per flag", n, positions.size(),
+		now_seconds() - start);
+
+	start = now_seconds();
+	sum += packed.count();
+	print_result("vector_bool count", "ft::vector<bool>", n, n,
+		now_seconds() - start);
+	start = now_seconds();
+	for (long i = 0; i < n; i++) {
+		sum += bytes[i];
+	}
+	print_result(
+		"vector_bool count", "byte per flag", n, n, now_seconds() - start);
+
+	start = now_seconds();
+	for (std::size_t i = packed.find_first(); i != packed_vector::npos;
+		 i = packed.find_next(i)) {
+		sum += i;
+	}
+	print_result("vector_bool walk", "ft::vector<bool>", n, n,
+		now_seconds() - start);
+	start = now_seconds();
+	for (long i = 0; i < n; i++) {
+		if (bytes[i]) {
+			sum += i;
+		}
+	}
+	print_result(
+		"vector_bool walk", "byte per flag", n, n, now_seconds() - start);
+
+	start = now_seconds();
+	packed &= packed_mask;
+	print_result(
+		"vector_bool and", "ft::vector<bool>", n, n, now_seconds() - start);
+	start = now_seconds();
+	for (long i = 0; i < n; i++) {
+		bytes[i] &= byte_mask[i];
+	}
+	print_result(
+		"vector_bool and", "byte per flag", n, n, now_seconds() - start);
+	g_sink = sum + packed.count() + bytes[n / 2];
+}
+
+static void bench_vector_bool() {
+	bench_vector_bool(1L << 20);
+	bench_vector_bool(1L << 26);
+}
+
+// A 64 byte record of which a scan reads one field
+struct bench_record {
+	long   id;
+	double price;
+	double quantity;
+	char   name[40];
+};
+
+// Sums the ids of n records stored as a vector of structs and as the
+// columns of a soa_vector
+static void bench_soa_vector(long n) {
+	const long                                   rounds = (1L << 26) / n;
+	ft::vector<bench_record>                     records(n);
+	ft::soa_vector<long, double, double, double> columns;
+	long                                         sum = 0;
+
+	for (long i = 0; i < n; i++) {
+		records[i].id = i;
+		records[i].price = i * 0.5;
+		columns.push_back(i, i * 0.5);
+	}
+	double start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		for (long i = 0; i < n; i++) {
+			sum += records[i].id;
+		}
+	}
+	print_result("soa_vector", "vector of structs", n, rounds * n,
+		now_seconds() - start);
+	start = now_seconds();
+	for (long r = 0; r < rounds; r++) {
+		const ft::soa_span<long> ids = columns.column<0>();
+		for (const long *p = ids.begin(); p != ids.end(); ++p) {
+			sum += *p;
+		}
+	}
+	print_result("soa_vector", "soa_vector column", n, rounds * n,
+		now_seconds() - start);
+	g_sink = sum;
+}
+
+static void bench_soa_vector() {
+	bench_soa_vector(1L << 12);
+	bench_soa_vector(1L << 22);
+}
+
+// A queue holding n elements in steady state: every round pushes one at the
+// back and pops one at the front, reading the front as a consumer would
+template <class Queue>
+static void bench_queue(Queue q, const char *variant, long n) {
+	const long ops = 1L << 24;
+	long       sum = 0;
+
+	for (long i = 0; i < n; i++) {
+		q.push(static_cast<int>(i));
+	}
+	double start = now_seconds();
+	for (long i = 0; i < ops; i++) {
+		q.push(static_cast<int>(i));
+		sum += q.front();
+		q.pop();
+	}
+	print_result("queue", variant, n, ops, now_seconds() - start);
+	g_sink = sum;
+}
+
+// The same traffic in batches of 64 through push_n and pop_n, two memcpy
+// at most per batch
+static void bench_ring_buffer_bulk(long n) {
+	const long           ops = 1L << 24;
+	const long           batch = 64;
+	ft::ring_buffer<int> b(n + batch);
+	int                  in[batch];
+	int                  out[batch];
+	long                 sum = 0;
+
+	for (long i = 0; i < n; i++) {
+		b.push_back(static_cast<int>(i));
+	}
+	for (long i = 0; i < batch; i++) {
+		in[i] = static_cast<int>(i);
+	}
+	double start = now_seconds();
+	for (long i = 0; i < ops; i += batch) {
+		in[0] = static_cast<int>(i);
+		b.push_n(in, batch);
+		b.pop_n(out, batch);
+		sum += out[0];
+	}
+	print_result(
+		"queue", "ft::ring_buffer push_n", n, ops, now_seconds() - start);
+	g_sink = sum;
+}
+
+static void bench_queue() {
+	typedef ft::queue<int, ft::list<int> >        list_queue;
+	typedef ft::queue<int, ft::ring_buffer<int> > ring_queue;
+
+	static const long sizes[] = {16, 1L << 10, 1L << 20};
+
+	for (std::size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+		bench_queue(list_queue(), "ft::list", sizes[i]);
+		bench_queue(ft::queue<int>(), "ft::deque", sizes[i]);
+		bench_queue(ring_queue(ft::ring_buffer<int>(sizes[i] + 1)),
+			"ft::ring_buffer", sizes[i]);
+		bench_ring_buffer_bulk(sizes[i]);
+	}
+}
+
+// What the pipeline stages use today: an ft::queue under a mutex, unbounded
+class locked_queue {
+  public:
+	explicit locked_queue(std::size_t) {
+		pthread_mutex_init(&m_mutex, NULL);
+	}
+	~locked_queue() {
+		pthread_mutex_destroy(&m_mutex);
+	}
+
+	void push(const long &x) {
+		pthread_mutex_lock(&m_mutex);
+		m_queue.push(x);
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	void push_n(const long *first, std::size_t n) {
+		pthread_mutex_lock(&m_mutex);
+		for (std::size_t i = 0; i < n; i++) {
+			m_queue.push(first[i]);
+		}
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	bool try_pop(long &x) {
+		return try_pop_n(&x, 1) == 1;
+	}
+
+	std::size_t try_pop_n(long *out, std::size_t n) {
+		pthread_mutex_lock(&m_mutex);
+		std::size_t popped = 0;
+		for (; popped < n && !m_queue.empty(); popped++) {
+			out[popped] = m_queue.front();
+			m_queue.pop();
+		}
+		pthread_mutex_unlock(&m_mutex);
+		return popped;
+	}
+
+  private:
+	pthread_mutex_t  m_mutex;
+	ft::queue<long> m_queue;
+
+	locked_queue(const locked_queue &);
+	locked_queue &operator=(const locked_queue &);
+};
+
+static long now_nanoseconds() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// One end of a producer/consumer pair. The items are the times they were
+// pushed at, the consumer keeps how long one in sixteen waited.
+template <class Queue>
+struct queue_endpoint {
+	Queue            *queue;
+	long              items;
+	std::size_t       batch;
+	ft::vector<long> *latencies;
+};
+
+template <class Queue>
+static void *queue_producer_run(void *arg) {
+	queue_endpoint<Queue> *e = static_cast<queue_endpoint<Queue> *>(arg);
+	long                   stamps[64];
+
+	for (long i = 0; i < e->items; i += e->batch) {
+		const long now = now_nanoseconds();
+		if (e->batch == 1) {
+			e->queue->push(now);
+		} else {
+			for (std::size_t j = 0; j < e->batch; j++) {
+				stamps[j] = now;
+			}
+			e->queue->push_n(stamps, e->batch);
+		}
+	}
+	return NULL;
+}
+
+template <class Queue>
+static void *queue_consumer_run(void *arg) {
+	queue_endpoint<Queue> *e = static_cast<queue_endpoint<Queue> *>(arg);
+	long                   stamps[64];
+	long                   popped = 0;
+	ft::backoff            waiting;
+
+	// Pops exactly its share, the other consumers of a shared queue wait
+	// for theirs
+	while (popped < e->items) {
+		const std::size_t n = e->batch == 1
+			? std::size_t(e->queue->try_pop(stamps[0]))
+			: e->queue->try_pop_n(
+				  stamps, ft::min(long(e->batch), e->items - popped));
+		if (n == 0) {
+			waiting.wait();
+			continue;
+		}
+		waiting.reset();
+		const long now = now_nanoseconds();
+		for (std::size_t j = 0; j < n; j++) {
+			if ((popped + j) % 16 == 0) {
+				e->latencies->push_back(now - stamps[j]);
+			}
+		}
+		popped += n;
+	}
+	return NULL;
+}
+
+// pairs producers and as many consumers passing 2^20 items in batches of
+// batch, through a queue per pair or one queue shared by all of them.
+// Prints the items per second and the median and 99th percentile of the
+// time from push to pop.
+template <class Queue>
+static void bench_queue_pairs(
+	const char *variant, int pairs, std::size_t batch, bool shared) {
+	const long                         items = (1L << 20) / pairs;
+	const int                          queues = shared ? 1 : pairs;
+	ft::vector<Queue *>                q(queues);
+	ft::vector<pthread_t>              ids(2 * pairs);
+	ft::vector<queue_endpoint<Queue> > ends(2 * pairs);
+	ft::vector<ft::vector<long> >      latencies(pairs);
+
+	for (int i = 0; i < queues; i++) {
+		q[i] = new Queue(1024);
+	}
+	double start = now_seconds();
+	for (int i = 0; i < pairs; i++) {
+		queue_endpoint<Queue> producer = {q[i % queues], items, batch, NULL};
+		queue_endpoint<Queue> consumer = {
+			q[i % queues], items, batch, &latencies[i]};
+		ends[2 * i] = producer;
+		ends[2 * i + 1] = consumer;
+		pthread_create(&ids[2 * i + 1], NULL, queue_consumer_run<Queue>,
+			&ends[2 * i + 1]);
+		pthread_create(
+			&ids[2 * i], NULL, queue_producer_run<Queue>, &ends[2 * i]);
+	}
+	for (int i = 0; i < 2 * pairs; i++) {
+		pthread_join(ids[i], NULL);
+	}
+	double elapsed = now_seconds() - start;
+	for (int i = 0; i < queues; i++) {
+		delete q[i];
+	}
+	ft::vector<long> all;
+	for (int i = 0; i < pairs; i++) {
+		all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+	}
+	std::sort(all.begin(), all.end());
+	std::cout << "concurrent_queue\t" << variant << "\tpairs=" << pairs
+			  << '\t' << (items * pairs / elapsed / 1e6) << " Mitems/s\tp50="
+			  << all[all.size() / 2] << " ns\tp99="
+			  << all[all.size() * 99 / 100] << " ns\n";
+}
+
+static void bench_concurrent_queue() {
+	for (int pairs = 1; pairs <= 32; pairs *= 2) {
+		bench_queue_pairs<locked_queue>("locked ft::queue", pairs, 1, true);
+		bench_queue_pairs<ft::spsc_queue<long> >(
+			"ft::spsc_queue", pairs, 1, false);
+		bench_queue_pairs<ft::spsc_queue<long> >(
+			"ft::spsc_queue x16", pairs, 16, false);
+		bench_queue_pairs<ft::mpmc_queue<long> >(
+			"ft::mpmc_queue", pairs, 1, true);
+		bench_queue_pairs<ft::mpmc_queue<long> >(
+			"ft::mpmc_queue x16", pairs, 16, true);
+	}
+}
+
+struct benchmark {
+	const char *name;
+	void (*run)();
+};
+
+static const benchmark g_benchmarks[] = {
+	{"small_map", bench_small_map},
+	{"splay", bench_splay},
+	{"skiplist", bench_skiplist},
+	{"growth", bench_growth},
+	{"push_back", bench_push_back},
+	{"realloc", bench_realloc},
+	{"small_vector", bench_small_vector},
+	{"vector_bool", bench_vector_bool},
+	{"soa_vector", bench_soa_vector},
+	{"queue", bench_queue},
+	{"resize", bench_resize},
+	{"huge_pages", bench_huge_pages},
+	{"mmap_vector", bench_mmap_vector},
+	{"compare", bench_compare},
+	{"sort", bench_sort},
+	{"radix_sort", bench_radix_sort},
+	{"parallel", bench_parallel},
+	{"thread_pool", bench_thread_pool},
+	{"concurrent_queue", bench_concurrent_queue},
+};
+
+// Runs every benchmark, or only the ones named on the command line
+int main(int argc, char **argv) {
+	const std::size_t count = sizeof(g_benchmarks) / sizeof(*g_benchmarks);
+
+	std::srand(std::time(NULL));
+	for (std::size_t i = 0; i < count; i++) {
+		bool selected = argc == 1;
+		for (int j = 1; j < argc; j++) {
+			if (std::strcmp(argv[j], g_benchmarks[i].name) == 0) {
+				selected = true;
+			}
+		}
+		if (selected) {
+			g_benchmarks[i].run();
+		}
+	}
+	return 0;
+}
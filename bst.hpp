@@ -6,13 +6,32 @@
 #include "type_traits.hpp"
 #include "utility.hpp"
 #include "utils.hpp"
+#ifdef FT_BST_STATS
+#	include "atomic.hpp"
+#	include "bst_stats.hpp"
+// Charges the calls and comparisons that follow to an operation
+#	define FT_BST_COUNT(op) m_count_operation(bst_stats::op)
+#else
+#	define FT_BST_COUNT(op)
+#endif
 
 namespace ft {
 
-// KeyOfValue is a unary function object that returns
-// the first type of a pair
+// Access policies, they decide how lookups reshape the tree
+// Lookups never modify the tree
+struct bst_plain_access {};
+// Every find and insert splays the accessed node to the root, so hot keys
+// stay within a few levels of it
+struct bst_splay_access {};
+// Every find semi-splays the node: a zig-zig rotates only the parent and
+// continues from there, halving the access path with about half the pointer
+// writes of a full splay; inserts leave the tree alone
+struct bst_semi_splay_access {};
+
+// KeyOfValue is a unary function object that extracts the key from a value,
+// select_first for map/multimap and identity for set/multiset
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
+	class Allocator, class AccessPolicy = bst_plain_access>
 class bst {
   protected:
 	struct bst_node;
@@ -53,6 +72,12 @@ class bst {
 		bst_iterator(const bst_iterator<false> &rhs)
 			: current(rhs.base()), root(rhs.getRoot()) {}
 
+		bst_iterator &operator=(const bst_iterator<false> &rhs) {
+			current = rhs.base();
+			root = rhs.getRoot();
+			return *this;
+		}
+
 		reference operator*() const {
 			return current->value;
 		}
@@ -64,16 +89,20 @@ class bst {
 		bst_iterator &operator++() {
 			if (current->right != NULL) {
 				current = current->right;
+				m_count_hop();
 				while (current->left != NULL) {
 					current = current->left;
+					m_count_hop();
 				}
 			} else {
 				bst_node_pointer trailing = current->parent;
 				while (trailing != NULL && current == trailing->right) {
 					current = trailing;
 					trailing = trailing->parent;
+					m_count_hop();
 				}
 				current = trailing;
+				m_count_hop();
 			}
 			return *this;
 		}
@@ -88,22 +117,31 @@ class bst {
 			if (current == NULL && root) {
 				// Case when current == end()
 				// For the reverse iterator where rbegin() == end()
+				// Splaying may have rotated root down since this
+				// iterator was made, so climb back to the real root
 				current = root;
+				while (current->parent) {
+					current = current->parent;
+				}
 				while (current->right) {
 					current = current->right;
 				}
 			} else if (current->left != NULL) {
 				current = current->left;
+				m_count_hop();
 				while (current->right != NULL) {
 					current = current->right;
+					m_count_hop();
 				}
 			} else {
 				bst_node_pointer trailing = current->parent;
 				while (trailing != NULL && current == trailing->left) {
 					current = trailing;
 					trailing = trailing->parent;
+					m_count_hop();
 				}
 				current = trailing;
+				m_count_hop();
 			}
 			return *this;
 		}
@@ -148,10 +186,17 @@ class bst {
 			InputIterator>::type first,
 		InputIterator last, const Compare &comp = Compare(),
 		const Allocator &allocator = Allocator());
-	bst(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x);
+	bst(const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x);
 	~bst();
-	bst<Key, Value, KeyOfValue, Compare, Allocator> &operator=(
-		const bst<Key, Value, KeyOfValue, Compare, Allocator> &x);
+	bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &operator=(
+		const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x);
+#if __cplusplus >= 201103L
+	bst(bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &&x)
+		noexcept;
+	bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &operator=(
+		bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &&x)
+		noexcept;
+#endif
 	allocator_type           get_allocator() const;
 
 	// iterators:
@@ -176,10 +221,17 @@ class bst {
 	void insert(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 					InputIterator>::type first,
 		InputIterator                    last);
+	iterator insert_equal(const value_type &x);
+	iterator insert_equal(iterator position, const value_type &x);
+	template <class InputIterator>
+	void insert_equal(
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			InputIterator>::type first,
+		InputIterator            last);
 	void erase(iterator position);
 	size_type      erase(const key_type &x);
 	void           erase(iterator first, iterator last);
-	void           swap(bst<Key, Value, KeyOfValue, Compare, Allocator> &x);
+	void swap(bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x);
 	void           clear();
 
 	// observers:
@@ -197,34 +249,61 @@ class bst {
 	ft::pair<const_iterator, const_iterator> equal_range(
 		const key_type &x) const;
 
+#ifdef FT_BST_STATS
+	// instrumentation:
+	bst_stats      stats() const;
+	void           reset_stats();
+#endif
+
   protected:
 	allocator_type   m_allocator;
 	size_type        m_size;
 	bst_node_pointer m_root;
 	Compare          m_key_compare;
+#ifdef FT_BST_STATS
+	// Written by the const lookups too, a tree of a stats build cannot be
+	// read by several threads at once
+	mutable bst_stats    m_stats;
+	static unsigned long s_iterator_hops;
+	void                 m_count_operation(bst_stats::operation op) const;
+#endif
+	bool             m_compare(const key_type &x, const key_type &y) const;
+	static void      m_count_hop();
 	bst_node_pointer m_allocate_bst_node() const;
+	void             m_deallocate_bst_node(bst_node_pointer node) const;
 	void             m_transplant(bst_node_pointer u, bst_node_pointer v);
 	bool m_equal_keys(const value_type &x, const value_type &y) const;
 	bst_node_pointer m_copy(bst_node_pointer src, bst_node_pointer dst_parent);
+	void             m_rotate_up(bst_node_pointer x);
+	void             m_splay_step(bst_node_pointer x);
+	void             m_on_find(bst_node_pointer x, bst_plain_access);
+	void             m_on_find(bst_node_pointer x, bst_splay_access);
+	void             m_on_find(bst_node_pointer x, bst_semi_splay_access);
+	void             m_on_insert(bst_node_pointer x, bst_plain_access);
+	void             m_on_insert(bst_node_pointer x, bst_splay_access);
+	void             m_on_insert(bst_node_pointer x, bst_semi_splay_access);
 	static bst_node_pointer m_minimum(bst_node_pointer x);
 	static bst_node_pointer m_maximum(bst_node_pointer x);
 };
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-struct bst<Key, Value, KeyOfValue, Compare, Allocator>::bst_node {
-	typedef bst<Key, Value, KeyOfValue, Compare, Allocator> self_type;
-	self_type::bst_node_pointer                             parent;
-	self_type::bst_node_pointer                             left;
-	self_type::bst_node_pointer                             right;
+	class Allocator, class AccessPolicy>
+struct bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::bst_node {
+	typedef bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>
+								self_type;
+	self_type::bst_node_pointer parent;
+	self_type::bst_node_pointer left;
+	self_type::bst_node_pointer right;
 	// Pair of key, mapped_type
-	Value                                                   value;
+	Value                       value;
 };
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::bst_node_pointer
-bst<Key, Value, KeyOfValue, Compare, Allocator>::m_minimum(bst_node_pointer x) {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::bst_node_pointer
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::m_minimum(
+	bst_node_pointer x) {
 	while (x != NULL && x->left) {
 		x = x->left;
 	}
@@ -232,9 +311,11 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::m_minimum(bst_node_pointer x) {
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::bst_node_pointer
-bst<Key, Value, KeyOfValue, Compare, Allocator>::m_maximum(bst_node_pointer x) {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::bst_node_pointer
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::m_maximum(
+	bst_node_pointer x) {
 	while (x != NULL && x->right) {
 		x = x->right;
 	}
@@ -242,17 +323,53 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::m_maximum(bst_node_pointer x) {
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool bst<Key, Value, KeyOfValue, Compare, Allocator>::m_equal_keys(
+	class Allocator, class AccessPolicy>
+bool bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_equal_keys(
 	const value_type &x, const value_type &y) const {
-	return !m_key_compare(KeyOfValue()(x), KeyOfValue()(y)) &&
-		   !m_key_compare(KeyOfValue()(y), KeyOfValue()(x));
+	return !m_compare(KeyOfValue()(x), KeyOfValue()(y)) &&
+		   !m_compare(KeyOfValue()(y), KeyOfValue()(x));
+}
+
+// Every key comparison goes through here so that FT_BST_STATS can count it
+// against the operation in progress
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+bool bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_compare(
+	const key_type &x, const key_type &y) const {
+#ifdef FT_BST_STATS
+	++m_stats.comparisons[m_stats.current];
+#endif
+	return m_key_compare(x, y);
+}
+
+#ifdef FT_BST_STATS
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_count_operation(bst_stats::operation op) const {
+	++m_stats.calls[op];
+	m_stats.current = op;
+}
+#endif
+
+// Iterators of trees used by different threads count into the same static,
+// hence the atomic add
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_count_hop() {
+#ifdef FT_BST_STATS
+	atomic_fetch_add(&s_iterator_hops, 1UL, memory_order_relaxed);
+#endif
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::bst_node_pointer
-bst<Key, Value, KeyOfValue, Compare, Allocator>::m_copy(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::bst_node_pointer
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::m_copy(
 	bst_node_pointer src, bst_node_pointer dst_parent) {
 	if (src == NULL) {
 		return NULL;
@@ -266,17 +383,121 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::m_copy(
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare,
-	Allocator>::bst_node_allocator_type
-	bst<Key, Value, KeyOfValue, Compare, Allocator>::bst_node_allocator;
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_rotate_up(bst_node_pointer x) {
+	bst_node_pointer parent = x->parent;
+	bst_node_pointer grandparent = parent->parent;
+
+	if (x == parent->left) {
+		parent->left = x->right;
+		if (x->right != NULL) {
+			x->right->parent = parent;
+		}
+		x->right = parent;
+	} else {
+		parent->right = x->left;
+		if (x->left != NULL) {
+			x->left->parent = parent;
+		}
+		x->left = parent;
+	}
+	parent->parent = x;
+	x->parent = grandparent;
+	if (grandparent == NULL) {
+		m_root = x;
+	} else if (grandparent->left == parent) {
+		grandparent->left = x;
+	} else {
+		grandparent->right = x;
+	}
+}
+
+// One zig, zig-zig or zig-zag step of the splay operation
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_splay_step(bst_node_pointer x) {
+	bst_node_pointer parent = x->parent;
+	bst_node_pointer grandparent = parent->parent;
+
+	if (grandparent == NULL) {
+		m_rotate_up(x);
+	} else if ((grandparent->left == parent) == (parent->left == x)) {
+		m_rotate_up(parent);
+		m_rotate_up(x);
+	} else {
+		m_rotate_up(x);
+		m_rotate_up(x);
+	}
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_on_find(bst_node_pointer, bst_plain_access) {}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_on_find(bst_node_pointer x, bst_splay_access) {
+	while (x->parent != NULL) {
+		m_splay_step(x);
+	}
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_on_find(bst_node_pointer x, bst_semi_splay_access) {
+	while (x->parent != NULL && x->parent->parent != NULL) {
+		bst_node_pointer parent = x->parent;
+		bst_node_pointer grandparent = parent->parent;
+		if ((grandparent->left == parent) == (parent->left == x)) {
+			m_rotate_up(parent);
+			x = parent;
+		} else {
+			m_rotate_up(x);
+			m_rotate_up(x);
+		}
+	}
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_on_insert(bst_node_pointer, bst_plain_access) {}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_on_insert(bst_node_pointer x, bst_splay_access) {
+	m_on_find(x, bst_splay_access());
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_on_insert(bst_node_pointer, bst_semi_splay_access) {}
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::bst_node_pointer
-bst<Key, Value, KeyOfValue, Compare, Allocator>::m_allocate_bst_node() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::bst_node_allocator_type
+	bst<Key, Value, KeyOfValue, Compare, Allocator,
+		AccessPolicy>::bst_node_allocator;
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::bst_node_pointer
+bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_allocate_bst_node() const {
 	bst_node_pointer node = bst_node_allocator.allocate(1, this);
 
+#ifdef FT_BST_STATS
+	++m_stats.allocations;
+#endif
 	node->parent = NULL;
 	node->left = NULL;
 	node->right = NULL;
@@ -284,15 +505,25 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::m_allocate_bst_node() const {
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::bst(
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_deallocate_bst_node(bst_node_pointer node) const {
+#ifdef FT_BST_STATS
+	++m_stats.deallocations;
+#endif
+	bst_node_allocator.deallocate(node, 1);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::bst(
 	const Compare &comp, const Allocator &allocator)
 	: m_allocator(allocator), m_size(0), m_root(NULL), m_key_compare(comp) {}
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
+	class Allocator, class AccessPolicy>
 template <class InputIterator>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::bst(
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::bst(
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 		InputIterator>::type first,
 	InputIterator last, const Compare &comp, const Allocator &allocator)
@@ -301,9 +532,9 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::bst(
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::bst(
-	const bst<Key, Value, KeyOfValue, Compare, Allocator> &x)
+	class Allocator, class AccessPolicy>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::bst(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x)
 	: m_allocator(x.get_allocator()), m_size(0), m_root(NULL),
 	  m_key_compare(x.m_key_compare) {
 	m_root = m_copy(x.m_root, NULL);
@@ -311,16 +542,16 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::bst(
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::~bst() {
+	class Allocator, class AccessPolicy>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::~bst() {
 	erase(begin(), end());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bst<Key, Value, KeyOfValue, Compare, Allocator> &
-bst<Key, Value, KeyOfValue, Compare, Allocator>::operator=(
-	const bst<Key, Value, KeyOfValue, Compare, Allocator> &x) {
+	class Allocator, class AccessPolicy>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::operator=(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x) {
 	if (this != &x) {
 		erase(begin(), end());
 		m_root = m_copy(x.m_root, NULL);
@@ -329,105 +560,150 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::operator=(
 	return *this;
 }
 
+#if __cplusplus >= 201103L
+// Takes over the nodes of x, which is left empty
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::allocator_type
-bst<Key, Value, KeyOfValue, Compare, Allocator>::get_allocator() const {
+	class Allocator, class AccessPolicy>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::bst(
+	bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &&x) noexcept
+	: m_allocator(x.m_allocator), m_size(x.m_size), m_root(x.m_root),
+	  m_key_compare(x.m_key_compare) {
+	x.m_size = 0;
+	x.m_root = NULL;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::operator=(
+	bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &&x)
+	noexcept {
+	if (this != &x) {
+		erase(begin(), end());
+		m_allocator = x.m_allocator;
+		m_key_compare = x.m_key_compare;
+		m_size = x.m_size;
+		m_root = x.m_root;
+		x.m_size = 0;
+		x.m_root = NULL;
+	}
+	return *this;
+}
+#endif
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::allocator_type
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::get_allocator(
+	) const {
 	return m_allocator;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::begin() {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::begin() {
 	return iterator(m_minimum(m_root), m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::begin() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::begin() const {
 	return iterator(m_minimum(m_root), m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::end() {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::end() {
 	return iterator(NULL, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::end() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::end() const {
 	return iterator(NULL, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::reverse_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::rbegin() {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::reverse_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::rbegin() {
 	return reverse_iterator(end());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_reverse_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::rbegin() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::const_reverse_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::rbegin() const {
 	return reverse_iterator(end());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::reverse_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::rend() {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::reverse_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::rend() {
 	return reverse_iterator(begin());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_reverse_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::rend() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::const_reverse_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::rend() const {
 	return reverse_iterator(begin());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool bst<Key, Value, KeyOfValue, Compare, Allocator>::empty() const {
+	class Allocator, class AccessPolicy>
+bool bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::empty() const {
 	return m_size == 0;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::size_type
-bst<Key, Value, KeyOfValue, Compare, Allocator>::size() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::size_type
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::size() const {
 	return m_size;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::size_type
-bst<Key, Value, KeyOfValue, Compare, Allocator>::max_size() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::size_type
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::max_size(
+	) const {
 	return bst_node_allocator.max_size();
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-ft::pair<typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator,
+	class Allocator, class AccessPolicy>
+ft::pair<typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+			 AccessPolicy>::iterator,
 	bool>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::insert(
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::insert(
 	const value_type &value) {
 	bst_node_pointer traverse = m_root;
 	bst_node_pointer trailing = NULL;
 
+	FT_BST_COUNT(insert_op);
+
 	while (traverse != NULL && !m_equal_keys(value, traverse->value)) {
 		trailing = traverse;
 		bool comp =
-			m_key_compare(KeyOfValue()(value), KeyOfValue()(traverse->value));
+			m_compare(KeyOfValue()(value), KeyOfValue()(traverse->value));
 		traverse = comp ? traverse->left : traverse->right;
 	}
 	if (traverse != NULL) {
+		m_on_insert(traverse, AccessPolicy());
 		return ft::make_pair(iterator(traverse, m_root), false);
 	}
 
@@ -437,19 +713,20 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::insert(
 	++m_size;
 	if (trailing == NULL) {
 		m_root = node;
-	} else if (m_key_compare(
+	} else if (m_compare(
 				   KeyOfValue()(value), KeyOfValue()(trailing->value))) {
 		trailing->left = node;
 	} else {
 		trailing->right = node;
 	}
+	m_on_insert(node, AccessPolicy());
 	return ft::make_pair(iterator(node, m_root), true);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::insert(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::insert(
 	iterator position, const value_type &x) {
 	// TODO Optimize insert based on position
 	(void)position;
@@ -457,9 +734,9 @@ bst<Key, Value, KeyOfValue, Compare, Allocator>::insert(
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
+	class Allocator, class AccessPolicy>
 template <class InputIterator>
-void bst<Key, Value, KeyOfValue, Compare, Allocator>::insert(
+void bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::insert(
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 		InputIterator>::type first,
 	InputIterator            last) {
@@ -468,12 +745,73 @@ void bst<Key, Value, KeyOfValue, Compare, Allocator>::insert(
 	}
 }
 
+// Inserts x even if an equivalent key is already present,
+// after the last element with an equivalent key
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::insert_equal(
+	const value_type &value) {
+	bst_node_pointer traverse = m_root;
+	bst_node_pointer trailing = NULL;
+	bool             comp = false;
+
+	FT_BST_COUNT(insert_op);
+
+	while (traverse != NULL) {
+		trailing = traverse;
+		comp =
+			m_compare(KeyOfValue()(value), KeyOfValue()(traverse->value));
+		traverse = comp ? traverse->left : traverse->right;
+	}
+
+	bst_node_pointer node = m_allocate_bst_node();
+	m_allocator.construct(m_allocator.address(node->value), value);
+	node->parent = trailing;
+	++m_size;
+	if (trailing == NULL) {
+		m_root = node;
+	} else if (comp) {
+		trailing->left = node;
+	} else {
+		trailing->right = node;
+	}
+	m_on_insert(node, AccessPolicy());
+	return iterator(node, m_root);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::insert_equal(
+	iterator position, const value_type &x) {
+	(void)position;
+	return insert_equal(x);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+template <class InputIterator>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::insert_equal(
+	typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+		InputIterator>::type first,
+	InputIterator            last) {
+	while (first != last) {
+		insert_equal(*first++);
+	}
+}
+
 // Make current->parent point to descendent
 // And descendent->parent point to current->parent;
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-void bst<Key, Value, KeyOfValue, Compare, Allocator>::m_transplant(
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::m_transplant(
 	bst_node_pointer current, bst_node_pointer descendent) {
+#ifdef FT_BST_STATS
+	++m_stats.transplants;
+#endif
 	if (current->parent == NULL) {
 		m_root = descendent;
 	} else if (current == current->parent->left) {
@@ -488,10 +826,12 @@ void bst<Key, Value, KeyOfValue, Compare, Allocator>::m_transplant(
 
 // From https://www.cs.dartmouth.edu/~thc/cs10/lectures/0428/0428.html
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-void bst<Key, Value, KeyOfValue, Compare, Allocator>::erase(iterator position) {
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::erase(iterator position) {
 	bst_node_pointer node = position.base();
 
+	FT_BST_COUNT(erase_op);
 	if (node->left == NULL) {
 		m_transplant(node, node->right);
 	} else if (node->right == NULL) {
@@ -508,26 +848,29 @@ void bst<Key, Value, KeyOfValue, Compare, Allocator>::erase(iterator position) {
 		successor->left->parent = successor;
 	}
 	m_allocator.destroy(m_allocator.address(node->value));
-	bst_node_allocator.deallocate(node, 1);
+	m_deallocate_bst_node(node);
 	--m_size;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::size_type
-bst<Key, Value, KeyOfValue, Compare, Allocator>::erase(const key_type &x) {
-	iterator it = find(x);
-
-	if (it == end()) {
-		return 0;
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::size_type
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::erase(
+	const key_type &x) {
+	ft::pair<iterator, iterator> range = equal_range(x);
+	size_type                    n = 0;
+
+	while (range.first != range.second) {
+		erase(range.first++);
+		++n;
 	}
-	erase(it);
-	return 1;
+	return n;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-void bst<Key, Value, KeyOfValue, Compare, Allocator>::erase(
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::erase(
 	iterator first, iterator last) {
 	while (first != last) {
 		erase(first++);
@@ -535,9 +878,9 @@ void bst<Key, Value, KeyOfValue, Compare, Allocator>::erase(
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-void bst<Key, Value, KeyOfValue, Compare, Allocator>::swap(
-	bst<Key, Value, KeyOfValue, Compare, Allocator> &x) {
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::swap(
+	bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x) {
 	ft::swap(m_allocator, x.m_allocator);
 	ft::swap(m_size, x.m_size);
 	ft::swap(m_root, x.m_root);
@@ -545,205 +888,292 @@ void bst<Key, Value, KeyOfValue, Compare, Allocator>::swap(
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-void bst<Key, Value, KeyOfValue, Compare, Allocator>::clear() {
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::clear() {
 	erase(begin(), end());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::key_compare
-bst<Key, Value, KeyOfValue, Compare, Allocator>::key_comp() const {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::key_compare
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::key_comp(
+	) const {
 	return m_key_compare;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::find(const key_type &key) {
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::find(
+	const key_type &key) {
 	bst_node_pointer traverse = m_root;
 
+	FT_BST_COUNT(find_op);
 	while (traverse != NULL) {
-		const bool comp = m_key_compare(key, KeyOfValue()(traverse->value));
+		const bool comp = m_compare(key, KeyOfValue()(traverse->value));
 		const bool equalKeys =
-			!comp && !m_key_compare(KeyOfValue()(traverse->value), key);
+			!comp && !m_compare(KeyOfValue()(traverse->value), key);
 		if (equalKeys) {
 			break;
 		}
 		traverse = comp ? traverse->left : traverse->right;
 	}
-	return iterator(traverse);
+	if (traverse != NULL) {
+		m_on_find(traverse, AccessPolicy());
+	}
+	return iterator(traverse, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::find(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::const_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::find(
 	const key_type &key) const {
 	bst_node_pointer traverse = m_root;
 
+	FT_BST_COUNT(find_op);
 	while (traverse != NULL) {
-		const bool comp = m_key_compare(key, KeyOfValue()(traverse->value));
+		const bool comp = m_compare(key, KeyOfValue()(traverse->value));
 		const bool equalKeys =
-			!comp && !m_key_compare(KeyOfValue()(traverse->value), key);
+			!comp && !m_compare(KeyOfValue()(traverse->value), key);
 		if (equalKeys) {
 			break;
 		}
 		traverse = comp ? traverse->left : traverse->right;
 	}
-	return const_iterator(traverse);
+	return const_iterator(traverse, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::size_type
-bst<Key, Value, KeyOfValue, Compare, Allocator>::count(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::size_type
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::count(
 	const key_type &key) const {
-	return find(key) == end() ? 0 : 1;
+	ft::pair<const_iterator, const_iterator> range = equal_range(key);
+	return ft::distance(range.first, range.second);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::lower_bound(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::lower_bound(
 	const key_type &key) {
 	bst_node_pointer trailing = NULL;
 	bst_node_pointer traverse = m_root;
 
+	FT_BST_COUNT(bound_op);
 	while (traverse != NULL) {
-		if (!m_key_compare(KeyOfValue()(traverse->value), key)) {
+		if (!m_compare(KeyOfValue()(traverse->value), key)) {
 			trailing = traverse;
 			traverse = traverse->left;
 		} else {
 			traverse = traverse->right;
 		}
 	}
-	return iterator(trailing);
+	return iterator(trailing, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::lower_bound(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::const_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::lower_bound(
 	const key_type &key) const {
 	bst_node_pointer trailing = NULL;
 	bst_node_pointer traverse = m_root;
 
+	FT_BST_COUNT(bound_op);
 	while (traverse != NULL) {
-		if (!m_key_compare(KeyOfValue()(traverse->value), key)) {
+		if (!m_compare(KeyOfValue()(traverse->value), key)) {
 			trailing = traverse;
 			traverse = traverse->left;
 		} else {
 			traverse = traverse->right;
 		}
 	}
-	return const_iterator(trailing);
+	return const_iterator(trailing, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::upper_bound(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::upper_bound(
 	const key_type &key) {
 	bst_node_pointer trailing = NULL;
 	bst_node_pointer traverse = m_root;
 
+	FT_BST_COUNT(bound_op);
 	while (traverse != NULL) {
-		if (m_key_compare(key, KeyOfValue()(traverse->value))) {
+		if (m_compare(key, KeyOfValue()(traverse->value))) {
 			trailing = traverse;
 			traverse = traverse->left;
 		} else {
 			traverse = traverse->right;
 		}
 	}
-	return iterator(trailing);
+	return iterator(trailing, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_iterator
-bst<Key, Value, KeyOfValue, Compare, Allocator>::upper_bound(
+	class Allocator, class AccessPolicy>
+typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::const_iterator
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::upper_bound(
 	const key_type &key) const {
 	bst_node_pointer trailing = NULL;
 	bst_node_pointer traverse = m_root;
 
+	FT_BST_COUNT(bound_op);
 	while (traverse != NULL) {
-		if (m_key_compare(key, KeyOfValue()(traverse->value))) {
+		if (m_compare(key, KeyOfValue()(traverse->value))) {
 			trailing = traverse;
 			traverse = traverse->left;
 		} else {
 			traverse = traverse->right;
 		}
 	}
-	return const_iterator(trailing);
+	return const_iterator(trailing, m_root);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-ft::pair<typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator,
-	typename bst<Key, Value, KeyOfValue, Compare, Allocator>::iterator>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::equal_range(
+	class Allocator, class AccessPolicy>
+ft::pair<typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+			 AccessPolicy>::iterator,
+	typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+		AccessPolicy>::iterator>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::equal_range(
 	const key_type &key) {
 	return ft::make_pair(lower_bound(key), upper_bound(key));
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
+	class Allocator, class AccessPolicy>
 ft::pair<
-	typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_iterator,
-	typename bst<Key, Value, KeyOfValue, Compare, Allocator>::const_iterator>
-bst<Key, Value, KeyOfValue, Compare, Allocator>::equal_range(
+	typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+		AccessPolicy>::const_iterator,
+	typename bst<Key, Value, KeyOfValue, Compare, Allocator,
+		AccessPolicy>::const_iterator>
+bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>::equal_range(
 	const key_type &key) const {
 	return ft::make_pair(lower_bound(key), upper_bound(key));
 }
 
+#ifdef FT_BST_STATS
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+unsigned long bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::s_iterator_hops;
+
+// Counters plus the shape of the tree, measured with an in-order walk that
+// follows parent pointers so that a degenerate tree cannot overflow the stack
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+bst_stats bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::stats() const {
+	bst_stats        stats = m_stats;
+	bst_node_pointer node = m_root;
+	std::size_t      depth = 0;
+	std::size_t      total_depth = 0;
+
+	stats.iterator_hops = atomic_load(&s_iterator_hops, memory_order_relaxed);
+	stats.size = m_size;
+	while (node != NULL && node->left != NULL) {
+		node = node->left;
+		++depth;
+	}
+	while (node != NULL) {
+		if (stats.depth_histogram.size() <= depth) {
+			stats.depth_histogram.resize(depth + 1);
+		}
+		++stats.depth_histogram[depth];
+		total_depth += depth;
+		if (node->right != NULL) {
+			node = node->right;
+			++depth;
+			while (node->left != NULL) {
+				node = node->left;
+				++depth;
+			}
+		} else {
+			while (node->parent != NULL && node == node->parent->right) {
+				node = node->parent;
+				--depth;
+			}
+			node = node->parent;
+			--depth;
+		}
+	}
+	stats.height = stats.depth_histogram.size();
+	stats.max_depth = stats.height ? stats.height - 1 : 0;
+	stats.average_depth = m_size ? double(total_depth) / m_size : 0;
+	return stats;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare,
+	class Allocator, class AccessPolicy>
+void bst<Key, Value, KeyOfValue, Compare, Allocator,
+	AccessPolicy>::reset_stats() {
+	m_stats = bst_stats();
+	atomic_store(&s_iterator_hops, 0UL, memory_order_relaxed);
+}
+#endif
+
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool operator==(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	const bst<Key, Value, KeyOfValue, Compare, Allocator>             &y) {
+	class Allocator, class AccessPolicy>
+bool operator==(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &y) {
 	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool operator!=(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	const bst<Key, Value, KeyOfValue, Compare, Allocator>             &y) {
+	class Allocator, class AccessPolicy>
+bool operator!=(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &y) {
 	return !(x == y);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool operator<(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	const bst<Key, Value, KeyOfValue, Compare, Allocator>            &y) {
+	class Allocator, class AccessPolicy>
+bool operator<(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &y) {
 	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool operator>(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	const bst<Key, Value, KeyOfValue, Compare, Allocator>            &y) {
+	class Allocator, class AccessPolicy>
+bool operator>(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &y) {
 	return y < x;
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool operator<=(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	const bst<Key, Value, KeyOfValue, Compare, Allocator>             &y) {
+	class Allocator, class AccessPolicy>
+bool operator<=(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &y) {
 	return !(y < x);
 }
 
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-bool operator>=(const bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	const bst<Key, Value, KeyOfValue, Compare, Allocator>             &y) {
+	class Allocator, class AccessPolicy>
+bool operator>=(
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	const bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &y) {
 	return !(x < y);
 }
 
 // specialized algorithms:
 template <class Key, class Value, class KeyOfValue, class Compare,
-	class Allocator>
-void swap(bst<Key, Value, KeyOfValue, Compare, Allocator> &x,
-	bst<Key, Value, KeyOfValue, Compare, Allocator>       &y) {
+	class Allocator, class AccessPolicy>
+void swap(bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy> &x,
+	bst<Key, Value, KeyOfValue, Compare, Allocator, AccessPolicy>       &y) {
 	x.swap(y);
 }
 
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include "vector.hpp"
+
+namespace ft {
+
+// Instrumentation of a bst, only gathered when compiled with -D FT_BST_STATS.
+// Counters accumulate from construction or the last reset_stats(); the shape
+// is measured by walking the tree when stats() is called. Lookups update the
+// counters of their tree, so in a stats build a tree is used by one thread
+// at a time, readers included.
+struct bst_stats {
+	// Lookups done by erase(key) and count() are reported under bound_op,
+	// erase_op counts the nodes unlinked
+	enum operation { insert_op, find_op, erase_op, bound_op, operation_count };
+
+	unsigned long            calls[operation_count];
+	unsigned long            comparisons[operation_count];
+	unsigned long            allocations;
+	unsigned long            deallocations;
+	unsigned long            transplants;
+	// Shared by every tree of the same type, iterators do not know their
+	// tree. Counted atomically, so trees used by other threads add to it.
+	unsigned long            iterator_hops;
+
+	std::size_t              size;
+	// Number of levels, 0 for an empty tree
+	std::size_t              height;
+	std::size_t              max_depth;
+	double                   average_depth;
+	// depth_histogram[d] is the number of nodes at depth d, the root being 0
+	ft::vector<std::size_t> depth_histogram;
+
+	// Operation the next comparisons are charged to
+	operation                current;
+
+	bst_stats()
+		: allocations(0), deallocations(0), transplants(0), iterator_hops(0),
+		  size(0), height(0), max_depth(0), average_depth(0),
+		  current(insert_op) {
+		for (int op = 0; op < operation_count; op++) {
+			calls[op] = 0;
+			comparisons[op] = 0;
+		}
+	}
+};
+
+inline std::ostream &operator<<(std::ostream &os, const bst_stats &stats) {
+	static const char *names[bst_stats::operation_count] = {
+		"insert", "find", "erase", "bound"};
+	std::size_t        widest = 0;
+
+	os << "size " << stats.size << ", height " << stats.height
+	   << ", average depth " << stats.average_depth << ", max depth "
+	   << stats.max_depth << '\n';
+	for (int op = 0; op < bst_stats::operation_count; op++) {
+		os << names[op] << ": " << stats.calls[op] << " calls, "
+		   << stats.comparisons[op] << " comparisons";
+		if (stats.calls[op]) {
+			os << " (" << double(stats.comparisons[op]) / stats.calls[op]
+			   << " per call)";
+		}
+		os << '\n';
+	}
+	os << "allocations " << stats.allocations << ", deallocations "
+	   << stats.deallocations << ", transplants " << stats.transplants
+	   << ", iterator hops " << stats.iterator_hops << '\n';
+	for (std::size_t d = 0; d < stats.depth_histogram.size(); d++) {
+		widest = ft::max(widest, stats.depth_histogram[d]);
+	}
+	// One line per depth, bars scaled to at most 60 columns
+	for (std::size_t d = 0; d < stats.depth_histogram.size(); d++) {
+		std::size_t bar = (stats.depth_histogram[d] * 60 + widest - 1) / widest;
+		os << "depth " << d << '\t' << stats.depth_histogram[d] << '\t';
+		for (std::size_t i = 0; i < bar; i++) {
+			os << '#';
+		}
+		os << '\n';
+	}
+	return os;
+}
+
+}  // namespace ft
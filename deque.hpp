@@ -0,0 +1,812 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+namespace ft {
+
+// A double-ended queue in fixed size blocks of block_size elements, found
+// through a map of block pointers. Pushing and popping at either end
+// constructs in place, allocating or freeing one block every block_size
+// elements and growing the map of pointers now and then; the elements never
+// move, so references to them stay valid until they are erased. Random
+// access is one division away.
+//
+// The blocks in use are contiguous in the map, the last one always has room
+// for the next push_back. An empty deque owns nothing until the first push.
+template <class T, class Allocator = std::allocator<T> >
+class deque {
+	typedef typename Allocator::template rebind<T *>::other map_allocator_type;
+	typedef T                                            **map_pointer;
+
+  public:
+	// types
+	typedef typename Allocator::reference       reference;
+	typedef typename Allocator::const_reference const_reference;
+	typedef typename Allocator::size_type       size_type;
+	typedef typename Allocator::difference_type difference_type;
+	typedef T                                   value_type;
+	typedef Allocator                           allocator_type;
+	typedef typename Allocator::pointer         pointer;
+	typedef typename Allocator::const_pointer   const_pointer;
+
+	// 4 KiB of elements, at least 16
+	enum { block_size = sizeof(T) < 256 ? 4096 / sizeof(T) : 16 };
+
+	// The element, the bounds of its block and the slot of the block in
+	// the map
+	template <bool isconst = false>
+	class deque_iterator {
+		friend class deque<T, Allocator>;
+		template <bool>
+		friend class deque_iterator;
+
+	  public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef T                               value_type;
+		typedef typename Allocator::difference_type difference_type;
+		typedef typename Allocator::size_type       size_type;
+		typedef typename ft::choose<isconst, const T &, T &>::type reference;
+		typedef typename ft::choose<isconst, const T *, T *>::type pointer;
+
+		deque_iterator() : m_cur(0), m_first(0), m_last(0), m_node(0) {}
+
+		deque_iterator(T *cur, map_pointer node)
+			: m_cur(cur), m_first(*node), m_last(*node + block_size),
+			  m_node(node) {}
+
+		deque_iterator(const deque_iterator<false> &rhs)
+			: m_cur(rhs.m_cur), m_first(rhs.m_first), m_last(rhs.m_last),
+			  m_node(rhs.m_node) {}
+
+		deque_iterator &operator=(const deque_iterator<false> &rhs) {
+			m_cur = rhs.m_cur;
+			m_first = rhs.m_first;
+			m_last = rhs.m_last;
+			m_node = rhs.m_node;
+			return *this;
+		}
+
+		reference operator*() const {
+			return *m_cur;
+		}
+
+		pointer operator->() const {
+			return m_cur;
+		}
+
+		reference operator[](difference_type n) const {
+			return *(*this + n);
+		}
+
+		deque_iterator &operator++() {
+			if (++m_cur == m_last) {
+				m_set_node(m_node + 1);
+				m_cur = m_first;
+			}
+			return *this;
+		}
+
+		deque_iterator operator++(int) {
+			deque_iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		deque_iterator &operator--() {
+			if (m_cur == m_first) {
+				m_set_node(m_node - 1);
+				m_cur = m_last;
+			}
+			--m_cur;
+			return *this;
+		}
+
+		deque_iterator operator--(int) {
+			deque_iterator tmp(*this);
+			--*this;
+			return tmp;
+		}
+
+		deque_iterator &operator+=(difference_type n) {
+			const difference_type offset = n + (m_cur - m_first);
+			if (offset >= 0 && offset < difference_type(block_size)) {
+				m_cur += n;
+			} else {
+				const difference_type node_offset = offset > 0
+					? offset / difference_type(block_size)
+					: -((-offset - 1) / difference_type(block_size)) - 1;
+				m_set_node(m_node + node_offset);
+				m_cur = m_first
+					+ (offset - node_offset * difference_type(block_size));
+			}
+			return *this;
+		}
+
+		deque_iterator &operator-=(difference_type n) {
+			return *this += -n;
+		}
+
+		deque_iterator operator+(difference_type n) const {
+			deque_iterator tmp(*this);
+			return tmp += n;
+		}
+
+		deque_iterator operator-(difference_type n) const {
+			deque_iterator tmp(*this);
+			return tmp -= n;
+		}
+
+		friend deque_iterator operator+(
+			difference_type n, const deque_iterator &x) {
+			return x + n;
+		}
+
+		friend difference_type operator-(
+			const deque_iterator &x, const deque_iterator &y) {
+			return difference_type(block_size) * (x.m_node - y.m_node)
+				+ (x.m_cur - x.m_first) - (y.m_cur - y.m_first);
+		}
+
+		friend bool operator==(
+			const deque_iterator &x, const deque_iterator &y) {
+			return x.m_cur == y.m_cur;
+		}
+
+		friend bool operator!=(
+			const deque_iterator &x, const deque_iterator &y) {
+			return !(x == y);
+		}
+
+		friend bool operator<(
+			const deque_iterator &x, const deque_iterator &y) {
+			return x.m_node == y.m_node ? x.m_cur < y.m_cur
+										: x.m_node < y.m_node;
+		}
+
+		friend bool operator>(
+			const deque_iterator &x, const deque_iterator &y) {
+			return y < x;
+		}
+
+		friend bool operator<=(
+			const deque_iterator &x, const deque_iterator &y) {
+			return !(y < x);
+		}
+
+		friend bool operator>=(
+			const deque_iterator &x, const deque_iterator &y) {
+			return !(x < y);
+		}
+
+	  private:
+		T          *m_cur;
+		T          *m_first;
+		T          *m_last;
+		map_pointer m_node;
+
+		void m_set_node(map_pointer node) {
+			m_node = node;
+			m_first = *node;
+			m_last = m_first + block_size;
+		}
+	};
+
+	typedef deque_iterator<false>                iterator;
+	typedef deque_iterator<true>                 const_iterator;
+	typedef ft::reverse_iterator<iterator>       reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	// constructor/copy/destroy
+	explicit deque(const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_map(0), m_map_size(0) {}
+
+	explicit deque(size_type n, const T &value = T(),
+		const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_map(0), m_map_size(0) {
+		assign(n, value);
+	}
+
+	template <class InputIterator>
+	deque(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			  InputIterator>::type first,
+		InputIterator last, const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_map(0), m_map_size(0) {
+		assign(first, last);
+	}
+
+	deque(const deque<T, Allocator> &x)
+		: m_allocator(x.m_allocator), m_map(0), m_map_size(0) {
+		assign(x.begin(), x.end());
+	}
+
+	~deque() {
+		clear();
+		m_release();
+	}
+
+	deque<T, Allocator> &operator=(const deque<T, Allocator> &x) {
+		if (this != &x) {
+			assign(x.begin(), x.end());
+		}
+		return *this;
+	}
+
+#if __cplusplus >= 201103L
+	// Takes over the map and the blocks of x, which is left empty
+	deque(deque<T, Allocator> &&x) noexcept
+		: m_allocator(x.m_allocator), m_map(0), m_map_size(0) {
+		m_take(x);
+	}
+
+	deque<T, Allocator> &operator=(deque<T, Allocator> &&x) noexcept {
+		if (this != &x) {
+			clear();
+			m_release();
+			m_take(x);
+		}
+		return *this;
+	}
+#endif
+
+	void assign(size_type n, const T &u) {
+		const T value = u;
+		clear();
+		for (; n != 0; n--) {
+			push_back(value);
+		}
+	}
+
+	template <class InputIterator>
+	void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+					InputIterator>::type first,
+		InputIterator                    last) {
+		clear();
+		for (; first != last; ++first) {
+			push_back(*first);
+		}
+	}
+
+	allocator_type get_allocator() const {
+		return m_allocator;
+	}
+
+	// iterators
+	iterator begin() {
+		return m_start;
+	}
+
+	const_iterator begin() const {
+		return m_start;
+	}
+
+	iterator end() {
+		return m_finish;
+	}
+
+	const_iterator end() const {
+		return m_finish;
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type size() const {
+		return m_finish - m_start;
+	}
+
+	size_type max_size() const {
+		return m_allocator.max_size();
+	}
+
+	void resize(size_type n, T value = T()) {
+		const size_type old_size = size();
+		if (n < old_size) {
+			erase(begin() + n, end());
+		}
+		for (size_type i = old_size; i < n; i++) {
+			push_back(value);
+		}
+	}
+
+	bool empty() const {
+		return m_finish == m_start;
+	}
+
+	// element access
+	reference operator[](size_type n) {
+		return m_start[difference_type(n)];
+	}
+
+	const_reference operator[](size_type n) const {
+		return m_start[difference_type(n)];
+	}
+
+	reference at(size_type n) {
+		if (n >= size()) {
+			throw std::out_of_range(std::string("deque: index out of range"));
+		}
+		return (*this)[n];
+	}
+
+	const_reference at(size_type n) const {
+		if (n >= size()) {
+			throw std::out_of_range(std::string("deque: index out of range"));
+		}
+		return (*this)[n];
+	}
+
+	reference front() {
+		return *m_start.m_cur;
+	}
+
+	const_reference front() const {
+		return *m_start.m_cur;
+	}
+
+	reference back() {
+		iterator last = m_finish;
+		return *--last;
+	}
+
+	const_reference back() const {
+		const_iterator last = m_finish;
+		return *--last;
+	}
+
+	// modifiers
+	// The elements never move, x may be one of them
+	void push_back(const T &x) {
+		if (m_finish.m_last - m_finish.m_cur > 1) {
+			m_allocator.construct(m_finish.m_cur, x);
+			++m_finish.m_cur;
+		} else {
+			m_push_back_slow(x);
+		}
+	}
+
+	void push_front(const T &x) {
+		if (m_start.m_cur != m_start.m_first) {
+			m_allocator.construct(m_start.m_cur - 1, x);
+			--m_start.m_cur;
+		} else {
+			m_push_front_slow(x);
+		}
+	}
+
+#if __cplusplus >= 201103L
+	void push_back(T &&x) {
+		emplace_back(std::move(x));
+	}
+
+	void push_front(T &&x) {
+		emplace_front(std::move(x));
+	}
+
+	template <class... Args>
+	reference emplace_back(Args &&...args) {
+		if (m_finish.m_last - m_finish.m_cur > 1) {
+			std::allocator_traits<Allocator>::construct(
+				m_allocator, m_finish.m_cur, std::forward<Args>(args)...);
+			++m_finish.m_cur;
+		} else {
+			m_push_back_slow(std::forward<Args>(args)...);
+		}
+		return back();
+	}
+
+	template <class... Args>
+	reference emplace_front(Args &&...args) {
+		if (m_start.m_cur != m_start.m_first) {
+			std::allocator_traits<Allocator>::construct(
+				m_allocator, m_start.m_cur - 1, std::forward<Args>(args)...);
+			--m_start.m_cur;
+		} else {
+			m_push_front_slow(std::forward<Args>(args)...);
+		}
+		return front();
+	}
+#endif
+
+	void pop_back() {
+		if (m_finish.m_cur != m_finish.m_first) {
+			--m_finish.m_cur;
+			m_allocator.destroy(m_finish.m_cur);
+		} else {
+			// The last block is empty, the element is at the end of the
+			// one before
+			m_deallocate_block(m_finish.m_first);
+			m_finish.m_set_node(m_finish.m_node - 1);
+			m_finish.m_cur = m_finish.m_last - 1;
+			m_allocator.destroy(m_finish.m_cur);
+		}
+	}
+
+	void pop_front() {
+		m_allocator.destroy(m_start.m_cur);
+		if (m_start.m_last - m_start.m_cur > 1) {
+			++m_start.m_cur;
+		} else {
+			m_deallocate_block(m_start.m_first);
+			m_start.m_set_node(m_start.m_node + 1);
+			m_start.m_cur = m_start.m_first;
+		}
+	}
+
+	iterator insert(iterator position, const T &x) {
+		return insert(position, size_type(1), x);
+	}
+
+	// Pushes the new elements at the end nearer to position and rotates them
+	// into place, moving the shorter side of the deque
+	iterator insert(iterator position, size_type n, const T &x) {
+		const T         value = x;
+		const size_type index = position - begin();
+		if (index < size() / 2) {
+			for (size_type i = 0; i < n; i++) {
+				m_push_front_or_undo(value, i);
+			}
+			ft::rotate(begin(), begin() + n, begin() + (n + index));
+		} else {
+			const size_type old_size = size();
+			for (size_type i = 0; i < n; i++) {
+				m_push_back_or_undo(value, i);
+			}
+			ft::rotate(begin() + index, begin() + old_size, end());
+		}
+		return begin() + index;
+	}
+
+	template <class InputIterator>
+	void insert(iterator position,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			InputIterator>::type first,
+		InputIterator            last) {
+		m_range_insert(position, first, last,
+			typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	iterator erase(iterator position) {
+		return erase(position, position + 1);
+	}
+
+	// Moves the shorter side of the deque over the erased elements and pops
+	// as many from that end
+	iterator erase(iterator first, iterator last) {
+		const size_type index = first - begin();
+		const size_type n = last - first;
+		// Either side would be moved onto itself
+		if (n == 0) {
+			return first;
+		}
+		if (index < (size() - n) / 2) {
+			ft::move_backward(begin(), first, last);
+			for (size_type i = 0; i < n; i++) {
+				pop_front();
+			}
+		} else {
+			ft::move(last, end(), first);
+			for (size_type i = 0; i < n; i++) {
+				pop_back();
+			}
+		}
+		return begin() + index;
+	}
+
+	void swap(deque<T, Allocator> &x) {
+		ft::swap(m_allocator, x.m_allocator);
+		ft::swap(m_map, x.m_map);
+		ft::swap(m_map_size, x.m_map_size);
+		ft::swap(m_start, x.m_start);
+		ft::swap(m_finish, x.m_finish);
+	}
+
+	// Keeps the map and the block of the first element
+	void clear() {
+		if (m_map == 0) {
+			return;
+		}
+		if (m_start.m_node == m_finish.m_node) {
+			ft::destroy(m_start.m_cur, m_finish.m_cur, m_allocator);
+		} else {
+			ft::destroy(m_start.m_cur, m_start.m_last, m_allocator);
+			for (map_pointer node = m_start.m_node + 1;
+				 node != m_finish.m_node; ++node) {
+				ft::destroy(*node, *node + block_size, m_allocator);
+				m_deallocate_block(*node);
+			}
+			ft::destroy(m_finish.m_first, m_finish.m_cur, m_allocator);
+			m_deallocate_block(m_finish.m_first);
+		}
+		m_finish = m_start;
+	}
+
+  private:
+	Allocator   m_allocator;
+	map_pointer m_map;
+	size_type   m_map_size;
+	iterator    m_start;
+	iterator    m_finish;
+
+	enum { initial_map_size = 8 };
+
+	T *m_allocate_block() {
+		return m_allocator.allocate(block_size);
+	}
+
+	void m_deallocate_block(T *block) {
+		m_allocator.deallocate(block, block_size);
+	}
+
+	// Frees the map and the block left by clear()
+	void m_release() {
+		if (m_map != 0) {
+			m_deallocate_block(*m_start.m_node);
+			map_allocator_type(m_allocator).deallocate(m_map, m_map_size);
+			m_map = 0;
+			m_map_size = 0;
+			m_start = m_finish = iterator();
+		}
+	}
+
+#if __cplusplus >= 201103L
+	void m_take(deque<T, Allocator> &x) {
+		m_map = x.m_map;
+		m_map_size = x.m_map_size;
+		m_start = x.m_start;
+		m_finish = x.m_finish;
+		x.m_map = 0;
+		x.m_map_size = 0;
+		x.m_start = x.m_finish = iterator();
+	}
+#endif
+
+	// The first block, in the middle of the map, with the elements starting
+	// in the middle of the block so that both ends can grow
+	void m_initialize_map() {
+		map_pointer map = map_allocator_type(m_allocator).allocate(
+			initial_map_size);
+		try {
+			map[initial_map_size / 2] = m_allocate_block();
+		} catch (...) {
+			map_allocator_type(m_allocator).deallocate(map, initial_map_size);
+			throw;
+		}
+		m_map = map;
+		m_map_size = initial_map_size;
+		const map_pointer node = m_map + initial_map_size / 2;
+		m_start = iterator(*node + block_size / 2, node);
+		m_finish = m_start;
+	}
+
+	// Makes room in the map for nodes more blocks at the back or the front,
+	// by centering the blocks in use when at most half of the map is
+	// needed, or in a map twice as large
+	void m_reserve_map(size_type nodes, bool at_front) {
+		const size_type old_nodes = m_finish.m_node - m_start.m_node + 1;
+		const size_type new_nodes = old_nodes + nodes;
+		map_pointer     new_start;
+		if (m_map_size > 2 * new_nodes) {
+			new_start = m_map + (m_map_size - new_nodes) / 2
+				+ (at_front ? nodes : 0);
+			if (new_start < m_start.m_node) {
+				ft::copy(m_start.m_node, m_finish.m_node + 1, new_start);
+			} else {
+				ft::copy_backward(m_start.m_node, m_finish.m_node + 1,
+					new_start + old_nodes);
+			}
+		} else {
+			const size_type new_map_size =
+				m_map_size + ft::max(m_map_size, nodes) + 2;
+			map_pointer new_map =
+				map_allocator_type(m_allocator).allocate(new_map_size);
+			new_start = new_map + (new_map_size - new_nodes) / 2
+				+ (at_front ? nodes : 0);
+			ft::copy(m_start.m_node, m_finish.m_node + 1, new_start);
+			map_allocator_type(m_allocator).deallocate(m_map, m_map_size);
+			m_map = new_map;
+			m_map_size = new_map_size;
+		}
+		m_start.m_set_node(new_start);
+		m_finish.m_set_node(new_start + old_nodes - 1);
+	}
+
+	void m_reserve_map_at_back() {
+		if (m_finish.m_node + 2 > m_map + m_map_size) {
+			m_reserve_map(1, false);
+		}
+	}
+
+	void m_reserve_map_at_front() {
+		if (m_start.m_node == m_map) {
+			m_reserve_map(1, true);
+		}
+	}
+
+	// Slow paths of push_back and push_front: the first push allocates the
+	// map, later ones fill the last slot of the last block, which needs a
+	// block after it, or start a block before the first one. The element is
+	// constructed before m_start or m_finish move, the new block is freed if
+	// that throws.
+#if __cplusplus >= 201103L
+	template <class... Args>
+	FT_NOINLINE void m_push_back_slow(Args &&...args) {
+#else
+	FT_NOINLINE void m_push_back_slow(const T &x) {
+#endif
+		if (m_map == 0) {
+			m_initialize_map();
+#if __cplusplus >= 201103L
+			emplace_back(std::forward<Args>(args)...);
+#else
+			push_back(x);
+#endif
+			return;
+		}
+		m_reserve_map_at_back();
+		*(m_finish.m_node + 1) = m_allocate_block();
+		try {
+#if __cplusplus >= 201103L
+			std::allocator_traits<Allocator>::construct(
+				m_allocator, m_finish.m_cur, std::forward<Args>(args)...);
+#else
+			m_allocator.construct(m_finish.m_cur, x);
+#endif
+		} catch (...) {
+			m_deallocate_block(*(m_finish.m_node + 1));
+			throw;
+		}
+		m_finish.m_set_node(m_finish.m_node + 1);
+		m_finish.m_cur = m_finish.m_first;
+	}
+
+#if __cplusplus >= 201103L
+	template <class... Args>
+	FT_NOINLINE void m_push_front_slow(Args &&...args) {
+#else
+	FT_NOINLINE void m_push_front_slow(const T &x) {
+#endif
+		if (m_map == 0) {
+			m_initialize_map();
+#if __cplusplus >= 201103L
+			emplace_front(std::forward<Args>(args)...);
+#else
+			push_front(x);
+#endif
+			return;
+		}
+		m_reserve_map_at_front();
+		*(m_start.m_node - 1) = m_allocate_block();
+		T *const slot = *(m_start.m_node - 1) + block_size - 1;
+		try {
+#if __cplusplus >= 201103L
+			std::allocator_traits<Allocator>::construct(
+				m_allocator, slot, std::forward<Args>(args)...);
+#else
+			m_allocator.construct(slot, x);
+#endif
+		} catch (...) {
+			m_deallocate_block(*(m_start.m_node - 1));
+			throw;
+		}
+		m_start.m_set_node(m_start.m_node - 1);
+		m_start.m_cur = slot;
+	}
+
+	// Pushes for insert, popping the count elements pushed before when one
+	// throws
+	void m_push_back_or_undo(const T &x, size_type count) {
+		try {
+			push_back(x);
+		} catch (...) {
+			for (; count != 0; count--) {
+				pop_back();
+			}
+			throw;
+		}
+	}
+
+	void m_push_front_or_undo(const T &x, size_type count) {
+		try {
+			push_front(x);
+		} catch (...) {
+			for (; count != 0; count--) {
+				pop_front();
+			}
+			throw;
+		}
+	}
+
+	template <class InputIterator>
+	void m_range_insert(iterator position, InputIterator first,
+		InputIterator last, std::input_iterator_tag) {
+		const size_type index = position - begin();
+		const size_type old_size = size();
+		for (size_type i = 0; first != last; ++first, ++i) {
+			m_push_back_or_undo(*first, i);
+		}
+		ft::rotate(begin() + index, begin() + old_size, end());
+	}
+
+	// Near the front the range is pushed there backwards and reversed
+	template <class ForwardIterator>
+	void m_range_insert(iterator position, ForwardIterator first,
+		ForwardIterator last, std::forward_iterator_tag) {
+		const size_type index = position - begin();
+		if (index >= size() / 2) {
+			m_range_insert(position, first, last, std::input_iterator_tag());
+			return;
+		}
+		size_type n = 0;
+		for (; first != last; ++first, ++n) {
+			m_push_front_or_undo(*first, n);
+		}
+		ft::reverse(begin(), begin() + n);
+		ft::rotate(begin(), begin() + n, begin() + (n + index));
+	}
+};
+
+template <class T, class Allocator>
+bool operator==(const deque<T, Allocator> &x, const deque<T, Allocator> &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Allocator>
+bool operator!=(const deque<T, Allocator> &x, const deque<T, Allocator> &y) {
+	return !(x == y);
+}
+
+template <class T, class Allocator>
+bool operator<(const deque<T, Allocator> &x, const deque<T, Allocator> &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, class Allocator>
+bool operator>(const deque<T, Allocator> &x, const deque<T, Allocator> &y) {
+	return y < x;
+}
+
+template <class T, class Allocator>
+bool operator<=(const deque<T, Allocator> &x, const deque<T, Allocator> &y) {
+	return !(y < x);
+}
+
+template <class T, class Allocator>
+bool operator>=(const deque<T, Allocator> &x, const deque<T, Allocator> &y) {
+	return !(x < y);
+}
+
+template <class T, class Allocator>
+void swap(deque<T, Allocator> &x, deque<T, Allocator> &y) {
+	x.swap(y);
+}
+
+// The map and the blocks point at each other, never into the deque
+template <class T, class Allocator>
+struct is_trivially_relocatable<deque<T, Allocator> >
+	: public is_trivially_relocatable<Allocator> {};
+
+}  // namespace ft
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <pthread.h>
+#include <cstddef>
+#include "atomic.hpp"
+
+namespace ft {
+
+namespace detail {
+
+// A node unlinked from a concurrent structure, waiting for every reader that
+// may still hold a reference to it to leave its critical section
+struct epoch_retired {
+	void (*free)(void *);
+	void          *object;
+	epoch_retired *next;
+};
+
+// Per-thread state of the epoch domain. Records are never freed: when a
+// thread exits its record is released and reused by the next new thread.
+struct epoch_record {
+	unsigned long  epoch;   // global epoch observed on entry
+	unsigned long  active;  // non zero while inside a critical section
+	int            in_use;  // claimed by a live thread
+	unsigned long  nesting;
+	epoch_retired *retired[3];
+	unsigned long  retired_epoch[3];
+	std::size_t    retired_count;
+	epoch_record  *next;
+	char           pad[cache_line_size];
+};
+
+}  // namespace detail
+
+// Epoch based memory reclamation, shared by every lock-free container.
+// Readers bracket their accesses with enter() / exit(). A writer that unlinks
+// a node hands it to retire() and it is freed once the global epoch has moved
+// twice, proving no critical section that could have seen it is still open.
+// Critical sections nest and must begin and end on the same thread.
+template <class Dummy = void>
+class basic_epoch_domain {
+  private:
+	typedef detail::epoch_record  record;
+	typedef detail::epoch_retired retired;
+
+	// Try to advance the global epoch after this many retirements
+	static const std::size_t advance_threshold = 64;
+
+  public:
+	static void enter() {
+		record *r = m_record();
+
+		if (r->nesting++ != 0) {
+			return;
+		}
+		atomic_store(&r->active, 1UL, memory_order_relaxed);
+		atomic_thread_fence(memory_order_seq_cst);
+		unsigned long e = atomic_load(&s_epoch, memory_order_acquire);
+		if (e != atomic_load(&r->epoch, memory_order_relaxed)) {
+			atomic_store(&r->epoch, e, memory_order_release);
+			m_collect(r, e);
+		}
+	}
+
+	static void exit() {
+		record *r = m_record();
+
+		if (--r->nesting == 0) {
+			atomic_store(&r->active, 0UL, memory_order_release);
+		}
+	}
+
+	// Schedules object for free(object). Must be called after object has
+	// been made unreachable to new readers.
+	static void retire(void *object, void (*free)(void *)) {
+		record       *r = m_record();
+		unsigned long e = atomic_load(&s_epoch, memory_order_seq_cst);
+		std::size_t   slot = e % 3;
+
+		if (r->retired_epoch[slot] != e) {
+			// Anything left in this slot is at least three epochs old
+			m_free_list(r->retired[slot]);
+			r->retired[slot] = NULL;
+			r->retired_epoch[slot] = e;
+		}
+		retired *node = new retired;
+		node->free = free;
+		node->object = object;
+		node->next = r->retired[slot];
+		r->retired[slot] = node;
+		if (++r->retired_count % advance_threshold == 0) {
+			m_try_advance();
+			m_collect(r, atomic_load(&s_epoch, memory_order_acquire));
+		}
+	}
+
+	// Frees whatever the calling thread retired and is now safe to reclaim
+	static void collect() {
+		m_try_advance();
+		m_collect(m_record(), atomic_load(&s_epoch, memory_order_acquire));
+	}
+
+  private:
+	static pthread_key_t  s_key;
+	static pthread_once_t s_once;
+	static unsigned long  s_epoch;
+	static record        *s_records;
+
+	static void m_make_key() {
+		pthread_key_create(&s_key, m_release);
+	}
+
+	// Called on thread exit, hands the record (and its pending
+	// retirements) over to a future thread
+	static void m_release(void *p) {
+		record *r = static_cast<record *>(p);
+
+		r->nesting = 0;
+		atomic_store(&r->active, 0UL, memory_order_release);
+		atomic_store(&r->in_use, 0, memory_order_release);
+	}
+
+	static record *m_record() {
+		pthread_once(&s_once, m_make_key);
+		record *r = static_cast<record *>(pthread_getspecific(s_key));
+		if (r == NULL) {
+			r = m_acquire_record();
+			pthread_setspecific(s_key, r);
+		}
+		return r;
+	}
+
+	static record *m_acquire_record() {
+		for (record *r = atomic_load(&s_records, memory_order_acquire); r;
+			 r = r->next) {
+			int free_slot = 0;
+			if (atomic_load(&r->in_use, memory_order_relaxed) == 0
+				&& atomic_compare_exchange(&r->in_use, free_slot, 1)) {
+				return r;
+			}
+		}
+		record *r = new record();
+		r->in_use = 1;
+		r->next = atomic_load(&s_records, memory_order_relaxed);
+		while (!atomic_compare_exchange(&s_records, r->next, r)) {
+		}
+		return r;
+	}
+
+	// The global epoch can move from e to e + 1 once every thread inside a
+	// critical section has observed e
+	static void m_try_advance() {
+		unsigned long e = atomic_load(&s_epoch, memory_order_seq_cst);
+
+		for (record *r = atomic_load(&s_records, memory_order_acquire); r;
+			 r = r->next) {
+			if (atomic_load(&r->active, memory_order_seq_cst)
+				&& atomic_load(&r->epoch, memory_order_acquire) != e) {
+				return;
+			}
+		}
+		atomic_compare_exchange(&s_epoch, e, e + 1);
+	}
+
+	static void m_collect(record *r, unsigned long e) {
+		for (std::size_t i = 0; i < 3; i++) {
+			if (r->retired[i] && r->retired_epoch[i] + 2 <= e) {
+				m_free_list(r->retired[i]);
+				r->retired[i] = NULL;
+			}
+		}
+	}
+
+	static void m_free_list(retired *node) {
+		while (node) {
+			retired *next = node->next;
+			node->free(node->object);
+			delete node;
+			node = next;
+		}
+	}
+};
+
+template <class Dummy>
+pthread_key_t basic_epoch_domain<Dummy>::s_key;
+
+template <class Dummy>
+pthread_once_t basic_epoch_domain<Dummy>::s_once = PTHREAD_ONCE_INIT;
+
+template <class Dummy>
+unsigned long basic_epoch_domain<Dummy>::s_epoch = 0;
+
+template <class Dummy>
+detail::epoch_record *basic_epoch_domain<Dummy>::s_records = NULL;
+
+typedef basic_epoch_domain<> epoch_domain;
+
+// Keeps the calling thread inside an epoch critical section for its lifetime
+class epoch_guard {
+  public:
+	epoch_guard() {
+		epoch_domain::enter();
+	}
+	~epoch_guard() {
+		epoch_domain::exit();
+	}
+
+  private:
+	epoch_guard(const epoch_guard &);
+	epoch_guard &operator=(const epoch_guard &);
+};
+
+// An epoch_guard that can be copied, every copy holds its own critical
+// section. Iterators keep one so their node is not reclaimed under them.
+class epoch_pin {
+  public:
+	epoch_pin() {
+		epoch_domain::enter();
+	}
+	epoch_pin(const epoch_pin &) {
+		epoch_domain::enter();
+	}
+	~epoch_pin() {
+		epoch_domain::exit();
+	}
+	epoch_pin &operator=(const epoch_pin &) {
+		return *this;
+	}
+};
+
+}  // namespace ft
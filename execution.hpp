@@ -0,0 +1,401 @@
+#pragma once
+#include <cstddef>
+#include "algorithm.hpp"
+#include "atomic.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "thread_pool.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// Execution policy of the parallel overloads of the algorithms: the range is
+// cut into chunks run as tasks of a thread_pool, the default one unless
+// on() names another. The functions given to the algorithms are called
+// concurrently and must not throw.
+class parallel_policy {
+  public:
+	// Fewest elements a chunk is given by default, below it the cost of
+	// queueing the task is no longer small next to the work in it
+	static const std::size_t min_grain = 4096;
+
+	parallel_policy() : m_pool(NULL), m_grain(0) {}
+
+	// The same policy running its tasks on pool
+	parallel_policy on(thread_pool &pool) const {
+		parallel_policy policy(*this);
+		policy.m_pool = &pool;
+		return policy;
+	}
+
+	// The same policy cutting ranges into chunks of grain elements
+	parallel_policy with_grain(std::size_t grain) const {
+		parallel_policy policy(*this);
+		policy.m_grain = grain;
+		return policy;
+	}
+
+	thread_pool &pool() const {
+		return m_pool != NULL ? *m_pool : default_thread_pool();
+	}
+
+	// Elements per chunk of a range of n: about eight chunks per thread, so
+	// that the threads that finish first can steal from the others, and no
+	// fewer than min_grain elements
+	std::size_t grain(std::size_t n) const {
+		if (m_grain != 0) {
+			return m_grain;
+		}
+		const std::size_t threads = pool().size() + 1;
+		const std::size_t least = min_grain;
+		return ft::max(least, n / (threads * 8) + 1);
+	}
+
+  private:
+	thread_pool *m_pool;
+	std::size_t  m_grain;
+};
+
+const parallel_policy par = parallel_policy();
+
+namespace detail {
+
+template <class Body>
+struct range_task {
+	Body       *body;
+	std::size_t begin;
+	std::size_t end;
+	long       *pending;
+
+	static void run(void *arg) {
+		range_task *task = static_cast<range_task *>(arg);
+		(*task->body)(task->begin, task->end);
+		atomic_fetch_sub(task->pending, 1L, memory_order_release);
+	}
+};
+
+// Calls body(begin, end) over [0, n) cut at the multiples of grain, the
+// first chunk on the calling thread and the others as tasks of pool. Returns
+// once every chunk is done, having run queued tasks in the meantime.
+template <class Body>
+void parallel_for(
+	thread_pool &pool, std::size_t n, std::size_t grain, Body &body) {
+	if (n <= grain) {
+		body(0, n);
+		return;
+	}
+	const std::size_t             chunks = (n + grain - 1) / grain;
+	ft::vector<range_task<Body> > tasks(chunks);
+	long                          pending = chunks - 1;
+	for (std::size_t c = chunks - 1; c > 0; c--) {
+		tasks[c].body = &body;
+		tasks[c].begin = c * grain;
+		tasks[c].end = ft::min(n, (c + 1) * grain);
+		tasks[c].pending = &pending;
+		pool.submit(range_task<Body>::run, &tasks[c]);
+	}
+	body(0, grain);
+	pool.wait_for(&pending);
+}
+
+template <class RandomIt, class UnaryFunction>
+struct for_each_body {
+	RandomIt      first;
+	UnaryFunction f;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		ft::for_each(first + begin, first + end, f);
+	}
+};
+
+template <class RandomIt1, class RandomIt2, class UnaryOperation>
+struct transform_body {
+	RandomIt1      first;
+	RandomIt2      d_first;
+	UnaryOperation op;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		ft::transform(first + begin, first + end, d_first + begin, op);
+	}
+};
+
+template <class RandomIt1, class RandomIt2>
+struct copy_body {
+	RandomIt1 first;
+	RandomIt2 d_first;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		ft::copy(first + begin, first + end, d_first + begin);
+	}
+};
+
+template <class RandomIt1, class RandomIt2>
+struct move_body {
+	RandomIt1 first;
+	RandomIt2 d_first;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		ft::move(first + begin, first + end, d_first + begin);
+	}
+};
+
+template <class RandomIt, class T>
+struct fill_body {
+	RandomIt first;
+	const T *value;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		ft::fill(first + begin, first + end, *value);
+	}
+};
+
+// Folds each chunk into its own slot of partials, in chunk order
+template <class RandomIt, class T, class BinaryOperation>
+struct reduce_body {
+	RandomIt        first;
+	T              *partials;
+	std::size_t     grain;
+	BinaryOperation op;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		partials[begin / grain] =
+			ft::reduce(first + (begin + 1), first + end, first[begin], op);
+	}
+};
+
+// Scans a chunk in blocks, giving up once a match was found before it.
+// found holds the lowest index matched so far.
+template <class RandomIt, class UnaryPredicate>
+struct find_if_body {
+	RandomIt       first;
+	UnaryPredicate pred;
+	std::size_t   *found;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		const std::size_t block = 1024;
+		for (std::size_t b = begin; b < end; b += block) {
+			if (atomic_load(found, memory_order_relaxed) < b) {
+				return;
+			}
+			const std::size_t block_end = ft::min(end, b + block);
+			const RandomIt    it =
+				ft::find_if(first + b, first + block_end, pred);
+			if (it != first + block_end) {
+				std::size_t index = it - first;
+				std::size_t current = atomic_load(found, memory_order_relaxed);
+				while (index < current
+					   && !atomic_compare_exchange(found, current, index)) {
+				}
+				return;
+			}
+		}
+	}
+};
+
+template <class RandomIt, class Compare>
+struct sort_body {
+	RandomIt first;
+	Compare  comp;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		ft::sort(first + begin, first + end, comp);
+	}
+};
+
+// Number of elements of a taken among the first k of the merge of a and b,
+// taking those of a first among equal ones
+template <class RandomIt1, class RandomIt2, class Compare>
+std::size_t merge_split(RandomIt1 a, std::size_t na, RandomIt2 b,
+	std::size_t nb, std::size_t k, Compare comp) {
+	std::size_t low = k > nb ? k - nb : 0;
+	std::size_t high = ft::min(k, na);
+	while (low < high) {
+		const std::size_t i = low + (high - low) / 2;
+		const std::size_t j = k - i;
+		if (j > 0 && !comp(b[j - 1], a[i])) {
+			low = i + 1;
+		} else {
+			high = i;
+		}
+	}
+	return low;
+}
+
+// Elements of the first run taken before position pos of the output of a
+// merge round, within the pair of runs of width elements pos falls in
+template <class Src, class Compare>
+std::size_t merge_position(Src src, std::size_t n, std::size_t width,
+	std::size_t pos, Compare comp) {
+	const std::size_t pair = pos / (2 * width) * (2 * width);
+	const std::size_t na = ft::min(width, n - pair);
+	const std::size_t nb = ft::min(width, n - pair - na);
+	return merge_split(src + pair, na, src + pair + na, nb, pos - pair, comp);
+}
+
+// One round of the merges of parallel sort: the sorted runs of width
+// elements of src are merged in pairs into dst. Each chunk of the output
+// starts where splits says, so that one merge is shared by many threads.
+template <class Src, class Dst, class Compare>
+struct merge_body {
+	Src                src;
+	Dst                dst;
+	std::size_t        n;
+	std::size_t        width;
+	std::size_t        grain;
+	const std::size_t *splits;
+	Compare            comp;
+
+	void operator()(std::size_t begin, std::size_t end) {
+		const std::size_t pair = begin / (2 * width) * (2 * width);
+		const std::size_t na = ft::min(width, n - pair);
+		const std::size_t nb = ft::min(width, n - pair - na);
+		const Src         a = src + pair;
+		const Src         b = a + na;
+		const std::size_t c = begin / grain;
+		const std::size_t k_end = ft::min(end, pair + 2 * width) - pair;
+		std::size_t       i = splits[c];
+		std::size_t       j = begin - pair - i;
+		const std::size_t i_end = k_end == na + nb ? na : splits[c + 1];
+		const std::size_t j_end = k_end - i_end;
+		Dst               out = dst + begin;
+		while (i < i_end && j < j_end) {
+			if (comp(b[j], a[i])) {
+				*out++ = FT_MOVE(b[j++]);
+			} else {
+				*out++ = FT_MOVE(a[i++]);
+			}
+		}
+		out = ft::move(a + i, a + i_end, out);
+		ft::move(b + j, b + j_end, out);
+	}
+};
+
+// The splits are all found before any chunk starts moving elements out of
+// src, where the binary searches of the other chunks would read them
+template <class Src, class Dst, class Compare>
+void parallel_merge_round(thread_pool &pool, Src src, Dst dst, std::size_t n,
+	std::size_t width, std::size_t grain, Compare comp) {
+	ft::vector<std::size_t> splits((n + grain - 1) / grain);
+	for (std::size_t c = 0; c < splits.size(); c++) {
+		splits[c] = merge_position(src, n, width, c * grain, comp);
+	}
+	merge_body<Src, Dst, Compare> body = {
+		src, dst, n, width, grain, &splits[0], comp};
+	parallel_for(pool, n, grain, body);
+}
+
+}  // namespace detail
+
+// Parallel overloads over random-access ranges, they return what the
+// sequential ones do
+
+template <class RandomIt, class UnaryFunction>
+void for_each(
+	const parallel_policy &policy, RandomIt first, RandomIt last,
+	UnaryFunction f) {
+	detail::for_each_body<RandomIt, UnaryFunction> body = {first, f};
+	const std::size_t n = last - first;
+	detail::parallel_for(policy.pool(), n, policy.grain(n), body);
+}
+
+template <class RandomIt1, class RandomIt2, class UnaryOperation>
+RandomIt2 transform(const parallel_policy &policy, RandomIt1 first,
+	RandomIt1 last, RandomIt2 d_first, UnaryOperation op) {
+	detail::transform_body<RandomIt1, RandomIt2, UnaryOperation> body = {
+		first, d_first, op};
+	const std::size_t n = last - first;
+	detail::parallel_for(policy.pool(), n, policy.grain(n), body);
+	return d_first + n;
+}
+
+template <class RandomIt1, class RandomIt2>
+RandomIt2 copy(const parallel_policy &policy, RandomIt1 first,
+	RandomIt1 last, RandomIt2 d_first) {
+	detail::copy_body<RandomIt1, RandomIt2> body = {first, d_first};
+	const std::size_t n = last - first;
+	detail::parallel_for(policy.pool(), n, policy.grain(n), body);
+	return d_first + n;
+}
+
+template <class RandomIt, class T>
+void fill(const parallel_policy &policy, RandomIt first, RandomIt last,
+	const T &value) {
+	detail::fill_body<RandomIt, T> body = {first, &value};
+	const std::size_t n = last - first;
+	detail::parallel_for(policy.pool(), n, policy.grain(n), body);
+}
+
+// The chunks are folded on their own and their results into init, in
+// order, so op has to be associative
+template <class RandomIt, class T, class BinaryOperation>
+T reduce(const parallel_policy &policy, RandomIt first, RandomIt last,
+	T init, BinaryOperation op) {
+	const std::size_t n = last - first;
+	const std::size_t grain = policy.grain(n);
+	if (n <= grain) {
+		return ft::reduce(first, last, init, op);
+	}
+	ft::vector<T> partials((n + grain - 1) / grain);
+	detail::reduce_body<RandomIt, T, BinaryOperation> body = {
+		first, &partials[0], grain, op};
+	detail::parallel_for(policy.pool(), n, grain, body);
+	return ft::reduce(partials.begin(), partials.end(), init, op);
+}
+
+template <class RandomIt, class T>
+T reduce(
+	const parallel_policy &policy, RandomIt first, RandomIt last, T init) {
+	return ft::reduce(policy, first, last, init, ft::plus<T>());
+}
+
+template <class RandomIt, class UnaryPredicate>
+RandomIt find_if(const parallel_policy &policy, RandomIt first,
+	RandomIt last, UnaryPredicate pred) {
+	std::size_t found = last - first;
+	detail::find_if_body<RandomIt, UnaryPredicate> body = {
+		first, pred, &found};
+	detail::parallel_for(policy.pool(), found, policy.grain(found), body);
+	return first + found;
+}
+
+// Sorts chunks in parallel, then merges them in rounds through a buffer of
+// the size of the range, every merge split between the threads
+template <class RandomIt, class Compare>
+void sort(const parallel_policy &policy, RandomIt first, RandomIt last,
+	Compare comp) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	const std::size_t n = last - first;
+	const std::size_t grain = policy.grain(n);
+	if (n <= grain) {
+		ft::sort(first, last, comp);
+		return;
+	}
+	thread_pool                         &pool = policy.pool();
+	detail::sort_body<RandomIt, Compare> runs = {first, comp};
+	detail::parallel_for(pool, n, grain, runs);
+	ft::vector<value_type> buffer(n);
+	bool                   in_buffer = false;
+	for (std::size_t width = grain; width < n; width *= 2) {
+		if (in_buffer) {
+			detail::parallel_merge_round(
+				pool, &buffer[0], first, n, width, grain, comp);
+		} else {
+			detail::parallel_merge_round(
+				pool, first, &buffer[0], n, width, grain, comp);
+		}
+		in_buffer = !in_buffer;
+	}
+	if (in_buffer) {
+		detail::move_body<value_type *, RandomIt> body = {&buffer[0], first};
+		detail::parallel_for(pool, n, grain, body);
+	}
+}
+
+template <class RandomIt>
+void sort(const parallel_policy &policy, RandomIt first, RandomIt last) {
+	ft::sort(policy, first, last,
+		ft::less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+}  // namespace ft
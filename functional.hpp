@@ -22,6 +22,13 @@ struct equal_to : binary_function<T, T, bool> {
 	}
 };
 
+template <class T>
+struct plus : binary_function<T, T, T> {
+	T operator()(const T &x, const T &y) const {
+		return x + y;
+	}
+};
+
 template <class T>
 struct less : binary_function<T, T, bool> {
 	bool operator()(const T &x, const T &y) const {
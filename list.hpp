@@ -43,6 +43,11 @@ class list {
 
 		list_iterator(const list_iterator<false> &rhs) : current(rhs.base()) {}
 
+		list_iterator &operator=(const list_iterator<false> &rhs) {
+			current = rhs.base();
+			return *this;
+		}
+
 		reference operator*() const {
 			return current->data;
 		}
@@ -103,6 +108,10 @@ class list {
 	list(const list<T, Allocator> &x);
 	~list();
 	list<T, Allocator> &operator=(const list<T, Allocator> &x);
+#if __cplusplus >= 201103L
+	list(list<T, Allocator> &&x);
+	list<T, Allocator> &operator=(list<T, Allocator> &&x);
+#endif
 	void                assign(size_type n, const T &t);
 	template <class InputIterator>
 	void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
@@ -138,6 +147,11 @@ class list {
 	void                   push_back(const T &value);
 	void                   pop_back();
 	iterator               insert(iterator position, const T &value);
+#if __cplusplus >= 201103L
+	void                   push_front(T &&value);
+	void                   push_back(T &&value);
+	iterator               insert(iterator position, T &&value);
+#endif
 	void insert(iterator position, size_type n, const T &value);
 	template <class InputIterator>
 	void     insert(iterator         position,
@@ -174,6 +188,7 @@ class list {
 	node_pointer   m_node;
 	node_pointer   m_allocate_node() const;
 	void           m_init_header_node();
+	iterator       m_link_node(iterator position, node_pointer node);
 	void           m_transfer(iterator position, iterator first, iterator last);
 };
 
@@ -248,6 +263,25 @@ list<T, Allocator> &list<T, Allocator>::operator=(const list<T, Allocator> &x) {
 	return *this;
 }
 
+#if __cplusplus >= 201103L
+// x gets a new empty header node and keeps no element
+template <class T, class Allocator>
+list<T, Allocator>::list(list<T, Allocator> &&x)
+	: m_allocator(x.get_allocator()), m_length(0) {
+	m_init_header_node();
+	swap(x);
+}
+
+template <class T, class Allocator>
+list<T, Allocator> &list<T, Allocator>::operator=(list<T, Allocator> &&x) {
+	if (this != &x) {
+		clear();
+		swap(x);
+	}
+	return *this;
+}
+#endif
+
 template <class T, class Allocator>
 void list<T, Allocator>::assign(size_type n, const T &value) {
 	clear();
@@ -383,12 +417,39 @@ typename list<T, Allocator>::iterator list<T, Allocator>::insert(
 	iterator position, const T &value) {
 	node_pointer tmp = m_allocate_node();
 	m_allocator.construct(m_allocator.address(tmp->data), value);
-	tmp->next = position.base();
-	tmp->prev = position.base()->prev;
-	position.base()->prev->next = tmp;
-	position.base()->prev = tmp;
+	return m_link_node(position, tmp);
+}
+
+#if __cplusplus >= 201103L
+template <class T, class Allocator>
+void list<T, Allocator>::push_front(T &&value) {
+	insert(begin(), std::move(value));
+}
+
+template <class T, class Allocator>
+void list<T, Allocator>::push_back(T &&value) {
+	insert(end(), std::move(value));
+}
+
+template <class T, class Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::insert(
+	iterator position, T &&value) {
+	node_pointer tmp = m_allocate_node();
+	m_allocator.construct(m_allocator.address(tmp->data), std::move(value));
+	return m_link_node(position, tmp);
+}
+#endif
+
+// Links a constructed node before position
+template <class T, class Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::m_link_node(
+	iterator position, node_pointer node) {
+	node->next = position.base();
+	node->prev = position.base()->prev;
+	position.base()->prev->next = node;
+	position.base()->prev = node;
 	m_length++;
-	return tmp;
+	return node;
 }
 
 template <class T, class Allocator>
@@ -1,17 +1,45 @@
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
+#include <sstream>
+#include <stdexcept>
 #include <stack>
 #include <string>
 #include <utility>
 #include <vector>
+#include "algorithm.hpp"
+#include "deque.hpp"
+#include "execution.hpp"
 #include "list.hpp"
+#include "malloc_allocator.hpp"
 #include "map.hpp"
+#include "mmap_allocator.hpp"
+#include "mmap_vector.hpp"
+#include "mpmc_queue.hpp"
 #include "queue.hpp"
+#include "radix_sort.hpp"
+#include "ring_buffer.hpp"
+#include "set.hpp"
+#include "skiplist_map.hpp"
+#include "small_map.hpp"
+#include "small_vector.hpp"
+#include "soa_vector.hpp"
+#include "spsc_queue.hpp"
 #include "stack.hpp"
+#include "thread_pool.hpp"
+#include "type_traits.hpp"
 #include "utility.hpp"
 #include "vector.hpp"
 
@@ -25,6 +53,16 @@
 
 static int g_errors;
 
+typedef ft::map<int, std::string, ft::less<int>,
+	std::allocator<ft::pair<const int, std::string> >, ft::bst_splay_access>
+	splay_map;
+typedef ft::map<int, int, ft::less<int>,
+	std::allocator<ft::pair<const int, int> >, ft::bst_splay_access>
+	splay_int_map;
+typedef ft::map<int, int, ft::less<int>,
+	std::allocator<ft::pair<const int, int> >, ft::bst_semi_splay_access>
+	semi_splay_int_map;
+
 template <class Container>
 void print_container(const Container &c) {
 	typename Container::const_iterator it = c.begin();
@@ -47,10 +85,26 @@ bool both_numbers_are_even(const T a, const T b) {
 	return is_even(a) && is_even(b);
 }
 
+int generateSmallInt() {
+	return std::rand() % 16;
+}
+
 char generateRandomChar() {
 	return std::rand() % 128;
 }
 
+signed char generateRandomSignedChar() {
+	return std::rand() % 3 - 1;
+}
+
+short generateRandomShort() {
+	return std::rand() % 5 - 2;
+}
+
+double generateRandomDouble() {
+	return std::rand() / 3.0;
+}
+
 std::string generateRandomString() {
 	std::string str;
 	int         length = std::rand() % 65;
@@ -866,6 +920,1076 @@ static void test_map_comparison_operators(const Map1 &, const Map2 &,
 		(m1a >= m1b) >= (m2a == m2b));
 }
 
+template <class Set1, class Set2, class Key>
+static void add_random_set_values(
+	Set1 &s1, Set2 &s2, Key (*generateRandomKey)(), int n) {
+	for (int i = 0; i < n; i++) {
+		Key key = generateRandomKey();
+		s1.insert(key);
+		s2.insert(key);
+	}
+}
+
+template <class Set1, class Set2, class Key>
+static void test_set_constructors(const Set1 &, const Set2 &,
+	Key (*generateRandomKey)(), const char *function_name, int line_number) {
+	std::vector<Key> v;
+
+	for (int i = 0; i < 50; i++) {
+		v.push_back(generateRandomKey());
+	}
+	Set1 s1(v.begin(), v.end());
+	Set2 s2(v.begin(), v.end());
+	test_equal_container(s1, s2, function_name, line_number);
+
+	Set1 s1_copy(s1);
+	Set2 s2_copy(s2);
+	test_equal_container(s1_copy, s2_copy, function_name, line_number);
+
+	Set1 s1_assign;
+	Set2 s2_assign;
+	s1_assign = s1;
+	s2_assign = s2;
+	test_equal_container(s1_assign, s2_assign, function_name, line_number);
+}
+
+template <class Set1, class Set2, class Key>
+static void test_set_insert(const Set1 &, const Set2 &,
+	Key (*generateRandomKey)(), const char *function_name, int line_number) {
+	Set1 s1;
+	Set2 s2;
+
+	add_random_set_values(s1, s2, generateRandomKey, 50);
+	test_equal_container(s1, s2, function_name, line_number);
+
+	Key key = generateRandomKey();
+	s1.insert(s1.begin(), key);
+	s2.insert(s2.begin(), key);
+	test_equal_container(s1, s2, function_name, line_number);
+
+	Set1 s1_range;
+	Set2 s2_range;
+	s1_range.insert(s1.begin(), s1.end());
+	s2_range.insert(s2.begin(), s2.end());
+	s1_range.insert(s1.begin(), s1.end());
+	s2_range.insert(s2.begin(), s2.end());
+	test_equal_container(s1_range, s2_range, function_name, line_number);
+}
+
+template <class Set1, class Set2, class Key>
+static void test_set_erase(const Set1 &, const Set2 &,
+	Key (*generateRandomKey)(), const char *function_name, int line_number) {
+	Set1 s1;
+	Set2 s2;
+
+	add_random_set_values(s1, s2, generateRandomKey, 50);
+	s1.erase(s1.begin());
+	s2.erase(s2.begin());
+	test_equal_container(s1, s2, function_name, line_number);
+
+	Key key = *ft::next(s1.begin());
+	test_values_message(
+		function_name, line_number, "erase", s1.erase(key), s2.erase(key));
+	test_equal_container(s1, s2, function_name, line_number);
+	test_values_message(
+		function_name, line_number, "erase", s1.erase(key), s2.erase(key));
+
+	s1.erase(ft::next(s1.begin()), ft::prev(s1.end()));
+	s2.erase(ft::next(s2.begin()), ft::prev(s2.end()));
+	test_equal_container(s1, s2, function_name, line_number);
+
+	s1.clear();
+	s2.clear();
+	test_equal_container(s1, s2, function_name, line_number);
+}
+
+template <class Set1, class Set2, class Key>
+static void test_set_operations(const Set1 &, const Set2 &,
+	Key (*generateRandomKey)(), const char *function_name, int line_number) {
+	Set1 s1;
+	Set2 s2;
+
+	add_random_set_values(s1, s2, generateRandomKey, 50);
+	for (int i = 0; i < 20; i++) {
+		Key key = generateRandomKey();
+		test_values_message(
+			function_name, line_number, "count", s1.count(key), s2.count(key));
+		test_values(function_name, line_number, "find",
+			s1.find(key) == s1.end(), s2.find(key) == s2.end());
+		test_values(function_name, line_number, "lower_bound",
+			ft::distance(s1.begin(), s1.lower_bound(key)),
+			std::distance(s2.begin(), s2.lower_bound(key)));
+		test_values(function_name, line_number, "upper_bound",
+			ft::distance(s1.begin(), s1.upper_bound(key)),
+			std::distance(s2.begin(), s2.upper_bound(key)));
+		test_values(function_name, line_number, "equal_range",
+			ft::distance(s1.equal_range(key).first, s1.equal_range(key).second),
+			std::distance(
+				s2.equal_range(key).first, s2.equal_range(key).second));
+	}
+}
+
+template <class Set1, class Set2, class Key>
+static void test_set_swap_and_compare(const Set1 &, const Set2 &,
+	Key (*generateRandomKey)(), const char *function_name, int line_number) {
+	Set1 s1a;
+	Set1 s1b;
+	Set2 s2a;
+	Set2 s2b;
+
+	add_random_set_values(s1a, s2a, generateRandomKey, 10);
+	add_random_set_values(s1b, s2b, generateRandomKey, 10);
+	test_condition(function_name, line_number, "equal operator",
+		(s1a == s1b) == (s2a == s2b));
+	test_condition(function_name, line_number, "less than operator",
+		(s1a < s1b) == (s2a < s2b));
+	test_condition(function_name, line_number, "greater equal operator",
+		(s1a >= s1b) == (s2a >= s2b));
+	s1a.swap(s1b);
+	s2a.swap(s2b);
+	test_equal_container(s1a, s2a, function_name, line_number);
+	swap(s1a, s1b);
+	swap(s2a, s2b);
+	test_equal_container(s1b, s2b, function_name, line_number);
+}
+
+template <class SmallMap, class Map>
+static void test_small_map_promotion(const SmallMap &, const Map &,
+	const char *function_name, int line_number) {
+	SmallMap m1;
+	Map      m2;
+
+	for (int i = 0; i < 4; i++) {
+		m1[i] = i;
+		m2[i] = i;
+	}
+	test_condition(function_name, line_number, "is_inline", m1.is_inline());
+	m1[4] = 4;
+	m2[4] = 4;
+	test_condition(function_name, line_number, "promoted", !m1.is_inline());
+	test_equal_map_container(m1, m2, function_name, line_number);
+	m1.erase(0);
+	m2.erase(0);
+	m1.shrink_to_fit();
+	test_condition(function_name, line_number, "demoted", m1.is_inline());
+	test_equal_map_container(m1, m2, function_name, line_number);
+	m1.clear();
+	m2.clear();
+	test_equal_map_container(m1, m2, function_name, line_number);
+}
+
+template <class Map1, class Map2>
+static void test_map_repeated_find(const Map1 &, const Map2 &,
+	const char *function_name, int line_number) {
+	Map1 m1;
+	Map2 m2;
+
+	for (int i = 0; i < 100; i++) {
+		int key = std::rand() % 1000;
+		m1[key] = i;
+		m2[key] = i;
+	}
+	for (int i = 0; i < 500; i++) {
+		int key = std::rand() % 1000;
+		test_values(function_name, line_number, "find",
+			m1.find(key) == m1.end(), m2.find(key) == m2.end());
+		if (m1.find(key) != m1.end()) {
+			test_map_values("find", *m1.find(key), *m2.find(key),
+				function_name, line_number);
+		}
+	}
+	test_equal_map_container(m1, m2, function_name, line_number);
+	typename Map1::reverse_iterator rit1 = m1.rbegin();
+	typename Map2::reverse_iterator rit2 = m2.rbegin();
+	while (rit1 != m1.rend() && rit2 != m2.rend()) {
+		test_map_values("reverse", *rit1++, *rit2++, function_name, line_number);
+	}
+}
+
+template <class Map>
+struct skiplist_worker {
+	Map *map;
+	int  thread;
+	int  threads;
+	int  keys;
+	bool sorted;
+};
+
+// Inserts its share of the keys, checks they can be found, then erases
+// every other one. Iterates the whole map in between to check the order
+// seen while other threads are writing.
+template <class Map>
+static void *skiplist_worker_run(void *arg) {
+	skiplist_worker<Map> *w = static_cast<skiplist_worker<Map> *>(arg);
+
+	for (int key = w->thread; key < w->keys; key += w->threads) {
+		w->map->insert(ft::make_pair(key, key));
+	}
+	for (int key = w->thread; key < w->keys; key += w->threads) {
+		typename Map::iterator it = w->map->find(key);
+		w->sorted = w->sorted && it != w->map->end() && it->second == key;
+	}
+	int previous = -1;
+	for (typename Map::iterator it = w->map->begin(); it != w->map->end();
+		 ++it) {
+		w->sorted = w->sorted && previous < it->first;
+		previous = it->first;
+	}
+	for (int key = w->thread; key < w->keys; key += 2 * w->threads) {
+		w->map->erase(key);
+	}
+	return NULL;
+}
+
+template <class Map>
+static void test_skiplist_map_concurrent(
+	const Map &, const char *function_name, int line_number) {
+	const int            threads = 4;
+	const int            keys = 4000;
+	Map                  m;
+	pthread_t            ids[threads];
+	skiplist_worker<Map> workers[threads];
+
+	for (int i = 0; i < threads; i++) {
+		skiplist_worker<Map> w = {&m, i, threads, keys, true};
+		workers[i] = w;
+		pthread_create(&ids[i], NULL, skiplist_worker_run<Map>, &workers[i]);
+	}
+	for (int i = 0; i < threads; i++) {
+		pthread_join(ids[i], NULL);
+		test_condition(function_name, line_number, "concurrent find",
+			workers[i].sorted);
+	}
+	test_values(function_name, line_number, "concurrent size", m.size(),
+		static_cast<std::size_t>(keys / 2));
+	int expected = 0;
+	for (typename Map::iterator it = m.begin(); it != m.end(); ++it) {
+		while ((expected / threads) % 2 == 0) {
+			expected++;
+		}
+		test_values(function_name, line_number, "concurrent erase", it->first,
+			expected);
+		expected++;
+	}
+	m.erase(m.begin());
+	test_values(function_name, line_number, "erase begin", m.begin()->first,
+		threads + 1);
+}
+
+#ifdef FT_BST_STATS
+// Sorted inserts make the unbalanced tree a list, which the stats must show
+template <class Map>
+static void test_map_stats(
+	const Map &, const char *function_name, int line_number) {
+	Map m;
+
+	for (int i = 0; i < 100; i++) {
+		m[i] = i;
+	}
+	ft::bst_stats stats = m.stats();
+	test_values(function_name, line_number, "height", stats.height,
+		static_cast<std::size_t>(100));
+	test_values(function_name, line_number, "average depth",
+		stats.average_depth, 49.5);
+	test_values(function_name, line_number, "allocations", stats.allocations,
+		100UL);
+	// Three comparisons per level on the way down, one to pick the side
+	test_values(function_name, line_number, "insert comparisons",
+		stats.comparisons[ft::bst_stats::insert_op], 3UL * 4950 + 99);
+	m.reset_stats();
+	m.find(99);
+	for (typename Map::iterator it = m.begin(); it != m.end(); ++it) {
+	}
+	m.erase(m.begin());
+	stats = m.stats();
+	test_values(function_name, line_number, "find calls",
+		stats.calls[ft::bst_stats::find_op], 1UL);
+	test_values(function_name, line_number, "find comparisons",
+		stats.comparisons[ft::bst_stats::find_op], 200UL);
+	// One hop right per step, then climbing the whole chain from the last
+	test_values(function_name, line_number, "iterator hops",
+		stats.iterator_hops, 99UL + 100);
+	test_values(
+		function_name, line_number, "deallocations", stats.deallocations, 1UL);
+	test_values(
+		function_name, line_number, "transplants", stats.transplants, 1UL);
+	test_values(function_name, line_number, "histogram",
+		stats.depth_histogram.size(), static_cast<std::size_t>(99));
+}
+#endif
+
+// Every reallocation made by push_back must land on the capacity the
+// policy asked for, and the contents must not notice the policy
+template <class Vector, class Container2, class T>
+static void test_vector_growth(const Vector &, const Container2 &,
+	T (*generateRandomValue)(), const char *function_name, int line_number) {
+	typedef typename Vector::growth_policy policy;
+	Vector     v1;
+	Container2 c2;
+
+	for (int i = 0; i < 1000; i++) {
+		const std::size_t size = v1.size();
+		const std::size_t capacity = v1.capacity();
+		const T           value = generateRandomValue();
+		v1.push_back(value);
+		c2.push_back(value);
+		if (size == capacity) {
+			test_values(function_name, line_number, "capacity", v1.capacity(),
+				policy::next_capacity(size, 1, sizeof(T)));
+		} else {
+			test_values(function_name, line_number, "capacity", v1.capacity(),
+				capacity);
+		}
+	}
+	test_equal_container(v1, c2, function_name, line_number);
+	const T           value = generateRandomValue();
+	v1.insert(v1.begin() + 10, 3000, value);
+	c2.insert(c2.begin() + 10, 3000, value);
+	test_equal_container(v1, c2, function_name, line_number);
+	const std::size_t n = v1.capacity() + 1;
+	v1.resize(n, value);
+	c2.resize(n, value);
+	test_equal_container(v1, c2, function_name, line_number);
+}
+
+// push_back of an element of the vector itself. With exact growth every call
+// reallocates, releasing the block the argument lives in.
+template <class T, class Container2>
+static void test_vector_push_back_alias(const T &, const Container2 &,
+	T (*generateRandomValue)(), const char *function_name, int line_number) {
+	ft::vector<T, std::allocator<T>, ft::vector_growth_exact> v1;
+	Container2                                                c2;
+
+	for (int i = 0; i < 10; i++) {
+		const T value = generateRandomValue();
+		v1.push_back(value);
+		c2.push_back(value);
+	}
+	for (int i = 0; i < 100; i++) {
+		v1.push_back(v1[i / 2]);
+		c2.push_back(c2[i / 2]);
+		v1.push_back(v1.back());
+		c2.push_back(c2.back());
+		test_equal_container(v1, c2, function_name, line_number);
+	}
+#if __cplusplus >= 201103L
+	for (int i = 0; i < 100; i++) {
+		v1.emplace_back(v1[i]);
+		c2.emplace_back(c2[i]);
+		test_equal_container(v1, c2, function_name, line_number);
+	}
+#endif
+}
+
+#if __cplusplus >= 201103L
+// Counts the copies made of it, its move constructor may throw or not
+template <bool nothrow_move>
+struct copy_counter {
+	static int copies;
+	int        value;
+
+	copy_counter(int value = 0) : value(value) {}
+	copy_counter(const copy_counter &x) : value(x.value) {
+		copies++;
+	}
+	copy_counter(copy_counter &&x) noexcept(nothrow_move) : value(x.value) {}
+	copy_counter &operator=(const copy_counter &x) {
+		value = x.value;
+		copies++;
+		return *this;
+	}
+	copy_counter &operator=(copy_counter &&x) noexcept(nothrow_move) {
+		value = x.value;
+		return *this;
+	}
+};
+
+template <bool nothrow_move>
+int copy_counter<nothrow_move>::copies;
+
+static ft::vector<int> generateRandomVector() {
+	return ft::vector<int>(std::rand() % 10 + 1, std::rand());
+}
+
+// A moved container must equal a copy of the original and the source must be
+// left empty, the elements are not copied again
+template <class Container, class T>
+static void test_move_container(const Container &, T (*generateRandomValue)(),
+	const char *function_name, int line_number) {
+	Container c;
+
+	for (int i = 0; i < 20; i++) {
+		c.insert(c.end(), generateRandomValue());
+	}
+	const Container copy(c);
+	const T        *first = &*c.begin();
+	Container       moved(std::move(c));
+	test_condition(function_name, line_number, "move constructor",
+		moved == copy && c.empty() && &*moved.begin() == first);
+	c = std::move(moved);
+	test_condition(function_name, line_number, "move assignment",
+		c == copy && moved.empty() && &*c.begin() == first);
+}
+
+#endif
+
+// Swaps, copies and moves small vectors of every combination of sizes
+// below, at and above the inline capacity
+template <class SmallVector, class Container2, class T>
+static void test_small_vector_swap(const SmallVector &, const Container2 &,
+	T (*generateRandomValue)(), const char *function_name, int line_number) {
+	const std::size_t sizes[] = {0, 1, 3, 4, 5, 9};
+	const std::size_t count = sizeof(sizes) / sizeof(sizes[0]);
+	const std::size_t inline_capacity = SmallVector().capacity();
+
+	for (std::size_t i = 0; i < count; i++) {
+		for (std::size_t j = 0; j < count; j++) {
+			SmallVector v1;
+			SmallVector v2;
+			Container2  c1;
+			Container2  c2;
+			for (std::size_t k = 0; k < sizes[i]; k++) {
+				v1.push_back(generateRandomValue());
+				c1.push_back(v1.back());
+			}
+			for (std::size_t k = 0; k < sizes[j]; k++) {
+				v2.push_back(generateRandomValue());
+				c2.push_back(v2.back());
+			}
+			v1.swap(v2);
+			c1.swap(c2);
+			test_equal_container(v1, c1, function_name, line_number);
+			test_equal_container(v2, c2, function_name, line_number);
+			test_condition(function_name, line_number, "inline after swap",
+				v1.is_inline() == (sizes[j] <= inline_capacity)
+					&& v2.is_inline() == (sizes[i] <= inline_capacity));
+			SmallVector copy(v1);
+			test_equal_container(copy, c1, function_name, line_number);
+			copy = v2;
+			test_equal_container(copy, c2, function_name, line_number);
+			test_condition(function_name, line_number, "copy equal",
+				copy == v2 && (v1 < v2) == (c1 < c2));
+#if __cplusplus >= 201103L
+			SmallVector moved(std::move(copy));
+			test_equal_container(moved, c2, function_name, line_number);
+			copy = std::move(v1);
+			test_equal_container(copy, c1, function_name, line_number);
+#endif
+		}
+	}
+}
+
+// Spills to the heap past the inline capacity and moves back inline when
+// shrinking
+template <class SmallVector, class Container2, class T>
+static void test_small_vector_spill(const SmallVector &, const Container2 &,
+	T (*generateRandomValue)(), const char *function_name, int line_number) {
+	SmallVector       v1;
+	Container2        c2;
+	const std::size_t inline_capacity = v1.capacity();
+
+	for (std::size_t i = 0; i < inline_capacity; i++) {
+		v1.push_back(generateRandomValue());
+		c2.push_back(v1.back());
+	}
+	test_condition(function_name, line_number, "inline", v1.is_inline());
+	v1.push_back(v1[0]);
+	c2.push_back(c2[0]);
+	test_condition(function_name, line_number, "spilled", !v1.is_inline());
+	test_equal_container(v1, c2, function_name, line_number);
+	const T value = generateRandomValue();
+	v1.insert(v1.begin() + 1, 20, value);
+	c2.insert(c2.begin() + 1, 20, value);
+	v1.insert(v1.end() - 2, c2.begin(), c2.begin() + 5);
+	c2.insert(c2.end() - 2, c2.begin(), c2.begin() + 5);
+	test_equal_container(v1, c2, function_name, line_number);
+	v1.erase(v1.begin(), v1.end() - inline_capacity);
+	c2.erase(c2.begin(), c2.end() - inline_capacity);
+	v1.shrink_to_fit();
+	test_condition(function_name, line_number, "back inline", v1.is_inline());
+	test_equal_container(v1, c2, function_name, line_number);
+	v1.insert(v1.begin(), v1.back());
+	c2.insert(c2.begin(), c2.back());
+	test_equal_container(v1, c2, function_name, line_number);
+	v1.resize(1);
+	c2.resize(1);
+	v1.shrink_to_fit();
+	test_equal_container(v1, c2, function_name, line_number);
+}
+
+// Writer for append_with(), constructs at most limit random values and
+// pushes them to a mirror container as well
+template <class T, class Container2>
+struct mirror_writer {
+	Container2 *mirror;
+	T (*generateRandomValue)();
+	std::size_t limit;
+
+	std::size_t operator()(T *first, std::size_t n) const {
+		const std::size_t count = n < limit ? n : limit;
+		for (std::size_t i = 0; i < count; i++) {
+			new (static_cast<void *>(first + i)) T(generateRandomValue());
+			mirror->push_back(first[i]);
+		}
+		return count;
+	}
+};
+
+// The elements added by resize_uninitialized() are overwritten before they
+// are compared, their value is unspecified for trivially copyable types
+template <class T, class Container2>
+static void test_vector_uninitialized(const T &, const Container2 &,
+	T (*generateRandomValue)(), const char *function_name, int line_number) {
+	ft::vector<T> v1;
+	Container2    c2;
+
+	v1.resize_uninitialized(100);
+	test_values(function_name, line_number, "size", v1.size(), 100UL);
+	for (std::size_t i = 0; i < v1.size(); i++) {
+		v1[i] = generateRandomValue();
+		c2.push_back(v1[i]);
+	}
+	test_equal_container(v1, c2, function_name, line_number);
+	v1.resize_uninitialized(10);
+	c2.resize(10);
+	test_equal_container(v1, c2, function_name, line_number);
+
+	mirror_writer<T, Container2> writer = {&c2, generateRandomValue, 7};
+	test_values(function_name, line_number, "append_with",
+		v1.append_with(50, writer), 7UL);
+	test_condition(function_name, line_number, "append_with capacity",
+		v1.capacity() >= 60);
+	test_equal_container(v1, c2, function_name, line_number);
+	writer.limit = 1000;
+	test_values(function_name, line_number, "append_with",
+		v1.append_with(300, writer), 300UL);
+	test_values(function_name, line_number, "append_with",
+		v1.append_with(0, writer), 0UL);
+	test_equal_container(v1, c2, function_name, line_number);
+}
+
+// Range construction, assign and insert from a stream, which can only be
+// read once, and in place inserts of ranges shorter and longer than the
+// elements after the position
+template <class Vector, class Container2>
+static void test_vector_input_iterators(const Vector &, const Container2 &,
+	const char *function_name, int line_number) {
+	typedef std::istream_iterator<int> input_iterator;
+	std::ostringstream                 numbers;
+
+	for (int i = 0; i < 100; i++) {
+		numbers << std::rand() % 1000 << ' ';
+	}
+	std::istringstream s1(numbers.str());
+	std::istringstream s2(numbers.str());
+	Vector             v1((input_iterator(s1)), input_iterator());
+	Container2         c2((input_iterator(s2)), input_iterator());
+	test_equal_container(v1, c2, function_name, line_number);
+
+	std::istringstream s3("1 2 3");
+	v1.assign(input_iterator(s3), input_iterator());
+	c2.assign(3, 0);
+	c2[0] = 1;
+	c2[1] = 2;
+	c2[2] = 3;
+	test_equal_container(v1, c2, function_name, line_number);
+	s1.clear();
+	s1.str(numbers.str());
+	s2.clear();
+	s2.str(numbers.str());
+	v1.assign(input_iterator(s1), input_iterator());
+	c2.assign(input_iterator(s2), input_iterator());
+	test_equal_container(v1, c2, function_name, line_number);
+
+	s1.clear();
+	s1.str(numbers.str());
+	s2.clear();
+	s2.str(numbers.str());
+	v1.insert(v1.begin() + 10, input_iterator(s1), input_iterator());
+	c2.insert(c2.begin() + 10, input_iterator(s2), input_iterator());
+	test_equal_container(v1, c2, function_name, line_number);
+
+	std::list<int> values;
+	for (int i = 0; i < 30; i++) {
+		values.push_back(std::rand());
+	}
+	v1.reserve(v1.size() * 2);
+	v1.insert(v1.begin() + 3, values.begin(), values.end());
+	c2.insert(c2.begin() + 3, values.begin(), values.end());
+	test_equal_container(v1, c2, function_name, line_number);
+	v1.reserve(v1.size() * 2);
+	v1.insert(v1.end() - 10, values.begin(), values.end());
+	c2.insert(c2.end() - 10, values.begin(), values.end());
+	test_equal_container(v1, c2, function_name, line_number);
+	v1.insert(v1.end() - 20, values.begin(), values.end());
+	c2.insert(c2.end() - 20, values.begin(), values.end());
+	test_equal_container(v1, c2, function_name, line_number);
+}
+
+// Compares and fills contiguous ranges of every length around the vector
+// widths, with the first difference at every position
+template <class T>
+static void test_vectorized_ranges(
+	const T &, T (*generateRandomValue)(), const char *function_name,
+	int line_number) {
+	const std::size_t lengths[] = {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64,
+		65, 100, 1000};
+
+	for (std::size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); l++) {
+		const std::size_t n = lengths[l];
+		std::vector<T>    a(n + 1);
+		for (std::size_t i = 0; i < n; i++) {
+			a[i] = generateRandomValue();
+		}
+		std::vector<T> b(a);
+		test_condition(function_name, line_number, "equal",
+			ft::equal(&a[0], &a[0] + n, &b[0]));
+		test_condition(function_name, line_number, "lexicographical_compare",
+			!ft::lexicographical_compare(&a[0], &a[0] + n, &b[0], &b[0] + n)
+				&& ft::lexicographical_compare(
+					   &a[0], &a[0] + n, &b[0], &b[0] + n + 1));
+		for (std::size_t i = 0; i < n; i += 1 + i / 8) {
+			const T old = b[i];
+			b[i] = generateRandomValue();
+			const T *first1 = &a[0];
+			const T *first2 = &b[0];
+			test_values(function_name, line_number, "equal",
+				ft::equal(first1, first1 + n, first2),
+				std::equal(first1, first1 + n, first2));
+			test_values(function_name, line_number, "lexicographical_compare",
+				ft::lexicographical_compare(&a[0], &a[0] + n, first2,
+					first2 + n - 1),
+				std::lexicographical_compare(&a[0], &a[0] + n, first2,
+					first2 + n - 1));
+			test_values(function_name, line_number, "lexicographical_compare",
+				ft::lexicographical_compare(first2, first2 + n, first1,
+					first1 + n),
+				std::lexicographical_compare(first2, first2 + n, first1,
+					first1 + n));
+			b[i] = old;
+		}
+		for (std::size_t offset = 0; offset < 4 && offset < n; offset++) {
+			const T value = generateRandomValue();
+			std::fill(b.begin() + offset, b.begin() + n, value);
+			ft::fill(&a[0] + offset, &a[0] + n, value);
+			test_condition(function_name, line_number, "fill", a == b);
+			test_condition(function_name, line_number, "fill_n",
+				ft::fill_n(&a[0], n - offset, a[n - 1]) == &a[0] + n - offset);
+			std::fill_n(b.begin(), n - offset, b[n - 1]);
+			test_condition(function_name, line_number, "fill_n", a == b);
+		}
+	}
+}
+
+// Fills a range in one of the orders the sorts have special cases for:
+// random, sorted, reversed and few distinct values
+template <class T>
+static std::vector<T> make_sort_input(
+	std::size_t n, int pattern, T (*generateRandomValue)()) {
+	std::vector<T> values(n);
+	const T        few[] = {generateRandomValue(), generateRandomValue(),
+				generateRandomValue()};
+	for (std::size_t i = 0; i < n; i++) {
+		values[i] = pattern == 3 ? few[std::rand() % 3] : generateRandomValue();
+	}
+	if (pattern == 1) {
+		std::sort(values.begin(), values.end());
+	} else if (pattern == 2) {
+		std::sort(values.begin(), values.end(), std::greater<T>());
+	}
+	return values;
+}
+
+template <class T, class Compare>
+static void test_sorting_with(std::vector<T> values, Compare comp,
+	const char *function_name, int line_number) {
+	const std::size_t n = values.size();
+	std::vector<T>    sorted(values);
+	std::sort(sorted.begin(), sorted.end(), comp);
+
+	std::vector<T> a(values);
+	ft::sort(a.begin(), a.end(), comp);
+	test_condition(function_name, line_number, "sort", a == sorted);
+	a = values;
+	ft::stable_sort(a.begin(), a.end(), comp);
+	test_condition(function_name, line_number, "stable_sort", a == sorted);
+	for (std::size_t k = 0; k <= n; k += 1 + n / 3) {
+		a = values;
+		ft::partial_sort(a.begin(), a.begin() + k, a.end(), comp);
+		test_condition(function_name, line_number, "partial_sort",
+			std::equal(a.begin(), a.begin() + k, sorted.begin()));
+		std::sort(a.begin() + k, a.end(), comp);
+		test_condition(function_name, line_number, "partial_sort rest",
+			a == sorted);
+	}
+	for (std::size_t nth = 0; nth < n; nth += 1 + n / 5) {
+		a = values;
+		ft::nth_element(a.begin(), a.begin() + nth, a.end(), comp);
+		test_condition(
+			function_name, line_number, "nth_element", a[nth] == sorted[nth]);
+		bool partitioned = true;
+		for (std::size_t i = 0; i < n; i++) {
+			if (i < nth ? comp(a[nth], a[i]) : comp(a[i], a[nth])) {
+				partitioned = false;
+			}
+		}
+		test_condition(
+			function_name, line_number, "nth_element partition", partitioned);
+	}
+}
+
+// Sorts every input pattern at sizes around the insertion sort cutoffs,
+// in both directions
+template <class T>
+static void test_sorting(const T &, T (*generateRandomValue)(),
+	const char *function_name, int line_number) {
+	const std::size_t sizes[] = {0, 1, 2, 3, 23, 24, 25, 100, 128, 129, 1000,
+		5000};
+
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		for (int pattern = 0; pattern < 4; pattern++) {
+			const std::vector<T> values =
+				make_sort_input(sizes[s], pattern, generateRandomValue);
+			test_sorting_with(
+				values, std::less<T>(), function_name, line_number);
+			test_sorting_with(
+				values, std::greater<T>(), function_name, line_number);
+		}
+	}
+}
+
+// Radix sorts every input pattern, on one thread and on four, and checks
+// the order against std::sort
+template <class T>
+static void test_radix_sorting(const T &, T (*generateRandomValue)(),
+	const char *function_name, int line_number) {
+	const std::size_t sizes[] = {0, 1, 63, 64, 65, 1000, 70000};
+
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		for (int pattern = 0; pattern < 4; pattern++) {
+			const std::vector<T> values =
+				make_sort_input(sizes[s], pattern, generateRandomValue);
+			std::vector<T> sorted(values);
+			std::sort(sorted.begin(), sorted.end());
+			std::vector<T> a(values);
+			ft::radix_sort(a.begin(), a.end());
+			test_condition(function_name, line_number, "radix_sort",
+				a == sorted);
+			ft::vector<T> b(values.begin(), values.end());
+			ft::parallel_radix_sort(
+				b.begin(), b.end(), ft::identity<T>(), 4);
+			test_condition(function_name, line_number, "parallel_radix_sort",
+				std::equal(b.begin(), b.end(), sorted.begin()));
+		}
+	}
+}
+
+// Checks the packed vector against std::vector<bool> element by element, and
+// count() and find_first()/find_next() against a scan of it
+template <class BitVector>
+static void test_bit_vector_equal(const BitVector &v1,
+	const std::vector<bool> &v2, const char *function_name, int line_number) {
+	std::size_t count = 0;
+	std::size_t next = v1.find_first();
+	bool        found = true;
+
+	test_equal_container(v1, v2, function_name, line_number);
+	for (std::size_t i = 0; i < v2.size(); i++) {
+		if (v2[i]) {
+			count++;
+			found = found && next == i;
+			next = v1.find_next(i);
+		}
+	}
+	test_values(function_name, line_number, "count", v1.count(), count);
+	test_condition(function_name, line_number, "find_next",
+		found && next == BitVector::npos);
+}
+
+// Random inserts and erases at every offset within a word, the word shifts
+// have to line up with one bit at a time moves
+template <class BitVector>
+static void test_bit_vector_shifts(
+	const BitVector &, const char *function_name, int line_number) {
+	BitVector         v1;
+	std::vector<bool> v2;
+
+	for (int i = 0; i < 2000; i++) {
+		const std::size_t pos = v2.empty() ? 0 : std::rand() % (v2.size() + 1);
+		const std::size_t n = std::rand() % 3 == 0 ? std::rand() % 200
+												   : std::rand() % 8;
+		const bool        value = std::rand() & 1;
+		switch (std::rand() % 5) {
+			case 0:
+				v1.insert(v1.begin() + pos, n, value);
+				v2.insert(v2.begin() + pos, n, value);
+				break;
+			case 1: {
+				std::vector<bool> bits(n);
+				for (std::size_t j = 0; j < n; j++) {
+					bits[j] = std::rand() & 1;
+				}
+				v1.insert(v1.begin() + pos, bits.begin(), bits.end());
+				v2.insert(v2.begin() + pos, bits.begin(), bits.end());
+				break;
+			}
+			case 2: {
+				const std::size_t m = ft::min(n, v2.size() - pos);
+				v1.erase(v1.begin() + pos, v1.begin() + pos + m);
+				v2.erase(v2.begin() + pos, v2.begin() + pos + m);
+				break;
+			}
+			case 3:
+				v1.push_back(value);
+				v2.push_back(value);
+				break;
+			default:
+				v1.resize(v2.size() / 2 + n, value);
+				v2.resize(v2.size() / 2 + n, value);
+				break;
+		}
+		if (i % 50 == 0) {
+			v1.flip();
+			v2.flip();
+		}
+		test_bit_vector_equal(v1, v2, function_name, line_number);
+	}
+}
+
+template <class BitVector>
+static void test_bit_vector_operators(
+	const BitVector &, const char *function_name, int line_number) {
+	const std::size_t sizes[] = {0, 1, 63, 64, 65, 1000};
+
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		BitVector         x1(sizes[s]);
+		BitVector         y1(sizes[s]);
+		std::vector<bool> x2(sizes[s]);
+		std::vector<bool> y2(sizes[s]);
+		for (std::size_t i = 0; i < sizes[s]; i++) {
+			x1[i] = x2[i] = std::rand() & 1;
+			y1[i] = y2[i] = std::rand() % 4 == 0;
+		}
+		std::vector<bool> a2(sizes[s]);
+		std::vector<bool> o2(sizes[s]);
+		std::vector<bool> e2(sizes[s]);
+		for (std::size_t i = 0; i < sizes[s]; i++) {
+			a2[i] = x2[i] && y2[i];
+			o2[i] = x2[i] || y2[i];
+			e2[i] = x2[i] != y2[i];
+		}
+		test_bit_vector_equal(x1 & y1, a2, function_name, line_number);
+		test_bit_vector_equal(x1 | y1, o2, function_name, line_number);
+		test_bit_vector_equal(x1 ^ y1, e2, function_name, line_number);
+		test_values(function_name, line_number, "x < y", x1 < y1, x2 < y2);
+		test_values(function_name, line_number, "y < x", y1 < x1, y2 < x2);
+		if (sizes[s] != 0) {
+			x1.pop_back();
+			x2.pop_back();
+		}
+		test_values(function_name, line_number, "shorter", x1 < y1, x2 < y2);
+		test_values(function_name, line_number, "equal", x1 == y1, x2 == y2);
+	}
+	bool threw = false;
+	try {
+		BitVector(3) &= BitVector(4);
+	} catch (const std::invalid_argument &) {
+		threw = true;
+	}
+	test_condition(function_name, line_number, "size mismatch", threw);
+}
+
+// Random pushes and pops at both ends, inserts and erases anywhere and jumps
+// with iterator arithmetic, over enough elements to span many blocks and make
+// the map grow and recenter
+template <class Container1, class Container2, class Generator>
+static void test_deque_random_operations(const Container1 &,
+	const Container2 &, Generator generator, const char *function_name,
+	int line_number) {
+	Container1 c1;
+	Container2 c2;
+
+	for (int i = 0; i < 3000; i++) {
+		const typename Container2::value_type value = generator();
+		const std::size_t pos = c2.empty() ? 0 : std::rand() % (c2.size() + 1);
+		const std::size_t n = std::rand() % 4 == 0 ? std::rand() % 300
+												   : std::rand() % 8;
+		switch (std::rand() % 7) {
+			case 0:
+				for (std::size_t j = 0; j < n; j++) {
+					c1.push_back(value);
+					c2.push_back(value);
+				}
+				break;
+			case 1:
+				for (std::size_t j = 0; j < n; j++) {
+					c1.push_front(value);
+					c2.push_front(value);
+				}
+				break;
+			case 2:
+				for (std::size_t j = 0; j < n && !c2.empty(); j++) {
+					c1.pop_back();
+					c2.pop_back();
+				}
+				break;
+			case 3:
+				for (std::size_t j = 0; j < n && !c2.empty(); j++) {
+					c1.pop_front();
+					c2.pop_front();
+				}
+				break;
+			case 4:
+				c1.insert(c1.begin() + pos, n, value);
+				c2.insert(c2.begin() + pos, n, value);
+				break;
+			case 5: {
+				const std::size_t m = ft::min(n, c2.size() - pos);
+				c1.erase(c1.begin() + pos, c1.begin() + pos + m);
+				c2.erase(c2.begin() + pos, c2.begin() + pos + m);
+				break;
+			}
+			default: {
+				const std::vector<typename Container2::value_type> range(
+					n, value);
+				c1.insert(c1.begin() + pos, range.begin(), range.end());
+				c2.insert(c2.begin() + pos, range.begin(), range.end());
+				break;
+			}
+		}
+		if (!c2.empty()) {
+			const std::size_t k = std::rand() % c2.size();
+			typename Container1::const_iterator it = c1.end();
+			it -= c2.size() - k;
+			test_values(function_name, line_number, "iterator", *it, c2[k]);
+			test_values(function_name, line_number, "distance",
+				it - c1.begin(), typename Container1::difference_type(k));
+			test_values(function_name, line_number, "operator[]", c1[k], c2[k]);
+		}
+		if (i % 100 == 0) {
+			test_equal_container(c1, c2, function_name, line_number);
+		}
+	}
+	test_equal_container(c1, c2, function_name, line_number);
+}
+
+// Random single and bulk pushes and pops on a small buffer, so that it fills
+// up and the counters wrap around the block many times. A std::deque that
+// applies the full policy by hand is the reference.
+template <class RingBuffer, class Generator>
+static void test_ring_buffer_random_operations(const RingBuffer &,
+	Generator generator, const char *function_name, int line_number) {
+	typedef typename RingBuffer::value_type value_type;
+	const bool overwrite = RingBuffer::full_policy::value;
+	RingBuffer              b1(100);
+	std::deque<value_type>  b2;
+	std::vector<value_type> in;
+	std::vector<value_type> out(300);
+
+	test_values(function_name, line_number, "capacity", b1.capacity(),
+		std::size_t(128));
+	for (int i = 0; i < 3000; i++) {
+		const std::size_t n = std::rand() % 4 == 0 ? std::rand() % 300
+												   : std::rand() % 8;
+		switch (std::rand() % 4) {
+			case 0:
+				for (std::size_t j = 0; j < n; j++) {
+					const value_type value = generator();
+					const bool       pushed = b1.try_push_back(value);
+					test_values(function_name, line_number, "try_push_back",
+						pushed, overwrite || b2.size() < 128);
+					if (pushed) {
+						if (b2.size() == 128) {
+							b2.pop_front();
+						}
+						b2.push_back(value);
+					}
+				}
+				break;
+			case 1: {
+				in.clear();
+				for (std::size_t j = 0; j < n; j++) {
+					in.push_back(generator());
+				}
+				const std::size_t taken =
+					b1.push_n(in.empty() ? 0 : &in[0], in.size());
+				const std::size_t room = 128 - b2.size();
+				test_values(function_name, line_number, "push_n", taken,
+					overwrite ? n : ft::min(n, room));
+				for (std::size_t j = 0; j < taken; j++) {
+					if (b2.size() == 128) {
+						b2.pop_front();
+					}
+					b2.push_back(in[j]);
+				}
+				break;
+			}
+			case 2: {
+				const std::size_t popped = b1.pop_n(&out[0], n);
+				test_values(function_name, line_number, "pop_n", popped,
+					ft::min(n, b2.size()));
+				for (std::size_t j = 0; j < popped; j++) {
+					test_values(
+						function_name, line_number, "pop_n", out[j], b2[0]);
+					b2.pop_front();
+				}
+				break;
+			}
+			default:
+				for (std::size_t j = 0; j < n && !b2.empty(); j++) {
+					test_values(function_name, line_number, "back", b1.back(),
+						b2.back());
+					b1.pop_back();
+					b2.pop_back();
+				}
+				break;
+		}
+		test_values(function_name, line_number, "full", b1.full(),
+			b2.size() == 128);
+		if (!b2.empty()) {
+			test_values(
+				function_name, line_number, "front", b1.front(), b2.front());
+		}
+		if (i % 100 == 0) {
+			test_equal_container(b1, b2, function_name, line_number);
+		}
+	}
+	test_equal_container(b1, b2, function_name, line_number);
+}
+
+// Copies over overlapping ranges both ways, which the memmove fast path
+// has to handle like the element by element loop
+template <class T>
+static void test_overlapping_copies(
+	const T &, T (*generateRandomValue)(), const char *function_name,
+	int line_number) {
+	T a1[32];
+	T a2[32];
+
+	for (int i = 0; i < 32; i++) {
+		a1[i] = generateRandomValue();
+		a2[i] = a1[i];
+	}
+	ft::copy(a1 + 8, a1 + 24, a1 + 4);
+	std::copy(a2 + 8, a2 + 24, a2 + 4);
+	test_condition(function_name, line_number, "copy left",
+		std::equal(a1, a1 + 32, a2));
+	ft::copy_backward(a1, a1 + 16, a1 + 20);
+	std::copy_backward(a2, a2 + 16, a2 + 20);
+	test_condition(function_name, line_number, "copy_backward right",
+		std::equal(a1, a1 + 32, a2));
+	test_values(function_name, line_number, "copy result",
+		ft::copy(a1, a1, a1 + 1) - a1, 1);
+	ft::fill(a1 + 3, a1 + 9, a1[0]);
+	std::fill(a2 + 3, a2 + 9, a2[0]);
+	test_condition(
+		function_name, line_number, "fill", std::equal(a1, a1 + 32, a2));
+	ft::fill_n(a1 + 20, 5, a1[31]);
+	std::fill_n(a2 + 20, 5, a2[31]);
+	test_condition(
+		function_name, line_number, "fill_n", std::equal(a1, a1 + 32, a2));
+}
+
 template <class Container1, class Container2>
 static void test_container_count_constructor(const Container1 &,
 	const Container2 &, const char *function_name, int line_number) {
@@ -1489,6 +2613,25 @@ static void test_container_erase_range(const Container1 &, const Container2 &,
 	test_equal_container(c1, c2, function_name, line_number);
 }
 
+// Erasing an empty range changes nothing, wherever it is. Long strings are
+// emptied when moved from, so one moved onto itself shows up.
+template <class Container1, class Container2>
+static void test_container_erase_empty_range(const Container1 &,
+	const Container2 &, const char *function_name, int line_number) {
+	Container1 c1;
+	Container2 c2;
+
+	for (int i = 0; i < 6; i++) {
+		c1.push_back(std::string(40, 'a' + i));
+		c2.push_back(std::string(40, 'a' + i));
+	}
+	for (std::size_t i = 0; i <= c2.size(); i++) {
+		test_condition(function_name, line_number, "erase nothing",
+			c1.erase(c1.begin() + i, c1.begin() + i) == c1.begin() + i);
+		test_equal_container(c1, c2, function_name, line_number);
+	}
+}
+
 template <class Container1, class Container2>
 static void test_container_swap(const Container1 &, const Container2 &,
 	const char *function_name, int line_number) {
@@ -2033,6 +3176,96 @@ static void test_vector() {
 		NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
 }
 
+static void test_deque() {
+	test_container_default_constructor(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_container_count_constructor(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_container_range_constructor(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_container_copy_constructor(
+		NAMESPACE1::deque<int>(5), __FUNCTION__, __LINE__);
+	test_container_assignment_operator(
+		NAMESPACE1::deque<std::string>(10), __FUNCTION__, __LINE__);
+	test_container_assign_count(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 4, __FUNCTION__, __LINE__);
+	test_container_assign_range(NAMESPACE1::deque<float>(10, 100.0f),
+		NAMESPACE2::deque<float>(10, 100.0f), __FUNCTION__, __LINE__);
+	test_container_get_allocator(NAMESPACE1::deque<char>(),
+		NAMESPACE2::deque<char>(), __FUNCTION__, __LINE__);
+	test_container_begin(NAMESPACE1::deque<double>(),
+		NAMESPACE2::deque<double>(), __FUNCTION__, __LINE__);
+	test_container_end(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), __FUNCTION__, __LINE__);
+	test_container_rbegin(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(),
+		__FUNCTION__, __LINE__);
+	test_container_rend(NAMESPACE1::deque<char>(), NAMESPACE2::deque<char>(),
+		__FUNCTION__, __LINE__);
+	test_container_max_size(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_container_resize(NAMESPACE1::deque<char>(1, 'a'),
+		NAMESPACE2::deque<char>(1, 'a'), __FUNCTION__, __LINE__);
+	test_container_empty(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(),
+		__FUNCTION__, __LINE__);
+	test_container_not_empty(NAMESPACE1::deque<int>(1, 1),
+		NAMESPACE2::deque<int>(1, 1), __FUNCTION__, __LINE__);
+	test_container_array_subscript(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 1, __FUNCTION__, __LINE__);
+	test_container_at(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(), 1,
+		__FUNCTION__, __LINE__);
+	test_container_front(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(),
+		123, __FUNCTION__, __LINE__);
+	test_container_back(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(),
+		123, __FUNCTION__, __LINE__);
+	test_container_push_back(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 123, __FUNCTION__, __LINE__);
+	test_container_pop_back(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_container_push_front(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 123, __FUNCTION__, __LINE__);
+	test_container_pop_front(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_container_insert_one(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 1, __FUNCTION__, __LINE__);
+	test_container_insert_count(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 42, __FUNCTION__, __LINE__);
+	test_container_insert_range(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_container_erase_position(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_container_erase_range(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_container_erase_empty_range(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), __FUNCTION__, __LINE__);
+	test_container_swap(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(),
+		__FUNCTION__, __LINE__);
+	test_container_clear(NAMESPACE1::deque<int>(), NAMESPACE2::deque<int>(),
+		__FUNCTION__, __LINE__);
+	test_container_equal_operator(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 123, __FUNCTION__, __LINE__);
+	test_container_notequal_operator(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), 123, __FUNCTION__, __LINE__);
+	test_container_less_operator(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), std::string("abcd"),
+		std::string("bcde"), __FUNCTION__, __LINE__);
+	test_container_greater_operator(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), std::string("abcd"),
+		std::string("bcde"), __FUNCTION__, __LINE__);
+	test_container_lessequal_operator(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), std::string("abcd"),
+		std::string("bcde"), __FUNCTION__, __LINE__);
+	test_container_greaterequal_operator(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), std::string("abcd"),
+		std::string("bcde"), __FUNCTION__, __LINE__);
+	test_container_swap_overload(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), __FUNCTION__, __LINE__);
+	test_deque_random_operations(NAMESPACE1::deque<int>(),
+		NAMESPACE2::deque<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_deque_random_operations(NAMESPACE1::deque<std::string>(),
+		NAMESPACE2::deque<std::string>(), generateRandomString, __FUNCTION__,
+		__LINE__);
+}
+
 static void test_list() {
 	test_container_default_constructor(NAMESPACE1::list<int>(),
 		NAMESPACE2::list<int>(), __FUNCTION__, __LINE__);
@@ -2154,6 +3387,10 @@ void test_queue() {
 		std::rand, __FUNCTION__, __LINE__);
 	test_container_adaptor_comparison_operators(
 		NAMESPACE1::queue<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_queue_push(NAMESPACE1::queue<int, NAMESPACE1::list<int> >(),
+		NAMESPACE2::queue<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_queue_pop(NAMESPACE1::queue<int, NAMESPACE1::list<int> >(),
+		NAMESPACE2::queue<int>(), std::rand, __FUNCTION__, __LINE__);
 }
 
 void test_stack() {
@@ -2171,6 +3408,10 @@ void test_stack() {
 		std::rand, __FUNCTION__, __LINE__);
 	test_container_adaptor_comparison_operators(
 		NAMESPACE1::stack<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_stack_push(NAMESPACE1::stack<int, NAMESPACE1::deque<int> >(),
+		NAMESPACE2::stack<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_stack_pop(NAMESPACE1::stack<int, NAMESPACE1::deque<int> >(),
+		NAMESPACE2::stack<int>(), std::rand, __FUNCTION__, __LINE__);
 }
 
 void test_map() {
@@ -2316,14 +3557,1641 @@ void test_map() {
 		__FUNCTION__, __LINE__);
 }
 
-int main() {
-	std::srand(std::time(NULL));
-	std::clock_t start_time = std::clock();
-	test_vector();
-	test_list();
-	test_queue();
-	test_stack();
-	test_map();
+void test_set() {
+	test_container_default_constructor(NAMESPACE1::set<int>(),
+		NAMESPACE2::set<int>(), __FUNCTION__, __LINE__);
+	test_set_constructors(NAMESPACE1::set<int>(), NAMESPACE2::set<int>(),
+		generateSmallInt, __FUNCTION__, __LINE__);
+	test_set_insert(NAMESPACE1::set<std::string>(),
+		NAMESPACE2::set<std::string>(), generateRandomString, __FUNCTION__,
+		__LINE__);
+	test_set_erase(NAMESPACE1::set<int>(), NAMESPACE2::set<int>(), std::rand,
+		__FUNCTION__, __LINE__);
+	test_set_operations(NAMESPACE1::set<int>(), NAMESPACE2::set<int>(),
+		generateSmallInt, __FUNCTION__, __LINE__);
+	test_set_swap_and_compare(NAMESPACE1::set<int>(), NAMESPACE2::set<int>(),
+		generateSmallInt, __FUNCTION__, __LINE__);
+}
+
+void test_multiset() {
+	test_container_default_constructor(NAMESPACE1::multiset<int>(),
+		NAMESPACE2::multiset<int>(), __FUNCTION__, __LINE__);
+	test_set_constructors(NAMESPACE1::multiset<int>(),
+		NAMESPACE2::multiset<int>(), generateSmallInt, __FUNCTION__, __LINE__);
+	test_set_insert(NAMESPACE1::multiset<int>(), NAMESPACE2::multiset<int>(),
+		generateSmallInt, __FUNCTION__, __LINE__);
+	test_set_erase(NAMESPACE1::multiset<int>(), NAMESPACE2::multiset<int>(),
+		generateSmallInt, __FUNCTION__, __LINE__);
+	test_set_operations(NAMESPACE1::multiset<int>(),
+		NAMESPACE2::multiset<int>(), generateSmallInt, __FUNCTION__, __LINE__);
+	test_set_swap_and_compare(NAMESPACE1::multiset<int>(),
+		NAMESPACE2::multiset<int>(), generateSmallInt, __FUNCTION__, __LINE__);
+}
+
+void test_multimap() {
+	test_map_default_constructor(NAMESPACE1::multimap<int, int>(),
+		NAMESPACE2::multimap<int, int>(), __FUNCTION__, __LINE__);
+	test_map_range_constructor(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_copy_constructor(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_insert_hint(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_insert_range(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_erase_key(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_erase_range(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_count(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_map_equal_range(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE1::pair<NAMESPACE1::multimap<int, std::string>::iterator,
+			NAMESPACE1::multimap<int, std::string>::iterator>(),
+		NAMESPACE2::multimap<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(),
+		NAMESPACE2::pair<NAMESPACE2::multimap<int, std::string>::iterator,
+			NAMESPACE2::multimap<int, std::string>::iterator>(),
+		generateSmallInt, generateRandomString, __FUNCTION__, __LINE__);
+	test_map_comparison_operators(NAMESPACE1::multimap<int, std::string>(),
+		NAMESPACE2::multimap<int, std::string>(), generateSmallInt,
+		generateRandomString, __FUNCTION__, __LINE__);
+}
+
+// A comparator with state, ascending unless told otherwise
+struct ordered_by {
+	bool descending;
+
+	explicit ordered_by(bool order = false) : descending(order) {}
+
+	bool operator()(int a, int b) const {
+		return descending ? b < a : a < b;
+	}
+};
+
+void test_small_map() {
+	test_map_default_constructor(ft::small_map<int, std::string, 4>(),
+		NAMESPACE2::map<int, std::string>(), __FUNCTION__, __LINE__);
+	test_map_range_constructor(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_copy_constructor(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_assignment_operator(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_begin(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_end(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_rbegin(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_rend(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_empty(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_element_access(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_insert_hint(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_insert_range(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_erase_position(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_erase_key(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_erase_range(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_swap(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_clear(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_value_comp(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_find(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_count(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_lower_bound(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_upper_bound(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_insert_value(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE1::pair<ft::small_map<int, std::string, 4>::iterator, bool>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(),
+		NAMESPACE2::pair<NAMESPACE2::map<int, std::string>::iterator, bool>(),
+		std::rand, generateRandomString, __FUNCTION__, __LINE__);
+	test_map_equal_range(ft::small_map<int, std::string, 4>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE1::pair<ft::small_map<int, std::string, 4>::iterator,
+			ft::small_map<int, std::string, 4>::iterator>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(),
+		NAMESPACE2::pair<NAMESPACE2::map<int, std::string>::iterator,
+			NAMESPACE2::map<int, std::string>::iterator>(),
+		std::rand, generateRandomString, __FUNCTION__, __LINE__);
+	test_map_comparison_operators(ft::small_map<int, std::string, 4>(),
+		NAMESPACE2::map<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_small_map_promotion(ft::small_map<int, int, 4>(),
+		NAMESPACE2::map<int, int>(), __FUNCTION__, __LINE__);
+	// Assignment takes the comparator of the other map
+	ft::small_map<int, int, 4, ordered_by> descending((ordered_by(true)));
+	ft::small_map<int, int, 4, ordered_by> ascending;
+	descending[1] = 1;
+	descending[2] = 2;
+	ascending = descending;
+	ascending[3] = 3;
+	test_condition(__FUNCTION__, __LINE__, "assignment comparator",
+		ascending.key_comp().descending && ascending.begin()->first == 3
+			&& (--ascending.end())->first == 1);
+}
+
+void test_skiplist_map() {
+	test_map_default_constructor(ft::skiplist_map<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(), __FUNCTION__, __LINE__);
+	test_map_range_constructor(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_copy_constructor(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_assignment_operator(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_begin(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_empty(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_element_access(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_insert_hint(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_insert_range(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_erase_key(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_swap(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_clear(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_value_comp(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_find(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_count(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_lower_bound(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_upper_bound(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_insert_value(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE1::pair<ft::skiplist_map<int, std::string>::iterator, bool>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(),
+		NAMESPACE2::pair<NAMESPACE2::map<int, std::string>::iterator, bool>(),
+		std::rand, generateRandomString, __FUNCTION__, __LINE__);
+	test_map_equal_range(ft::skiplist_map<int, std::string>(),
+		NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE1::pair<ft::skiplist_map<int, std::string>::iterator,
+			ft::skiplist_map<int, std::string>::iterator>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(),
+		NAMESPACE2::pair<NAMESPACE2::map<int, std::string>::iterator,
+			NAMESPACE2::map<int, std::string>::iterator>(),
+		std::rand, generateRandomString, __FUNCTION__, __LINE__);
+	test_map_comparison_operators(ft::skiplist_map<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_skiplist_map_concurrent(
+		ft::skiplist_map<int, int>(), __FUNCTION__, __LINE__);
+}
+
+#ifdef FT_BST_STATS
+void test_map_stats() {
+	test_map_stats(ft::map<int, int>(), __FUNCTION__, __LINE__);
+}
+#endif
+
+void test_splay_map() {
+	test_map_range_constructor(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_rbegin(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_erase_position(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_erase_key(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_find(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_lower_bound(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_upper_bound(splay_map(), NAMESPACE1::pair<int, std::string>(),
+		NAMESPACE2::map<int, std::string>(),
+		NAMESPACE2::pair<int, std::string>(), std::rand, generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_map_repeated_find(
+		splay_int_map(), NAMESPACE2::map<int, int>(), __FUNCTION__, __LINE__);
+	test_map_repeated_find(semi_splay_int_map(), NAMESPACE2::map<int, int>(),
+		__FUNCTION__, __LINE__);
+}
+
+// Trivially copyable, but its default constructor sets x
+struct five {
+	int x;
+
+	five() : x(5) {}
+};
+
+void test_vector_growth() {
+	test_vector_growth(ft::vector<int>(), NAMESPACE2::vector<int>(), std::rand,
+		__FUNCTION__, __LINE__);
+	test_vector_growth(
+		ft::vector<int, std::allocator<int>, ft::vector_growth_1_5x>(),
+		NAMESPACE2::vector<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_vector_growth(
+		ft::vector<char, std::allocator<char>, ft::vector_growth_exact>(),
+		NAMESPACE2::vector<char>(), generateRandomChar, __FUNCTION__,
+		__LINE__);
+	test_vector_growth(ft::vector<std::string, std::allocator<std::string>,
+						   ft::vector_growth_size_class>(),
+		NAMESPACE2::vector<std::string>(), generateRandomString, __FUNCTION__,
+		__LINE__);
+	test_vector_push_back_alias(std::string(),
+		NAMESPACE2::vector<std::string>(), generateRandomString, __FUNCTION__,
+		__LINE__);
+	test_vector_push_back_alias(
+		int(), NAMESPACE2::vector<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_vector_input_iterators(
+		ft::vector<int>(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_vector_input_iterators(ft::small_vector<int, 8>(),
+		NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_vector_uninitialized(
+		int(), NAMESPACE2::vector<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_vector_uninitialized(std::string(),
+		NAMESPACE2::vector<std::string>(), generateRandomString, __FUNCTION__,
+		__LINE__);
+	// Types that are not trivially copyable are still default constructed
+	ft::vector<std::string> strings(3, "abc");
+	strings.resize_uninitialized(6);
+	test_condition(__FUNCTION__, __LINE__, "resize_uninitialized string",
+		strings[2] == "abc" && strings[3].empty() && strings[5].empty());
+	ft::vector<five> fives(2);
+	fives[0].x = 1;
+	fives.resize_uninitialized(100);
+	test_condition(__FUNCTION__, __LINE__, "resize_uninitialized five",
+		fives[0].x == 1 && fives[1].x == 5 && fives[99].x == 5);
+	test_condition(__FUNCTION__, __LINE__, "five not trivially constructible",
+		ft::is_trivially_copyable<five>::value
+			&& !ft::is_trivially_default_constructible<five>::value
+			&& ft::is_trivially_default_constructible<int>::value);
+#if __cplusplus >= 201103L
+	ft::vector<std::string>          v1;
+	NAMESPACE2::vector<std::string> v2;
+	for (int i = 0; i < 50; i++) {
+		v2.emplace_back(i, 'a' + i % 26);
+		test_values(__FUNCTION__, __LINE__, "emplace_back",
+			v1.emplace_back(i, 'a' + i % 26), v2.back());
+	}
+	test_equal_container(v1, v2, __FUNCTION__, __LINE__);
+	test_condition(__FUNCTION__, __LINE__, "erase nothing",
+		v1.erase(v1.begin() + 2, v1.begin() + 2) == v1.begin() + 2);
+	test_equal_container(v1, v2, __FUNCTION__, __LINE__);
+#endif
+	test_values(__FUNCTION__, __LINE__, "size class",
+		ft::vector_growth_size_class::block_size(1), 16UL);
+	test_values(__FUNCTION__, __LINE__, "size class",
+		ft::vector_growth_size_class::block_size(17), 20UL);
+	test_values(__FUNCTION__, __LINE__, "size class",
+		ft::vector_growth_size_class::block_size(100), 112UL);
+	test_values(__FUNCTION__, __LINE__, "size class",
+		ft::vector_growth_size_class::block_size(3000), 3072UL);
+	test_values(__FUNCTION__, __LINE__, "size class",
+		ft::vector_growth_size_class::block_size(4097), 8192UL);
+	test_values(__FUNCTION__, __LINE__, "huge page",
+		ft::vector_growth_size_class::block_size(2 * 1024 * 1024 + 1),
+		4UL * 1024 * 1024);
+}
+
+#if __cplusplus >= 201103L
+void test_move_semantics() {
+	test_move_container(ft::vector<std::string>(), generateRandomString,
+		__FUNCTION__, __LINE__);
+	test_move_container(
+		ft::list<std::string>(), generateRandomString, __FUNCTION__, __LINE__);
+	test_move_container(ft::vector<ft::vector<int> >(), generateRandomVector,
+		__FUNCTION__, __LINE__);
+
+	ft::map<int, std::string> m1;
+	for (int i = 0; i < 20; i++) {
+		m1[std::rand()] = generateRandomString();
+	}
+	const ft::map<int, std::string> m2(m1);
+	ft::map<int, std::string>       m3(std::move(m1));
+	test_condition(__FUNCTION__, __LINE__, "map move constructor",
+		m3 == m2 && m1.empty());
+	m1 = std::move(m3);
+	test_condition(__FUNCTION__, __LINE__, "map move assignment",
+		m1 == m2 && m3.empty());
+
+	ft::stack<std::string> s1;
+	ft::queue<std::string> q1;
+	for (int i = 0; i < 20; i++) {
+		std::string value = generateRandomString();
+		s1.push(value);
+		q1.push(std::move(value));
+	}
+	const ft::stack<std::string> s2(s1);
+	const ft::queue<std::string> q2(q1);
+	ft::stack<std::string>       s3(std::move(s1));
+	ft::queue<std::string>       q3(std::move(q1));
+	test_condition(__FUNCTION__, __LINE__, "stack move constructor",
+		s3 == s2 && s1.empty());
+	test_condition(__FUNCTION__, __LINE__, "queue move constructor",
+		q3 == q2 && q1.empty());
+
+	// Growing moves the elements only when that cannot throw
+	ft::vector<copy_counter<true> >  v1;
+	ft::vector<copy_counter<false> > v2;
+	for (int i = 0; i < 1000; i++) {
+		v1.push_back(copy_counter<true>(i));
+		v2.push_back(copy_counter<false>(i));
+	}
+	test_values(__FUNCTION__, __LINE__, "nothrow move copies",
+		copy_counter<true>::copies, 0);
+	test_condition(__FUNCTION__, __LINE__, "throwing move copies",
+		copy_counter<false>::copies > 0);
+	v1.insert(v1.begin() + 10, copy_counter<true>(-1));
+	v1.insert(v1.begin() + 20, 1, copy_counter<true>(-2));
+	v1.erase(v1.begin() + 30);
+	v1.erase(v1.begin() + 40, v1.begin() + 50);
+	// Only the counted insert copies, into a temporary and then into place
+	test_values(__FUNCTION__, __LINE__, "insert and erase copies",
+		copy_counter<true>::copies, 2);
+
+	ft::vector<std::string>         v3;
+	NAMESPACE2::vector<std::string> v4;
+	for (int i = 0; i < 100; i++) {
+		std::string value = generateRandomString();
+		const int   position = std::rand() % (v3.size() + 1);
+		v4.insert(v4.begin() + position, value);
+		v3.insert(v3.begin() + position, std::move(value));
+		test_equal_container(v3, v4, __FUNCTION__, __LINE__);
+	}
+}
+#endif
+
+void test_malloc_allocator() {
+	typedef ft::malloc_allocator<long>            long_allocator;
+	typedef ft::malloc_allocator<ft::vector<int> > vector_allocator;
+
+	test_condition(__FUNCTION__, __LINE__, "int relocatable",
+		ft::is_trivially_relocatable<int>::value);
+	test_condition(__FUNCTION__, __LINE__, "vector relocatable",
+		ft::is_trivially_relocatable<ft::vector<std::string> >::value);
+	test_vector_growth(ft::vector<int, ft::malloc_allocator<int> >(),
+		NAMESPACE2::vector<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_vector_growth(
+		ft::vector<std::string, ft::malloc_allocator<std::string> >(),
+		NAMESPACE2::vector<std::string>(), generateRandomString, __FUNCTION__,
+		__LINE__);
+
+	// Grows from the heap into a mapping, then through mremap
+	ft::vector<long, long_allocator> v1;
+	NAMESPACE2::vector<long>         v2;
+	for (long i = 0; i < 1000000; i++) {
+		v1.push_back(i * 3);
+		v2.push_back(i * 3);
+	}
+	test_equal_container(v1, v2, __FUNCTION__, __LINE__);
+	v1.reserve(v1.capacity() * 3);
+	v1.resize(v1.capacity() + 1, 7);
+	v2.resize(v1.size(), 7);
+	test_equal_container(v1, v2, __FUNCTION__, __LINE__);
+
+	// Vectors are relocated bitwise, their blocks must not move
+	ft::vector<ft::vector<int>, vector_allocator> v3;
+	ft::vector<const int *>                       blocks;
+	for (int i = 0; i < 100; i++) {
+		v3.push_back(ft::vector<int>(i + 1, i));
+		blocks.push_back(&v3.back()[0]);
+	}
+	for (int i = 0; i < 100; i++) {
+		test_condition(__FUNCTION__, __LINE__, "relocated vector",
+			&v3[i][0] == blocks[i] && v3[i] == ft::vector<int>(i + 1, i));
+	}
+}
+
+void test_small_vector() {
+	typedef ft::small_vector<int, 4>         int_vector;
+	typedef ft::small_vector<std::string, 4> string_vector;
+
+	test_container_default_constructor(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_count_constructor(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_range_constructor(int_vector(), NAMESPACE2::vector<int>(),
+		std::rand, __FUNCTION__, __LINE__);
+	test_container_copy_constructor(int_vector(5), __FUNCTION__, __LINE__);
+	test_container_assignment_operator(
+		string_vector(10), __FUNCTION__, __LINE__);
+	test_container_assign_count(
+		int_vector(), NAMESPACE2::vector<int>(), 4, __FUNCTION__, __LINE__);
+	test_container_begin(ft::small_vector<double, 4>(),
+		NAMESPACE2::vector<double>(), __FUNCTION__, __LINE__);
+	test_container_end(string_vector(), NAMESPACE2::vector<std::string>(),
+		__FUNCTION__, __LINE__);
+	test_container_rbegin(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_resize(ft::small_vector<char, 4>(1, 'a'),
+		NAMESPACE2::vector<char>(1, 'a'), __FUNCTION__, __LINE__);
+	test_container_at(
+		int_vector(), NAMESPACE2::vector<int>(), 1, __FUNCTION__, __LINE__);
+	test_container_reserve(int_vector(10, 42), NAMESPACE2::vector<int>(10, 42),
+		__FUNCTION__, __LINE__);
+	test_container_push_back(
+		int_vector(), NAMESPACE2::vector<int>(), 123, __FUNCTION__, __LINE__);
+	test_container_pop_back(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_insert_one(
+		int_vector(), NAMESPACE2::vector<int>(), 1, __FUNCTION__, __LINE__);
+	test_container_insert_count(
+		int_vector(), NAMESPACE2::vector<int>(), 42, __FUNCTION__, __LINE__);
+	test_container_insert_range(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_erase_position(int_vector(), NAMESPACE2::vector<int>(),
+		std::rand, __FUNCTION__, __LINE__);
+	test_container_erase_range(int_vector(), NAMESPACE2::vector<int>(),
+		std::rand, __FUNCTION__, __LINE__);
+	test_container_erase_empty_range(string_vector(),
+		NAMESPACE2::vector<std::string>(), __FUNCTION__, __LINE__);
+	test_container_swap(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_clear(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_container_equal_operator(
+		int_vector(), NAMESPACE2::vector<int>(), 123, __FUNCTION__, __LINE__);
+	test_container_less_operator(string_vector(),
+		NAMESPACE2::vector<std::string>(), std::string("abcd"),
+		std::string("bcde"), __FUNCTION__, __LINE__);
+	test_container_swap_overload(
+		int_vector(), NAMESPACE2::vector<int>(), __FUNCTION__, __LINE__);
+	test_small_vector_swap(int_vector(), NAMESPACE2::vector<int>(), std::rand,
+		__FUNCTION__, __LINE__);
+	test_small_vector_swap(string_vector(), NAMESPACE2::vector<std::string>(),
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_small_vector_spill(int_vector(), NAMESPACE2::vector<int>(), std::rand,
+		__FUNCTION__, __LINE__);
+	test_small_vector_spill(string_vector(), NAMESPACE2::vector<std::string>(),
+		generateRandomString, __FUNCTION__, __LINE__);
+#if __cplusplus >= 201103L
+	// A vector of them moves them when it grows, whether they are inline or
+	// not, and copies none of their elements
+	ft::vector<ft::small_vector<copy_counter<true>, 2> > nested;
+	for (int i = 0; i < 20; i++) {
+		nested.emplace_back(i % 4, copy_counter<true>(i));
+	}
+	const int copies = copy_counter<true>::copies;
+	nested.reserve(nested.capacity() + 1);
+	test_values(__FUNCTION__, __LINE__, "nested copies",
+		copy_counter<true>::copies, copies);
+	// test_move_semantics counts from zero
+	copy_counter<true>::copies = 0;
+#endif
+}
+
+void test_vector_bool() {
+	typedef NAMESPACE1::vector<bool> bool_vector;
+
+	test_container_default_constructor(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_count_constructor(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_range_constructor(bool_vector(), NAMESPACE2::vector<bool>(),
+		std::rand, __FUNCTION__, __LINE__);
+	test_container_copy_constructor(bool_vector(70), __FUNCTION__, __LINE__);
+	test_container_assignment_operator(
+		bool_vector(130), __FUNCTION__, __LINE__);
+	test_container_assign_count(bool_vector(), NAMESPACE2::vector<bool>(),
+		true, __FUNCTION__, __LINE__);
+	test_container_begin(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_end(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_rbegin(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_rend(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_resize(bool_vector(1, true),
+		NAMESPACE2::vector<bool>(1, true), __FUNCTION__, __LINE__);
+	test_container_at(bool_vector(), NAMESPACE2::vector<bool>(), true,
+		__FUNCTION__, __LINE__);
+	test_container_front(bool_vector(), NAMESPACE2::vector<bool>(), true,
+		__FUNCTION__, __LINE__);
+	test_container_back(bool_vector(), NAMESPACE2::vector<bool>(), true,
+		__FUNCTION__, __LINE__);
+	test_container_reserve(bool_vector(10, true),
+		NAMESPACE2::vector<bool>(10, true), __FUNCTION__, __LINE__);
+	test_container_push_back(bool_vector(), NAMESPACE2::vector<bool>(), true,
+		__FUNCTION__, __LINE__);
+	test_container_pop_back(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_insert_one(bool_vector(), NAMESPACE2::vector<bool>(), true,
+		__FUNCTION__, __LINE__);
+	test_container_insert_count(bool_vector(), NAMESPACE2::vector<bool>(),
+		true, __FUNCTION__, __LINE__);
+	test_container_insert_range(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_erase_position(bool_vector(), NAMESPACE2::vector<bool>(),
+		std::rand, __FUNCTION__, __LINE__);
+	test_container_erase_range(bool_vector(), NAMESPACE2::vector<bool>(),
+		std::rand, __FUNCTION__, __LINE__);
+	test_container_swap(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_clear(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_container_equal_operator(bool_vector(), NAMESPACE2::vector<bool>(),
+		true, __FUNCTION__, __LINE__);
+	test_container_less_operator(bool_vector(), NAMESPACE2::vector<bool>(),
+		false, true, __FUNCTION__, __LINE__);
+	test_container_swap_overload(
+		bool_vector(), NAMESPACE2::vector<bool>(), __FUNCTION__, __LINE__);
+	test_bit_vector_shifts(ft::vector<bool>(), __FUNCTION__, __LINE__);
+	test_bit_vector_operators(ft::vector<bool>(), __FUNCTION__, __LINE__);
+}
+
+struct soa_record {
+	int         id;
+	double      price;
+	std::string name;
+};
+
+// Rows pushed, read and written through the proxies and scanned by column
+// against a vector of structs
+void test_soa_vector() {
+	typedef ft::soa_vector<int, double, std::string> record_vector;
+	record_vector                                     v1;
+	std::vector<soa_record>                           v2;
+
+	test_values(__FUNCTION__, __LINE__, "column_count",
+		int(record_vector::column_count), 3);
+	for (int i = 0; i < 1000; i++) {
+		const soa_record r = {std::rand(), generateRandomDouble(),
+			generateRandomString()};
+		v1.push_back(r.id, r.price, r.name);
+		v2.push_back(r);
+	}
+	for (int i = 0; i < 100; i++) {
+		v1.pop_back();
+		v2.pop_back();
+	}
+	for (std::size_t i = 0; i < v2.size(); i += 7) {
+		v1[i].get<1>() += 1.0;
+		v2[i].price += 1.0;
+	}
+	test_values(__FUNCTION__, __LINE__, "size", v1.size(), v2.size());
+	bool equal = true;
+	for (std::size_t i = 0; i < v2.size(); i++) {
+		const record_vector &c1 = v1;
+		equal = equal && c1[i].get<0>() == v2[i].id
+			&& c1[i].get<1>() == v2[i].price && v1.at(i).get<2>() == v2[i].name
+			&& v1[i].index() == i;
+	}
+	test_condition(__FUNCTION__, __LINE__, "rows", equal);
+
+	ft::soa_span<double> prices = v1.column<1>();
+	double               sum1 = 0;
+	double               sum2 = 0;
+	for (double *p = prices.begin(); p != prices.end(); ++p) {
+		sum1 += *p;
+	}
+	for (std::size_t i = 0; i < v2.size(); i++) {
+		sum2 += v2[i].price;
+	}
+	test_values(__FUNCTION__, __LINE__, "column sum", sum1, sum2);
+	const std::size_t ids =
+		reinterpret_cast<std::size_t>(v1.column<0>().data());
+	const std::size_t price_data = reinterpret_cast<std::size_t>(prices.data());
+	test_condition(__FUNCTION__, __LINE__, "aligned",
+		ids % ft::cache_line_size == 0
+			&& price_data % ft::cache_line_size == 0);
+
+	record_vector copy(v1);
+	record_vector other;
+	other.push_back(42);
+	copy.swap(other);
+	test_values(__FUNCTION__, __LINE__, "swap", copy.size(), std::size_t(1));
+	test_values(__FUNCTION__, __LINE__, "default field",
+		copy[0].get<2>(), std::string());
+	test_values(__FUNCTION__, __LINE__, "copy", other.size(), v2.size());
+	v1.resize(10);
+	v1.reserve(1000);
+	test_values(__FUNCTION__, __LINE__, "resize", v1.column<2>().size(),
+		std::size_t(10));
+	test_condition(__FUNCTION__, __LINE__, "reserve", v1.capacity() >= 1000);
+	v1.clear();
+	test_condition(__FUNCTION__, __LINE__, "clear",
+		v1.empty() && v1.column<1>().empty());
+	bool threw = false;
+	try {
+		v1.at(0);
+	} catch (const std::out_of_range &) {
+		threw = true;
+	}
+	test_condition(__FUNCTION__, __LINE__, "at", threw);
+}
+
+void test_ring_buffer() {
+	typedef ft::ring_buffer<int, std::allocator<int>, ft::ring_buffer_overwrite>
+		overwrite_buffer;
+
+	test_ring_buffer_random_operations(
+		ft::ring_buffer<int>(), std::rand, __FUNCTION__, __LINE__);
+	test_ring_buffer_random_operations(ft::ring_buffer<std::string>(),
+		generateRandomString, __FUNCTION__, __LINE__);
+	test_ring_buffer_random_operations(
+		overwrite_buffer(), std::rand, __FUNCTION__, __LINE__);
+	test_ring_buffer_random_operations(
+		ft::ring_buffer<std::string, std::allocator<std::string>,
+			ft::ring_buffer_overwrite>(),
+		generateRandomString, __FUNCTION__, __LINE__);
+
+	ft::queue<int, ft::ring_buffer<int> > q1(ft::ring_buffer<int>(16));
+	std::queue<int>                       q2;
+	for (int i = 0; i < 1000; i++) {
+		if (q2.size() < 16 && std::rand() % 3 != 0) {
+			const int value = std::rand();
+			q1.push(value);
+			q2.push(value);
+		} else if (!q2.empty()) {
+			q1.pop();
+			q2.pop();
+		}
+		test_values(__FUNCTION__, __LINE__, "queue size", q1.size(), q2.size());
+		if (!q2.empty()) {
+			test_values(
+				__FUNCTION__, __LINE__, "queue front", q1.front(), q2.front());
+			test_values(
+				__FUNCTION__, __LINE__, "queue back", q1.back(), q2.back());
+		}
+	}
+
+	ft::ring_buffer<int> full(4);
+	for (int i = 0; i < 4; i++) {
+		full.push_back(i);
+	}
+	bool threw = false;
+	try {
+		full.push_back(4);
+	} catch (const std::length_error &) {
+		threw = true;
+	}
+	test_condition(__FUNCTION__, __LINE__, "push_back full", threw);
+	test_values(__FUNCTION__, __LINE__, "kept", full.back(), 3);
+
+	overwrite_buffer latest(4);
+	for (int i = 0; i < 10; i++) {
+		latest.push_back(i);
+	}
+	latest.push_back(latest.front());
+	test_values(__FUNCTION__, __LINE__, "overwrite front", latest.front(), 7);
+	test_values(__FUNCTION__, __LINE__, "overwrite back", latest.back(), 6);
+
+	ft::ring_buffer<int> copy(full);
+	ft::ring_buffer<int> none;
+	test_condition(__FUNCTION__, __LINE__, "copy", copy == full);
+	test_condition(__FUNCTION__, __LINE__, "no room",
+		none.capacity() == 0 && none.full() && !none.try_push_back(1));
+	none = copy;
+	copy.pop_front();
+	test_condition(__FUNCTION__, __LINE__, "compare",
+		none < copy && none != copy && none.at(3) == 3);
+	ft::swap(none, copy);
+	test_values(__FUNCTION__, __LINE__, "swap", none.size(), std::size_t(3));
+	threw = false;
+	try {
+		none.at(3);
+	} catch (const std::out_of_range &) {
+		threw = true;
+	}
+	test_condition(__FUNCTION__, __LINE__, "at", threw);
+	// Rounding the capacity up must not wrap around to zero
+	threw = false;
+	try {
+		ft::ring_buffer<int> huge(std::size_t(-1));
+	} catch (const std::length_error &) {
+		threw = true;
+	}
+	test_condition(__FUNCTION__, __LINE__, "huge capacity", threw);
+}
+
+void test_mmap_allocator() {
+	typedef ft::mmap_allocator<long>    allocator;
+	typedef ft::vector<long, allocator> long_vector;
+	const unsigned flags[] = {0, ft::mmap_huge_pages,
+		ft::mmap_huge_pages | ft::mmap_populate,
+		ft::mmap_hugetlb | ft::mmap_populate};
+
+	for (std::size_t i = 0; i < sizeof(flags) / sizeof(*flags); i++) {
+		// Grows from malloc into mappings
+		long_vector              v1((allocator(flags[i])));
+		NAMESPACE2::vector<long> v2;
+		for (long j = 0; j < 1000000; j++) {
+			v1.push_back(j * 5);
+			v2.push_back(j * 5);
+		}
+		test_equal_container(v1, v2, __FUNCTION__, __LINE__);
+		test_condition(__FUNCTION__, __LINE__, "huge page aligned",
+			reinterpret_cast<std::size_t>(&v1[0])
+					% allocator::huge_page_size
+				== 0);
+		v1.erase(v1.begin() + 10, v1.end() - 10);
+		v2.erase(v2.begin() + 10, v2.end() - 10);
+		long_vector copy(v1.begin(), v1.end(), v1.get_allocator());
+		test_equal_container(copy, v2, __FUNCTION__, __LINE__);
+	}
+	// Everything mapped, even the smallest blocks
+	ft::vector<std::string, ft::mmap_allocator<std::string> > v3(
+		ft::mmap_allocator<std::string>(ft::mmap_huge_pages, 0));
+	NAMESPACE2::vector<std::string> v4;
+	for (int i = 0; i < 1000; i++) {
+		v3.push_back(generateRandomString());
+		v4.push_back(v3.back());
+	}
+	test_equal_container(v3, v4, __FUNCTION__, __LINE__);
+	test_condition(__FUNCTION__, __LINE__, "allocator equality",
+		allocator() == allocator(ft::mmap_huge_pages)
+			&& allocator() != allocator(ft::mmap_populate)
+			&& allocator(0, 4096) != allocator(0, 8192));
+}
+
+void test_mmap_vector() {
+	char path[] = "/tmp/ft_mmap_vector_XXXXXX";
+	int  fd = mkstemp(path);
+	test_condition(__FUNCTION__, __LINE__, "mkstemp", fd >= 0);
+	close(fd);
+
+	// Appends grow the file, closing cuts it back to the elements
+	NAMESPACE2::vector<long> c;
+	{
+		ft::mmap_vector<long> v(path, ft::mmap_read_write);
+		for (long i = 0; i < 100000; i++) {
+			v.push_back(std::rand());
+			c.push_back(v.back());
+		}
+		test_equal_container(v, c, __FUNCTION__, __LINE__);
+	}
+	struct stat st;
+	stat(path, &st);
+	test_values(__FUNCTION__, __LINE__, "file size",
+		static_cast<std::size_t>(st.st_size), c.size() * sizeof(long));
+
+	ft::mmap_vector<long> v1(path);
+	test_equal_container(v1, c, __FUNCTION__, __LINE__);
+	test_condition(__FUNCTION__, __LINE__, "read only",
+		v1.mode() == ft::mmap_read_only && v1.capacity() == v1.size());
+	try {
+		v1.push_back(1);
+		test_condition(__FUNCTION__, __LINE__, "push_back read only", false);
+	} catch (std::logic_error &) {
+	}
+
+	// Private changes stay in memory
+	ft::mmap_vector<long> v2(path, ft::mmap_copy_on_write);
+	v2[0] = -1;
+	v2.back() = -2;
+	test_condition(__FUNCTION__, __LINE__, "copy on write",
+		v1[0] == c[0] && v1.back() == c.back() && v2[0] == -1);
+	v2.close();
+	test_condition(__FUNCTION__, __LINE__, "closed", !v2.is_open());
+
+	// Shared changes reach the file and the other mappings
+	v2.open(path, ft::mmap_read_write);
+	v2[10] = -3;
+	v2.pop_back();
+	c[10] = -3;
+	c.pop_back();
+	v2.flush();
+	v2.close();
+	v1.open(path);
+	test_equal_container(v1, c, __FUNCTION__, __LINE__);
+
+	// A partial element at the end of the file
+	fd = open(path, O_WRONLY | O_APPEND);
+	test_condition(__FUNCTION__, __LINE__, "write", write(fd, "x", 1) == 1);
+	close(fd);
+	try {
+		v2.open(path);
+		test_condition(__FUNCTION__, __LINE__, "partial element", false);
+	} catch (std::runtime_error &) {
+		test_condition(__FUNCTION__, __LINE__, "closed", !v2.is_open());
+	}
+	// A file that failed to open for writing is left as it was
+	const std::size_t partial = c.size() * sizeof(long) + 1;
+	try {
+		v2.open(path, ft::mmap_read_write);
+		test_condition(__FUNCTION__, __LINE__, "partial element", false);
+	} catch (std::runtime_error &) {
+		stat(path, &st);
+		test_values(__FUNCTION__, __LINE__, "file size",
+			static_cast<std::size_t>(st.st_size), partial);
+	}
+	unlink(path);
+	try {
+		v2.open(path);
+		test_condition(__FUNCTION__, __LINE__, "missing file", false);
+	} catch (std::runtime_error &) {
+	}
+}
+
+static bool compare_first(
+	const std::pair<int, int> &a, const std::pair<int, int> &b) {
+	return a.first < b.first;
+}
+
+// Equal keys have to stay in the order they came in, the second member
+// records it
+void test_stable_sort() {
+	const std::size_t sizes[] = {10, 33, 64, 100, 1000, 10000};
+
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		std::vector<std::pair<int, int> > v1;
+		for (std::size_t i = 0; i < sizes[s]; i++) {
+			v1.push_back(std::make_pair(std::rand() % 16, int(i)));
+		}
+		std::vector<std::pair<int, int> > v2(v1);
+		ft::stable_sort(v1.begin(), v1.end(), compare_first);
+		std::stable_sort(v2.begin(), v2.end(), compare_first);
+		test_condition(__FUNCTION__, __LINE__, "stable", v1 == v2);
+	}
+	// Plain arrays, the iterators are pointers
+	int a1[] = {5, 3, 9, 1, 5, 7, 2, 8, 0, 6};
+	int a2[] = {5, 3, 9, 1, 5, 7, 2, 8, 0, 6};
+	ft::sort(a1, a1 + 10);
+	std::sort(a2, a2 + 10);
+	test_condition(__FUNCTION__, __LINE__, "array",
+		std::equal(a1, a1 + 10, a2));
+}
+
+static long generateRandomLong() {
+	return (long(std::rand()) << 33) ^ (long(std::rand()) << 2) ^ std::rand()
+		^ (std::rand() & 1 ? -1L : 0L);
+}
+
+static float generateRandomFloat() {
+	return float(generateRandomDouble()) * (std::rand() & 1 ? -1 : 1);
+}
+
+static int pair_first(const std::pair<int, int> &x) {
+	return x.first;
+}
+
+// Keys taken from the elements, equal keys have to stay in order
+void test_radix_sort() {
+	const std::size_t sizes[] = {10, 100, 100000};
+
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		std::vector<std::pair<int, int> > v1;
+		for (std::size_t i = 0; i < sizes[s]; i++) {
+			v1.push_back(std::make_pair(std::rand() % 1000 - 500, int(i)));
+		}
+		std::vector<std::pair<int, int> > v2(v1);
+		std::vector<std::pair<int, int> > v3(v1);
+		ft::radix_sort(v1.begin(), v1.end(), pair_first);
+		ft::parallel_radix_sort(v2.begin(), v2.end(), pair_first, 3);
+		std::stable_sort(v3.begin(), v3.end(), compare_first);
+		test_condition(__FUNCTION__, __LINE__, "stable", v1 == v3);
+		test_condition(__FUNCTION__, __LINE__, "parallel stable", v2 == v3);
+	}
+	double a[] = {3.5, -0.25, 1e300, -1e-300, 0.0, -7.0, 2.0};
+	double b[] = {3.5, -0.25, 1e300, -1e-300, 0.0, -7.0, 2.0};
+	ft::radix_sort(a, a + 7);
+	std::sort(b, b + 7);
+	test_condition(__FUNCTION__, __LINE__, "array", std::equal(a, a + 7, b));
+}
+
+struct increment {
+	void operator()(int &x) const {
+		x++;
+	}
+};
+
+struct twice {
+	long operator()(int x) const {
+		return 2L * x;
+	}
+};
+
+struct greater_than {
+	int value;
+
+	explicit greater_than(int v) : value(v) {}
+
+	bool operator()(int x) const {
+		return x > value;
+	}
+};
+
+static void count_task(void *counter) {
+	ft::atomic_fetch_add(static_cast<long *>(counter), 1L);
+}
+
+// Tasks submitted from outside the pool, run by the workers or by the thread
+// that waits for them
+void test_thread_pool() {
+	for (std::size_t workers = 0; workers < 4; workers++) {
+		ft::thread_pool pool(workers);
+		long            counter = 0;
+		for (int i = 0; i < 1000; i++) {
+			pool.submit(count_task, &counter);
+		}
+		while (ft::atomic_load(&counter) != 1000) {
+			pool.run_pending_task();
+		}
+		test_condition(__FUNCTION__, __LINE__, "size", pool.size() == workers);
+		test_condition(__FUNCTION__, __LINE__, "drained",
+			!pool.run_pending_task());
+	}
+}
+
+// Counts the runs of the task whose index arg points into taken
+static void mark_taken(void *arg) {
+	ft::atomic_fetch_add(static_cast<long *>(arg), 1L);
+}
+
+struct deque_thief {
+	ft::detail::work_stealing_deque *deque;
+	long                            *done;
+	long                             stolen;
+};
+
+static void *deque_thief_run(void *arg) {
+	deque_thief          *thief = static_cast<deque_thief *>(arg);
+	ft::detail::pool_task task;
+	while (ft::atomic_load(thief->done) == 0) {
+		if (thief->deque->steal(task)) {
+			task.run(task.arg);
+			thief->stolen++;
+		}
+	}
+	return NULL;
+}
+
+// The owner pushes and pops while three threads steal: every task has to be
+// run exactly once, across the growths of the array
+void test_work_stealing_deque() {
+	const int                       tasks = 100000;
+	const int                       threads = 3;
+	ft::detail::work_stealing_deque deque;
+	std::vector<long>               taken(tasks, 0);
+	long                            done = 0;
+	pthread_t                       ids[threads];
+	deque_thief                     thieves[threads];
+
+	for (int i = 0; i < threads; i++) {
+		deque_thief thief = {&deque, &done, 0};
+		thieves[i] = thief;
+		pthread_create(&ids[i], NULL, deque_thief_run, &thieves[i]);
+	}
+	ft::detail::pool_task task;
+	for (int i = 0; i < tasks; i++) {
+		ft::detail::pool_task pushed = {mark_taken, &taken[i]};
+		deque.push(pushed);
+		if (i % 3 == 0 && deque.pop(task)) {
+			task.run(task.arg);
+		}
+	}
+	while (deque.pop(task)) {
+		task.run(task.arg);
+	}
+	ft::atomic_store(&done, 1L);
+	for (int i = 0; i < threads; i++) {
+		pthread_join(ids[i], NULL);
+	}
+	test_condition(__FUNCTION__, __LINE__, "empty", deque.size() == 0);
+	test_values(__FUNCTION__, __LINE__, "run once",
+		std::count(taken.begin(), taken.end(), 1L), long(tasks));
+}
+
+// Pushes 0 to count - 1 one at a time and in batches of up to 7
+struct spsc_producer {
+	ft::spsc_queue<long> *queue;
+	long                  count;
+};
+
+static void *spsc_producer_run(void *arg) {
+	spsc_producer *producer = static_cast<spsc_producer *>(arg);
+	long           batch[7];
+
+	for (long i = 0; i < producer->count;) {
+		const long n = ft::min(i % 7 + 1, producer->count - i);
+		if (n == 1) {
+			producer->queue->push(i);
+		} else {
+			for (long j = 0; j < n; j++) {
+				batch[j] = i + j;
+			}
+			producer->queue->push_n(batch, n);
+		}
+		i += n;
+	}
+	return NULL;
+}
+
+// The consumer must see every value once and in order, popping one at a time
+// and in batches, while the producer wraps around a small queue
+// Throws when assigned to once marked broken, a destination to pop into
+struct assign_guard {
+	std::string value;
+	bool        broken;
+
+	assign_guard(const std::string &v = "", bool b = false)
+		: value(v), broken(b) {}
+	assign_guard(const assign_guard &x) : value(x.value), broken(false) {}
+	assign_guard &operator=(const assign_guard &x) {
+		if (broken) {
+			throw std::runtime_error("assign_guard");
+		}
+		value = x.value;
+		return *this;
+	}
+};
+
+void test_spsc_queue() {
+	const long           count = 200000;
+	ft::spsc_queue<long> queue(60);
+	spsc_producer        producer = {&queue, count};
+	pthread_t            id;
+	long                 batch[5];
+	long                 expected = 0;
+	bool                 ordered = true;
+	ft::backoff          waiting;
+
+	test_values(__FUNCTION__, __LINE__, "capacity", queue.capacity(),
+		std::size_t(64));
+	pthread_create(&id, NULL, spsc_producer_run, &producer);
+	while (expected < count) {
+		long       value;
+		const long before = expected;
+		if (expected % 2 == 0) {
+			if (queue.try_pop(value)) {
+				ordered = ordered && value == expected++;
+			}
+		} else {
+			const std::size_t n = queue.try_pop_n(batch, 5);
+			for (std::size_t i = 0; i < n; i++) {
+				ordered = ordered && batch[i] == expected++;
+			}
+		}
+		if (expected == before) {
+			waiting.wait();
+		}
+	}
+	pthread_join(id, NULL);
+	test_condition(__FUNCTION__, __LINE__, "in order", ordered);
+	test_condition(__FUNCTION__, __LINE__, "empty", queue.empty());
+
+	ft::spsc_queue<std::string> strings(4);
+	const std::string           words[] = {"a", "b", "c", "d", "e"};
+	test_values(__FUNCTION__, __LINE__, "try_push_n",
+		strings.try_push_n(words, 5), std::size_t(4));
+	test_condition(__FUNCTION__, __LINE__, "full",
+		!strings.try_push(words[4]) && strings.size() == 4);
+	std::string word;
+	strings.pop(word);
+	test_values(__FUNCTION__, __LINE__, "pop", word, std::string("a"));
+	test_condition(__FUNCTION__, __LINE__, "push after pop",
+		strings.try_push(words[4]));
+
+	// A throwing assignment keeps what was popped before it popped
+	ft::spsc_queue<assign_guard> guards(4);
+	assign_guard                 out[3];
+	for (int i = 0; i < 4; i++) {
+		guards.push(assign_guard(std::string(40, 'a' + i)));
+	}
+	out[2].broken = true;
+	try {
+		guards.try_pop_n(out, 3);
+		test_condition(__FUNCTION__, __LINE__, "throwing pop_n", false);
+	} catch (std::runtime_error &) {
+	}
+	test_values(__FUNCTION__, __LINE__, "size after throw", guards.size(),
+		std::size_t(2));
+	guards.pop(out[0]);
+	test_values(__FUNCTION__, __LINE__, "pop after throw", out[0].value,
+		std::string(40, 'c'));
+	// Rounding the capacity up must not wrap around to zero
+	bool threw = false;
+	try {
+		ft::spsc_queue<long> huge(std::size_t(-1));
+	} catch (const std::length_error &) {
+		threw = true;
+	}
+	test_condition(__FUNCTION__, __LINE__, "huge capacity", threw);
+}
+
+// Pushes producer * count + i for i in [0, count), half of them in batches
+struct mpmc_producer {
+	ft::mpmc_queue<long> *queue;
+	long                  producer;
+	long                  count;
+};
+
+static void *mpmc_producer_run(void *arg) {
+	mpmc_producer *p = static_cast<mpmc_producer *>(arg);
+	long           batch[4];
+
+	for (long i = 0; i < p->count; i++) {
+		const long value = p->producer * p->count + i;
+		if (i % 8 < 4) {
+			p->queue->push(value);
+		} else {
+			batch[i % 4] = value;
+			if (i % 4 == 3) {
+				p->queue->push_n(batch, 4);
+			}
+		}
+	}
+	return NULL;
+}
+
+// Pops until every value is taken, checking that the values of each producer
+// come out in the order they were pushed
+struct mpmc_consumer {
+	ft::mpmc_queue<long> *queue;
+	long                 *taken;
+	long                 *remaining;
+	long                  producers;
+	long                  count;
+	bool                  ordered;
+};
+
+static void *mpmc_consumer_run(void *arg) {
+	mpmc_consumer    *c = static_cast<mpmc_consumer *>(arg);
+	std::vector<long> last(c->producers, -1);
+	long              batch[3];
+	ft::backoff       waiting;
+
+	while (ft::atomic_load(c->remaining) > 0) {
+		const std::size_t n = c->queue->try_pop_n(batch, 3);
+		if (n == 0) {
+			waiting.wait();
+			continue;
+		}
+		waiting.reset();
+		for (std::size_t i = 0; i < n; i++) {
+			const long producer = batch[i] / c->count;
+			c->ordered = c->ordered && batch[i] > last[producer];
+			last[producer] = batch[i];
+			ft::atomic_fetch_add(&c->taken[batch[i]], 1L);
+		}
+		ft::atomic_fetch_sub(c->remaining, long(n));
+	}
+	return NULL;
+}
+
+void test_mpmc_queue() {
+	const long           threads = 4;
+	const long           count = 40000;
+	ft::mpmc_queue<long> queue(100);
+	std::vector<long>    taken(threads * count, 0);
+	long                 remaining = threads * count;
+	pthread_t            producer_ids[threads];
+	pthread_t            consumer_ids[threads];
+	mpmc_producer        producers[threads];
+	mpmc_consumer        consumers[threads];
+
+	test_values(__FUNCTION__, __LINE__, "capacity", queue.capacity(),
+		std::size_t(128));
+	for (long i = 0; i < threads; i++) {
+		mpmc_consumer consumer = {
+			&queue, &taken[0], &remaining, threads, count, true};
+		consumers[i] = consumer;
+		pthread_create(
+			&consumer_ids[i], NULL, mpmc_consumer_run, &consumers[i]);
+	}
+	for (long i = 0; i < threads; i++) {
+		mpmc_producer producer = {&queue, i, count};
+		producers[i] = producer;
+		pthread_create(
+			&producer_ids[i], NULL, mpmc_producer_run, &producers[i]);
+	}
+	bool ordered = true;
+	for (long i = 0; i < threads; i++) {
+		pthread_join(producer_ids[i], NULL);
+		pthread_join(consumer_ids[i], NULL);
+		ordered = ordered && consumers[i].ordered;
+	}
+	test_condition(__FUNCTION__, __LINE__, "per producer order", ordered);
+	test_values(__FUNCTION__, __LINE__, "taken once",
+		std::count(taken.begin(), taken.end(), 1L), threads * count);
+	test_condition(__FUNCTION__, __LINE__, "empty", queue.empty());
+
+	ft::mpmc_queue<std::string> strings(3);
+	const std::string           words[] = {"a", "b", "c", "d", "e"};
+	test_values(__FUNCTION__, __LINE__, "try_push_n",
+		strings.try_push_n(words, 5), std::size_t(4));
+	test_condition(__FUNCTION__, __LINE__, "full",
+		!strings.try_push(words[4]) && strings.size() == 4);
+	std::string out[2];
+	test_values(__FUNCTION__, __LINE__, "try_pop_n",
+		strings.try_pop_n(out, 2), std::size_t(2));
+	test_condition(__FUNCTION__, __LINE__, "fifo",
+		out[0] == "a" && out[1] == "b" && strings.try_pop(out[0])
+			&& out[0] == "c");
+	// Rounding the capacity up must not wrap around to zero
+	bool threw = false;
+	try {
+		ft::mpmc_queue<long> huge(std::size_t(-1));
+	} catch (const std::length_error &) {
+		threw = true;
+	}
+	test_condition(__FUNCTION__, __LINE__, "huge capacity", threw);
+}
+
+static long fibonacci(int n) {
+	return n < 2 ? n : fibonacci(n - 1) + fibonacci(n - 2);
+}
+
+// Fork-join recursion, each call submits one half to a task group and
+// computes the other while the workers steal
+struct fibonacci_task {
+	ft::thread_pool *pool;
+	int              n;
+	long            *result;
+
+	void operator()() const {
+		if (n < 12) {
+			*result = fibonacci(n);
+			return;
+		}
+		long           a;
+		long           b;
+		fibonacci_task left = {pool, n - 1, &a};
+		fibonacci_task right = {pool, n - 2, &b};
+		ft::task_group group(*pool);
+		group.submit(left);
+		right();
+		group.wait();
+		*result = a + b;
+	}
+};
+
+struct store_value {
+	long *slot;
+	long  value;
+
+	void operator()() const {
+		*slot = value;
+	}
+};
+
+struct throw_error {
+	void operator()() const {
+		throw std::logic_error("task");
+	}
+};
+
+// Nested groups on pools of every size, pinned or not, parallel_invoke and
+// the exceptions thrown by tasks
+void test_task_group() {
+	for (std::size_t workers = 0; workers < 4; workers++) {
+		ft::thread_pool pool(workers, workers % 2 == 1);
+		long            result = 0;
+		fibonacci_task  task = {&pool, 24, &result};
+		{
+			ft::task_group group(pool);
+			group.submit(task);
+			group.wait();
+		}
+		test_values(__FUNCTION__, __LINE__, "fork-join", result,
+			fibonacci(24));
+		ft::task_group group(pool);
+		group.submit(throw_error());
+		group.submit(task);
+		try {
+			group.wait();
+			test_condition(__FUNCTION__, __LINE__, "exception", false);
+		} catch (std::runtime_error &) {
+		}
+		group.wait();
+	}
+	long        slots[4] = {0, 0, 0, 0};
+	store_value f1 = {&slots[0], 1};
+	store_value f2 = {&slots[1], 2};
+	store_value f3 = {&slots[2], 3};
+	store_value f4 = {&slots[3], 4};
+	ft::parallel_invoke(f1, f2);
+	test_condition(__FUNCTION__, __LINE__, "parallel_invoke",
+		slots[0] == 1 && slots[1] == 2 && slots[2] == 0);
+	ft::parallel_invoke(f1, f2, f3, f4);
+	test_condition(__FUNCTION__, __LINE__, "parallel_invoke",
+		slots[2] == 3 && slots[3] == 4);
+}
+
+// The parallel overloads on a pool of three workers, with chunks small
+// enough that every range is cut into many tasks, against the sequential
+// std algorithms
+void test_parallel_algorithms() {
+	ft::thread_pool           pool(3);
+	const ft::parallel_policy policy = ft::par.on(pool).with_grain(1000);
+	const std::size_t         sizes[] = {0, 1, 999, 1000, 1001, 100000};
+
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+		const std::size_t n = sizes[s];
+		std::vector<int>  v1(n);
+		for (std::size_t i = 0; i < n; i++) {
+			v1[i] = std::rand() % 100000;
+		}
+		ft::vector<int> v2(v1.begin(), v1.end());
+
+		std::for_each(v1.begin(), v1.end(), increment());
+		ft::for_each(policy, v2.begin(), v2.end(), increment());
+		test_condition(__FUNCTION__, __LINE__, "for_each",
+			std::equal(v1.begin(), v1.end(), v2.begin()));
+
+		std::vector<long> t1(n);
+		ft::vector<long>  t2(n);
+		std::transform(v1.begin(), v1.end(), t1.begin(), twice());
+		test_condition(__FUNCTION__, __LINE__, "transform",
+			ft::transform(policy, v2.begin(), v2.end(), t2.begin(), twice())
+				== t2.end());
+		test_condition(__FUNCTION__, __LINE__, "transform",
+			std::equal(t1.begin(), t1.end(), t2.begin()));
+
+		long sum = 0;
+		for (std::size_t i = 0; i < n; i++) {
+			sum += t1[i];
+		}
+		test_values(__FUNCTION__, __LINE__, "reduce",
+			ft::reduce(policy, t2.begin(), t2.end(), 5L), sum + 5);
+
+		ft::vector<int> c(n);
+		ft::copy(policy, v2.begin(), v2.end(), c.begin());
+		test_condition(__FUNCTION__, __LINE__, "copy", c == v2);
+		ft::fill(policy, c.begin(), c.end(), 7);
+		test_condition(__FUNCTION__, __LINE__, "fill",
+			std::count(c.begin(), c.end(), 7) == long(n));
+
+		for (int threshold = 99000; threshold <= 100001; threshold += 1000) {
+			test_values(__FUNCTION__, __LINE__, "find_if",
+				ft::find_if(policy, v2.begin(), v2.end(),
+					greater_than(threshold))
+					- v2.begin(),
+				std::find_if(v1.begin(), v1.end(), greater_than(threshold))
+					- v1.begin());
+		}
+
+		std::sort(v1.begin(), v1.end());
+		ft::sort(policy, v2.begin(), v2.end());
+		test_condition(__FUNCTION__, __LINE__, "sort",
+			std::equal(v1.begin(), v1.end(), v2.begin()));
+		std::vector<std::string> s1(n / 10);
+		for (std::size_t i = 0; i < s1.size(); i++) {
+			s1[i] = generateRandomString();
+		}
+		ft::vector<std::string> s2(s1.begin(), s1.end());
+		std::sort(s1.begin(), s1.end(), std::greater<std::string>());
+		ft::sort(ft::par.on(pool).with_grain(100), s2.begin(), s2.end(),
+			std::greater<std::string>());
+		test_condition(__FUNCTION__, __LINE__, "sort strings",
+			std::equal(s1.begin(), s1.end(), s2.begin()));
+	}
+	// Long strings, empty once moved from, merged by many chunks at once
+	std::vector<std::string> s1(20000);
+	for (std::size_t i = 0; i < s1.size(); i++) {
+		s1[i] = std::string(32, 'x') + generateRandomString();
+	}
+	ft::vector<std::string> s2(s1.begin(), s1.end());
+	std::sort(s1.begin(), s1.end());
+	ft::sort(ft::par.on(pool).with_grain(64), s2.begin(), s2.end());
+	test_condition(__FUNCTION__, __LINE__, "sort long strings",
+		std::equal(s1.begin(), s1.end(), s2.begin()));
+	// The default pool and grain
+	ft::vector<int> v(300000, 1);
+	test_values(__FUNCTION__, __LINE__, "default pool",
+		ft::reduce(ft::par, v.begin(), v.end(), 0), 300000);
+}
+
+void test_algorithm() {
+	test_condition(__FUNCTION__, __LINE__, "int trivially copyable",
+		ft::is_trivially_copyable<int>::value);
+	test_condition(__FUNCTION__, __LINE__, "pair trivially copyable",
+		ft::is_trivially_copyable<ft::pair<int, double> >::value);
+	test_condition(__FUNCTION__, __LINE__, "string not trivially copyable",
+		!ft::is_trivially_copyable<std::string>::value);
+	test_condition(__FUNCTION__, __LINE__, "int trivially destructible",
+		ft::is_trivially_destructible<int>::value);
+	test_condition(__FUNCTION__, __LINE__, "string not trivially destructible",
+		!ft::is_trivially_destructible<std::string>::value);
+	test_overlapping_copies(int(), std::rand, __FUNCTION__, __LINE__);
+	test_overlapping_copies(char(), generateRandomChar, __FUNCTION__, __LINE__);
+	test_overlapping_copies(
+		std::string(), generateRandomString, __FUNCTION__, __LINE__);
+	test_vectorized_ranges(int(), std::rand, __FUNCTION__, __LINE__);
+	test_vectorized_ranges(char(), generateRandomChar, __FUNCTION__, __LINE__);
+	test_vectorized_ranges(
+		(signed char)0, generateRandomSignedChar, __FUNCTION__, __LINE__);
+	test_vectorized_ranges(
+		short(), generateRandomShort, __FUNCTION__, __LINE__);
+	test_vectorized_ranges(
+		double(), generateRandomDouble, __FUNCTION__, __LINE__);
+	test_vectorized_ranges(
+		std::string(), generateRandomString, __FUNCTION__, __LINE__);
+	test_sorting(int(), std::rand, __FUNCTION__, __LINE__);
+	test_sorting(double(), generateRandomDouble, __FUNCTION__, __LINE__);
+	test_sorting(std::string(), generateRandomString, __FUNCTION__, __LINE__);
+	test_stable_sort();
+	test_radix_sorting(int(), std::rand, __FUNCTION__, __LINE__);
+	test_radix_sorting(
+		(signed char)0, generateRandomSignedChar, __FUNCTION__, __LINE__);
+	test_radix_sorting(short(), generateRandomShort, __FUNCTION__, __LINE__);
+	test_radix_sorting(long(), generateRandomLong, __FUNCTION__, __LINE__);
+	test_radix_sorting(
+		double(), generateRandomDouble, __FUNCTION__, __LINE__);
+	test_radix_sorting(float(), generateRandomFloat, __FUNCTION__, __LINE__);
+	test_radix_sort();
+}
+
+int main() {
+	std::srand(std::time(NULL));
+	std::clock_t start_time = std::clock();
+	test_algorithm();
+	test_thread_pool();
+	test_work_stealing_deque();
+	test_spsc_queue();
+	test_mpmc_queue();
+	test_task_group();
+	test_parallel_algorithms();
+	test_vector();
+	test_vector_bool();
+	test_vector_growth();
+	test_malloc_allocator();
+	test_mmap_allocator();
+	test_mmap_vector();
+	test_small_vector();
+	test_soa_vector();
+#if __cplusplus >= 201103L
+	test_move_semantics();
+#endif
+	test_list();
+	test_deque();
+	test_ring_buffer();
+	test_queue();
+	test_stack();
+	test_map();
+	test_set();
+	test_multiset();
+	test_multimap();
+	test_small_map();
+	test_splay_map();
+	test_skiplist_map();
+#ifdef FT_BST_STATS
+	test_map_stats();
+#endif
 	std::clock_t end_time = std::clock();
 	if (g_errors) {
 		std::cout << g_errors << " errors\n";
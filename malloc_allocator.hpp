@@ -0,0 +1,194 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(__linux__)
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+
+// An allocator on top of malloc that can also grow a block in place with
+// reallocate(). On Linux blocks of mmap_threshold bytes and more are mapped
+// directly and grown with mremap, which moves pages instead of copying them
+// and never needs the old and the new block at the same time.
+template <class T>
+class malloc_allocator {
+  public:
+	typedef T              *pointer;
+	typedef const T        *const_pointer;
+	typedef T              &reference;
+	typedef const T        &const_reference;
+	typedef T               value_type;
+	typedef std::size_t     size_type;
+	typedef std::ptrdiff_t  difference_type;
+
+	template <class U>
+	struct rebind {
+		typedef malloc_allocator<U> other;
+	};
+
+	static const size_type mmap_threshold = 1024 * 1024;
+
+	malloc_allocator() {}
+	template <class U>
+	malloc_allocator(const malloc_allocator<U> &) {}
+
+	pointer address(reference x) const {
+		return &x;
+	}
+
+	const_pointer address(const_reference x) const {
+		return &x;
+	}
+
+	pointer allocate(size_type n, const void * = 0) {
+		if (n == 0) {
+			return 0;
+		}
+		if (n > max_size()) {
+			throw std::bad_alloc();
+		}
+		void *p = m_is_mapped(n) ? m_map(m_bytes(n))
+								 : std::malloc(n * sizeof(T));
+		if (p == NULL) {
+			throw std::bad_alloc();
+		}
+		return static_cast<pointer>(p);
+	}
+
+	void deallocate(pointer p, size_type n) {
+		if (p == NULL) {
+			return;
+		}
+		if (m_is_mapped(n)) {
+			m_unmap(p, m_bytes(n));
+		} else {
+			std::free(p);
+		}
+	}
+
+	// Resizes the block p of n elements to new_n elements, keeping the
+	// first min(n, new_n) of them. The contents are moved bitwise, so the
+	// elements must be trivially relocatable. p is invalid afterwards,
+	// unless an exception is thrown.
+	pointer reallocate(pointer p, size_type n, size_type new_n) {
+		if (p == NULL) {
+			return allocate(new_n);
+		}
+		if (new_n == 0) {
+			deallocate(p, n);
+			return 0;
+		}
+		if (new_n > max_size()) {
+			throw std::bad_alloc();
+		}
+		void *q = NULL;
+		void *block = p;
+		if (!m_is_mapped(n) && !m_is_mapped(new_n)) {
+			q = std::realloc(block, new_n * sizeof(T));
+#if defined(__linux__)
+		} else if (m_is_mapped(n) && m_is_mapped(new_n)) {
+			q = mremap(block, m_bytes(n), m_bytes(new_n), MREMAP_MAYMOVE);
+			q = q == MAP_FAILED ? NULL : q;
+#endif
+		} else {
+			// Crossing the threshold, between the heap and a mapping
+			q = allocate(new_n);
+			std::memcpy(q, block, (n < new_n ? n : new_n) * sizeof(T));
+			deallocate(p, n);
+		}
+		if (q == NULL) {
+			throw std::bad_alloc();
+		}
+		return static_cast<pointer>(q);
+	}
+
+	size_type max_size() const {
+		return static_cast<size_type>(-1) / sizeof(T);
+	}
+
+	void construct(pointer p, const T &value) {
+		new (static_cast<void *>(p)) T(value);
+	}
+
+#if __cplusplus >= 201103L
+	template <class U, class... Args>
+	void construct(U *p, Args &&...args) {
+		new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+	}
+#endif
+
+	void destroy(pointer p) {
+		p->~T();
+	}
+
+  private:
+	// Whether a block of n elements is mapped rather than malloced, the
+	// size passed to deallocate() decides
+	static bool m_is_mapped(size_type n) {
+#if defined(__linux__)
+		return n * sizeof(T) >= mmap_threshold;
+#else
+		(void)n;
+		return false;
+#endif
+	}
+
+	// Bytes mapped for n elements, whole pages
+	static std::size_t m_bytes(size_type n) {
+#if defined(__linux__)
+		static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+		return (n * sizeof(T) + page_size - 1) / page_size * page_size;
+#else
+		return n * sizeof(T);
+#endif
+	}
+
+	static void *m_map(std::size_t bytes) {
+#if defined(__linux__)
+		void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return p == MAP_FAILED ? NULL : p;
+#else
+		return std::malloc(bytes);
+#endif
+	}
+
+	static void m_unmap(void *p, std::size_t bytes) {
+#if defined(__linux__)
+		munmap(p, bytes);
+#else
+		(void)bytes;
+		std::free(p);
+#endif
+	}
+};
+
+template <class T, class U>
+bool operator==(const malloc_allocator<T> &, const malloc_allocator<U> &) {
+	return true;
+}
+
+template <class T, class U>
+bool operator!=(const malloc_allocator<T> &, const malloc_allocator<U> &) {
+	return false;
+}
+
+namespace detail {
+
+// Constructs with placement new and destroys with the destructor, exactly
+// like std::allocator, so the bitwise fast paths apply
+template <class T>
+struct is_std_allocator<malloc_allocator<T> > : public true_type {};
+
+template <class T>
+struct has_reallocate<malloc_allocator<T> > : public true_type {};
+
+}  // namespace detail
+
+}  // namespace ft
@@ -1,44 +1,220 @@
 #pragma once
 #include <memory>
+#include <new>
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
 
 namespace ft {
 
-// Copies an object to an uninitialized area of memory,
-// defined by a range
+// std::allocator holds no state
+template <class T>
+struct is_trivially_relocatable<std::allocator<T> > : public true_type {};
+
+namespace detail {
+
+// std::allocator constructs with placement new and destroys by calling the
+// destructor, so for trivial types it can be bypassed with raw memory
+// operations. Other allocators may do more and always go through construct.
+template <class Allocator>
+struct is_std_allocator : public false_type {};
+
+template <class T>
+struct is_std_allocator<std::allocator<T> > : public true_type {};
+
+// Allocators that can resize a block with reallocate(p, n, new_n), moving
+// its contents bitwise, see malloc_allocator
+template <class Allocator>
+struct has_reallocate : public false_type {};
+
+// A vector of T can grow through Allocator::reallocate
+template <class T, class Allocator>
+struct is_reallocatable
+	: public integral_constant<bool,
+		  is_trivially_relocatable<T>::value
+			  && has_reallocate<Allocator>::value> {};
+
+template <class ForwardIt, class Allocator>
+struct is_bitwise_fillable : public false_type {};
+
+template <class T, class Allocator>
+struct is_bitwise_fillable<T *, Allocator>
+	: public integral_constant<bool,
+		  is_trivially_copyable<T>::value
+			  && is_std_allocator<Allocator>::value> {};
+
+template <class InputIt, class ForwardIt, class Allocator>
+struct is_bitwise_constructible
+	: public integral_constant<bool,
+		  is_bitwise_copyable<InputIt, ForwardIt>::value
+			  && is_std_allocator<Allocator>::value> {};
+
+template <class ForwardIt, class Allocator>
+struct is_trivially_default_initializable : public false_type {};
+
+template <class T, class Allocator>
+struct is_trivially_default_initializable<T *, Allocator>
+	: public integral_constant<bool,
+		  is_trivially_default_constructible<T>::value
+			  && is_std_allocator<Allocator>::value> {};
+
+template <class ForwardIt, class Allocator>
+struct is_trivially_destroyable : public false_type {};
+
+template <class T, class Allocator>
+struct is_trivially_destroyable<T *, Allocator>
+	: public integral_constant<bool,
+		  is_trivially_destructible<T>::value
+			  && is_std_allocator<Allocator>::value> {};
+
 template <class ForwardIt, class T, class Allocator>
-void uninitialized_fill(
-	ForwardIt first, ForwardIt last, const T &value, Allocator allocator) {
+void uninitialized_fill(ForwardIt first, ForwardIt last, const T &value,
+	Allocator allocator, false_type) {
 	while (first != last) {
 		allocator.construct(&*first++, value);
 	}
 }
 
-// Copies an object to an uninitialized area of memory,
-// defined by a start
+template <class ForwardIt, class T, class Allocator>
+void uninitialized_fill(
+	ForwardIt first, ForwardIt last, const T &value, Allocator, true_type) {
+	ft::fill(first, last, value);
+}
+
 template <class ForwardIt, class Size, class T, class Allocator>
-void uninitialized_fill_n(
-	ForwardIt first, Size n, const T &value, Allocator allocator) {
+void uninitialized_fill_n(ForwardIt first, Size n, const T &value,
+	Allocator allocator, false_type) {
 	while (n--) {
 		allocator.construct(&*first++, value);
 	}
 }
 
-// Copies a range of objects to an uninitialized area of memory
+template <class ForwardIt, class Size, class T, class Allocator>
+void uninitialized_fill_n(
+	ForwardIt first, Size n, const T &value, Allocator, true_type) {
+	ft::fill_n(first, n, value);
+}
+
 template <class InputIt, class ForwardIt, class Allocator>
-ForwardIt uninitialized_copy(
-	InputIt first, InputIt last, ForwardIt d_first, Allocator allocator) {
+ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first,
+	Allocator allocator, false_type) {
+	while (first != last) {
+		allocator.construct(&*d_first++, *first++);
+	}
+	return d_first;
+}
+
+template <class InputIt, class ForwardIt, class Allocator>
+ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first,
+	Allocator, true_type) {
+	return ft::copy(first, last, d_first);
+}
+
+template <class InputIt, class ForwardIt, class Allocator>
+ForwardIt uninitialized_move_if_noexcept(InputIt first, InputIt last,
+	ForwardIt d_first, Allocator allocator, false_type) {
 	while (first != last) {
+#if __cplusplus >= 201103L
+		allocator.construct(&*d_first++, std::move_if_noexcept(*first++));
+#else
 		allocator.construct(&*d_first++, *first++);
+#endif
 	}
 	return d_first;
 }
 
-// Destroys a range of objects
+template <class InputIt, class ForwardIt, class Allocator>
+ForwardIt uninitialized_move_if_noexcept(InputIt first, InputIt last,
+	ForwardIt d_first, Allocator, true_type) {
+	return ft::copy(first, last, d_first);
+}
+
+// Allocator::construct only copies, the default constructor is called in
+// place instead of copying a temporary
 template <class ForwardIt, class Allocator>
-void destroy(ForwardIt first, ForwardIt last, Allocator allocator) {
+void uninitialized_default_construct(
+	ForwardIt first, ForwardIt last, Allocator, false_type) {
+	typedef typename ft::iterator_traits<ForwardIt>::value_type value_type;
+	while (first != last) {
+		new (static_cast<void *>(&*first++)) value_type;
+	}
+}
+
+template <class ForwardIt, class Allocator>
+void uninitialized_default_construct(
+	ForwardIt, ForwardIt, Allocator, true_type) {}
+
+template <class ForwardIt, class Allocator>
+void destroy(ForwardIt first, ForwardIt last, Allocator allocator, false_type) {
 	while (first != last) {
 		allocator.destroy(first++);
 	}
 }
 
+template <class ForwardIt, class Allocator>
+void destroy(ForwardIt, ForwardIt, Allocator, true_type) {}
+
+}  // namespace detail
+
+// Copies an object to an uninitialized area of memory,
+// defined by a range
+template <class ForwardIt, class T, class Allocator>
+void uninitialized_fill(
+	ForwardIt first, ForwardIt last, const T &value, Allocator allocator) {
+	detail::uninitialized_fill(first, last, value, allocator,
+		typename detail::is_bitwise_fillable<ForwardIt, Allocator>::type());
+}
+
+// Copies an object to an uninitialized area of memory,
+// defined by a start
+template <class ForwardIt, class Size, class T, class Allocator>
+void uninitialized_fill_n(
+	ForwardIt first, Size n, const T &value, Allocator allocator) {
+	detail::uninitialized_fill_n(first, n, value, allocator,
+		typename detail::is_bitwise_fillable<ForwardIt, Allocator>::type());
+}
+
+// Copies a range of objects to an uninitialized area of memory,
+// memmove for pointers to trivially copyable types
+template <class InputIt, class ForwardIt, class Allocator>
+ForwardIt uninitialized_copy(
+	InputIt first, InputIt last, ForwardIt d_first, Allocator allocator) {
+	return detail::uninitialized_copy(first, last, d_first, allocator,
+		typename detail::is_bitwise_constructible<InputIt, ForwardIt,
+			Allocator>::type());
+}
+
+// Moves a range of objects to an uninitialized area of memory when their move
+// constructor cannot throw, copies them otherwise so that a throwing copy
+// leaves the source intact. Always copies in C++98.
+template <class InputIt, class ForwardIt, class Allocator>
+ForwardIt uninitialized_move_if_noexcept(
+	InputIt first, InputIt last, ForwardIt d_first, Allocator allocator) {
+	return detail::uninitialized_move_if_noexcept(first, last, d_first,
+		allocator,
+		typename detail::is_bitwise_constructible<InputIt, ForwardIt,
+			Allocator>::type());
+}
+
+// Default initializes a range of objects in an uninitialized area of memory,
+// which leaves types with a trivial default constructor untouched
+template <class ForwardIt, class Allocator>
+void uninitialized_default_construct(
+	ForwardIt first, ForwardIt last, Allocator allocator) {
+	detail::uninitialized_default_construct(first, last, allocator,
+		typename detail::is_trivially_default_initializable<ForwardIt,
+			Allocator>::type());
+}
+
+// Destroys a range of objects, nothing to do for trivially destructible ones
+template <class ForwardIt, class Allocator>
+void destroy(ForwardIt first, ForwardIt last, Allocator allocator) {
+	detail::destroy(first, last, allocator,
+		typename detail::is_trivially_destroyable<ForwardIt,
+			Allocator>::type());
+}
+
 }  // namespace ft
@@ -0,0 +1,220 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(__linux__)
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+#include "memory.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+
+enum mmap_allocator_flags {
+	// madvise(MADV_HUGEPAGE), transparent huge pages for the mapping
+	mmap_huge_pages = 1,
+	// MAP_HUGETLB, pages from the reserved hugetlbfs pool. Falls back to a
+	// regular mapping when the pool cannot serve the request.
+	mmap_hugetlb = 2,
+	// Fault every page in when the block is allocated, like MAP_POPULATE
+	mmap_populate = 4
+};
+
+// An allocator for large buffers: blocks of threshold bytes and more are
+// anonymous mappings aligned to and sized in huge pages, so that random
+// accesses over them miss the TLB far less often; smaller ones come from
+// malloc. The flags are a combination of mmap_allocator_flags.
+template <class T>
+class mmap_allocator {
+  public:
+	typedef T              *pointer;
+	typedef const T        *const_pointer;
+	typedef T              &reference;
+	typedef const T        &const_reference;
+	typedef T               value_type;
+	typedef std::size_t     size_type;
+	typedef std::ptrdiff_t  difference_type;
+
+	template <class U>
+	struct rebind {
+		typedef mmap_allocator<U> other;
+	};
+
+	static const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+	explicit mmap_allocator(
+		unsigned flags = mmap_huge_pages, size_type threshold = huge_page_size)
+		: m_flags(flags), m_threshold(threshold) {}
+	template <class U>
+	mmap_allocator(const mmap_allocator<U> &x)
+		: m_flags(x.flags()), m_threshold(x.threshold()) {}
+
+	unsigned flags() const {
+		return m_flags;
+	}
+
+	// Smallest block in bytes that is mapped rather than malloced
+	size_type threshold() const {
+		return m_threshold;
+	}
+
+	pointer address(reference x) const {
+		return &x;
+	}
+
+	const_pointer address(const_reference x) const {
+		return &x;
+	}
+
+	pointer allocate(size_type n, const void * = 0) {
+		if (n == 0) {
+			return 0;
+		}
+		if (n > max_size()) {
+			throw std::bad_alloc();
+		}
+		void *p = m_is_mapped(n) ? m_map(m_bytes(n))
+								 : std::malloc(n * sizeof(T));
+		if (p == NULL) {
+			throw std::bad_alloc();
+		}
+		return static_cast<pointer>(p);
+	}
+
+	void deallocate(pointer p, size_type n) {
+		if (p == NULL) {
+			return;
+		}
+		if (m_is_mapped(n)) {
+#if defined(__linux__)
+			munmap(p, m_bytes(n));
+#endif
+		} else {
+			std::free(p);
+		}
+	}
+
+	size_type max_size() const {
+		return (static_cast<size_type>(-1) - huge_page_size) / sizeof(T);
+	}
+
+	void construct(pointer p, const T &value) {
+		new (static_cast<void *>(p)) T(value);
+	}
+
+#if __cplusplus >= 201103L
+	template <class U, class... Args>
+	void construct(U *p, Args &&...args) {
+		new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+	}
+#endif
+
+	void destroy(pointer p) {
+		p->~T();
+	}
+
+  private:
+	unsigned  m_flags;
+	size_type m_threshold;
+
+	// Whether a block of n elements is mapped rather than malloced, the
+	// size passed to deallocate() decides
+	bool m_is_mapped(size_type n) const {
+#if defined(__linux__)
+		return n * sizeof(T) >= m_threshold;
+#else
+		(void)n;
+		return false;
+#endif
+	}
+
+	// Bytes mapped for n elements, whole huge pages
+	static std::size_t m_bytes(size_type n) {
+		return (n * sizeof(T) + huge_page_size - 1) / huge_page_size
+			* huge_page_size;
+	}
+
+#if defined(__linux__)
+	void *m_map(std::size_t bytes) const {
+		const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#	if defined(MAP_HUGETLB)
+		if (m_flags & mmap_hugetlb) {
+			const int populate = (m_flags & mmap_populate) ? MAP_POPULATE : 0;
+			void     *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+					flags | MAP_HUGETLB | populate, -1, 0);
+			if (p != MAP_FAILED) {
+				return p;
+			}
+		}
+#	endif
+		// Maps a huge page more than needed and trims both ends, so that
+		// the block starts on a huge page boundary
+		char *p = static_cast<char *>(mmap(NULL, bytes + huge_page_size,
+			PROT_READ | PROT_WRITE, flags, -1, 0));
+		if (p == MAP_FAILED) {
+			return NULL;
+		}
+		const std::size_t head =
+			(huge_page_size
+				- reinterpret_cast<std::size_t>(p) % huge_page_size)
+			% huge_page_size;
+		if (head != 0) {
+			munmap(p, head);
+		}
+		munmap(p + head + bytes, huge_page_size - head);
+		p += head;
+#	if defined(MADV_HUGEPAGE)
+		if (m_flags & mmap_huge_pages) {
+			madvise(p, bytes, MADV_HUGEPAGE);
+		}
+#	endif
+		// Faulted in after madvise, so that the faults take huge pages
+		if (m_flags & mmap_populate) {
+			m_populate(p, bytes);
+		}
+		return p;
+	}
+
+	static void m_populate(char *p, std::size_t bytes) {
+#	if defined(MADV_POPULATE_WRITE)
+		if (madvise(p, bytes, MADV_POPULATE_WRITE) == 0) {
+			return;
+		}
+#	endif
+		static const std::size_t page_size = sysconf(_SC_PAGESIZE);
+		for (std::size_t i = 0; i < bytes; i += page_size) {
+			p[i] = 0;
+		}
+	}
+#else
+	void *m_map(std::size_t bytes) const {
+		return std::malloc(bytes);
+	}
+#endif
+};
+
+template <class T, class U>
+bool operator==(const mmap_allocator<T> &x, const mmap_allocator<U> &y) {
+	return x.flags() == y.flags() && x.threshold() == y.threshold();
+}
+
+template <class T, class U>
+bool operator!=(const mmap_allocator<T> &x, const mmap_allocator<U> &y) {
+	return !(x == y);
+}
+
+// Only holds its options
+template <class T>
+struct is_trivially_relocatable<mmap_allocator<T> > : public true_type {};
+
+namespace detail {
+
+// Constructs with placement new and destroys with the destructor, exactly
+// like std::allocator, so the bitwise fast paths apply
+template <class T>
+struct is_std_allocator<mmap_allocator<T> > : public true_type {};
+
+}  // namespace detail
+
+}  // namespace ft
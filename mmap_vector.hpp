@@ -0,0 +1,351 @@
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+enum mmap_vector_mode {
+	// PROT_READ of a shared mapping, the file cannot be changed
+	mmap_read_only,
+	// A private mapping: the elements can be written, the file is left
+	// as it is and pages are copied as they are first written
+	mmap_copy_on_write,
+	// A shared mapping of a file opened or created for writing, changes
+	// and appended elements go to the file
+	mmap_read_write
+};
+
+// An array of T stored in a file and mapped into memory, with the read
+// interface of ft::vector. Opening it maps the file and reads nothing: the
+// pages are loaded as they are first accessed. T must be trivially copyable,
+// the file holds the bytes of the elements one after the other.
+//
+// In mmap_read_write mode push_back() grows the file with ftruncate and
+// remaps it, by doubling like ft::vector. The file is cut back to the
+// elements when the vector is closed.
+template <class T>
+class mmap_vector {
+  public:
+	// types
+	typedef T                                    value_type;
+	typedef T                                   &reference;
+	typedef const T                             &const_reference;
+	typedef T                                   *iterator;
+	typedef const T                             *const_iterator;
+	typedef T                                   *pointer;
+	typedef const T                             *const_pointer;
+	typedef std::size_t                          size_type;
+	typedef std::ptrdiff_t                       difference_type;
+	typedef ft::reverse_iterator<iterator>       reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  private:
+	// Only trivially copyable types can be stored as raw bytes
+	typedef typename ft::enable_if<ft::is_trivially_copyable<T>::value,
+		T>::type trivially_copyable_type;
+
+  public:
+	// constructor/destroy
+	mmap_vector()
+		: m_fd(-1), m_mode(mmap_read_only), m_begin(0), m_end(0),
+		  m_end_of_storage(0) {}
+	explicit mmap_vector(
+		const char *path, mmap_vector_mode mode = mmap_read_only)
+		: m_fd(-1), m_mode(mode), m_begin(0), m_end(0), m_end_of_storage(0) {
+		open(path, mode);
+	}
+	~mmap_vector() {
+		close();
+	}
+
+	// Maps the file at path, closing the current one first. Throws
+	// std::runtime_error when the file cannot be opened or mapped, or when
+	// its size is not a multiple of sizeof(T).
+	void open(const char *path, mmap_vector_mode mode = mmap_read_only) {
+		close();
+		const int flags = mode == mmap_read_write ? O_RDWR | O_CREAT : O_RDONLY;
+		m_fd = ::open(path, flags, 0644);
+		if (m_fd < 0) {
+			m_throw_error(path);
+		}
+		m_mode = mode;
+		struct stat st;
+		if (fstat(m_fd, &st) < 0) {
+			m_fail(path);
+		}
+		const std::size_t bytes = st.st_size;
+		if (bytes % sizeof(T) != 0) {
+			m_release();
+			throw std::runtime_error(std::string("mmap_vector: ") + path
+				+ ": size is not a multiple of the element size");
+		}
+		if (bytes != 0 && !m_map(bytes)) {
+			m_fail(path);
+		}
+		m_end = m_begin + bytes / sizeof(T);
+	}
+
+	// Unmaps the file and closes it, cutting it back to the elements
+	void close() {
+		if (m_fd < 0) {
+			return;
+		}
+		if (m_mode == mmap_read_write) {
+			// Ignored, the elements are in the file either way
+			(void)!ftruncate(m_fd, size() * sizeof(T));
+		}
+		m_release();
+	}
+
+	bool is_open() const {
+		return m_fd >= 0;
+	}
+
+	mmap_vector_mode mode() const {
+		return m_mode;
+	}
+
+	// Writes the changed pages of a mmap_read_write file back to it
+	void flush() {
+		if (m_mode == mmap_read_write && m_begin != 0
+			&& msync(m_begin, size() * sizeof(T), MS_SYNC) < 0) {
+			m_throw_error("msync");
+		}
+	}
+
+	// iterators
+	iterator begin() {
+		return m_begin;
+	}
+
+	const_iterator begin() const {
+		return m_begin;
+	}
+
+	iterator end() {
+		return m_end;
+	}
+
+	const_iterator end() const {
+		return m_end;
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type size() const {
+		return m_end - m_begin;
+	}
+
+	size_type capacity() const {
+		return m_end_of_storage - m_begin;
+	}
+
+	bool empty() const {
+		return m_begin == m_end;
+	}
+
+	// Grows the file to hold n elements, mmap_read_write only
+	void reserve(size_type n) {
+		if (n <= capacity()) {
+			return;
+		}
+		if (m_mode != mmap_read_write) {
+			throw std::logic_error(
+				std::string("mmap_vector: reserve: file is not writable"));
+		}
+		const std::size_t page_size = sysconf(_SC_PAGESIZE);
+		const std::size_t bytes =
+			(n * sizeof(T) + page_size - 1) / page_size * page_size;
+		const size_type old_size = size();
+		if (ftruncate(m_fd, bytes) < 0 || !m_remap(bytes)) {
+			m_throw_error("reserve");
+		}
+		m_end = m_begin + old_size;
+	}
+
+	// element access
+	reference operator[](size_type n) {
+		return m_begin[n];
+	}
+
+	const_reference operator[](size_type n) const {
+		return m_begin[n];
+	}
+
+	reference at(size_type n) {
+		if (n >= size()) {
+			throw std::out_of_range(
+				std::string("mmap_vector: index out of range"));
+		}
+		return m_begin[n];
+	}
+
+	const_reference at(size_type n) const {
+		if (n >= size()) {
+			throw std::out_of_range(
+				std::string("mmap_vector: index out of range"));
+		}
+		return m_begin[n];
+	}
+
+	reference front() {
+		return *m_begin;
+	}
+
+	const_reference front() const {
+		return *m_begin;
+	}
+
+	reference back() {
+		return *(m_end - 1);
+	}
+
+	const_reference back() const {
+		return *(m_end - 1);
+	}
+
+	pointer data() {
+		return m_begin;
+	}
+
+	const_pointer data() const {
+		return m_begin;
+	}
+
+	// modifiers, mmap_read_write only
+	void push_back(const T &x) {
+		if (m_end == m_end_of_storage) {
+			// x may be an element about to be remapped
+			const T value = x;
+			reserve(vector_growth_2x::next_capacity(size(), 1, sizeof(T)));
+			*m_end++ = value;
+		} else {
+			*m_end++ = x;
+		}
+	}
+
+	void pop_back() {
+		--m_end;
+	}
+
+	void swap(mmap_vector<T> &x) {
+		ft::swap(m_fd, x.m_fd);
+		ft::swap(m_mode, x.m_mode);
+		ft::swap(m_begin, x.m_begin);
+		ft::swap(m_end, x.m_end);
+		ft::swap(m_end_of_storage, x.m_end_of_storage);
+	}
+
+  private:
+	int              m_fd;
+	mmap_vector_mode m_mode;
+	iterator         m_begin;
+	iterator         m_end;
+	iterator         m_end_of_storage;
+
+	mmap_vector(const mmap_vector<T> &);
+	mmap_vector<T> &operator=(const mmap_vector<T> &);
+
+	// Maps the first bytes of the file, false with errno set on failure
+	bool m_map(std::size_t bytes) {
+		const int prot =
+			m_mode == mmap_read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+		const int flags =
+			m_mode == mmap_copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+		void *p = mmap(NULL, bytes, prot, flags, m_fd, 0);
+		if (p == MAP_FAILED) {
+			return false;
+		}
+		m_begin = static_cast<iterator>(p);
+		m_end_of_storage = m_begin + bytes / sizeof(T);
+		return true;
+	}
+
+	// Maps bytes of the file in place of the current mapping, m_end has to
+	// be set again
+	bool m_remap(std::size_t bytes) {
+		if (m_begin == 0) {
+			return m_map(bytes);
+		}
+#if defined(__linux__)
+		void *p = mremap(
+			m_begin, capacity() * sizeof(T), bytes, MREMAP_MAYMOVE);
+		if (p == MAP_FAILED) {
+			return false;
+		}
+		m_begin = static_cast<iterator>(p);
+		m_end_of_storage = m_begin + bytes / sizeof(T);
+		return true;
+#else
+		munmap(m_begin, capacity() * sizeof(T));
+		m_begin = m_end = m_end_of_storage = 0;
+		return m_map(bytes);
+#endif
+	}
+
+	// Unmaps the file and closes it as it is. The errors of open() come
+	// here rather than to close(), which would cut the file to no elements.
+	void m_release() {
+		if (m_begin != 0) {
+			munmap(m_begin, capacity() * sizeof(T));
+		}
+		::close(m_fd);
+		m_fd = -1;
+		m_begin = m_end = m_end_of_storage = 0;
+	}
+
+	// Closes the file untouched and throws the error of the last system call
+	void m_fail(const char *what) {
+		const int error = errno;
+		m_release();
+		errno = error;
+		m_throw_error(what);
+	}
+
+	static void m_throw_error(const char *what) {
+		throw std::runtime_error(
+			std::string("mmap_vector: ") + what + ": " + std::strerror(errno));
+	}
+};
+
+template <class T>
+bool operator==(const mmap_vector<T> &x, const mmap_vector<T> &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T>
+bool operator!=(const mmap_vector<T> &x, const mmap_vector<T> &y) {
+	return !(x == y);
+}
+
+template <class T>
+void swap(mmap_vector<T> &x, mmap_vector<T> &y) {
+	x.swap(y);
+}
+
+}  // namespace ft
@@ -0,0 +1,266 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+#include "atomic.hpp"
+
+namespace ft {
+
+// A bounded queue any number of threads push to and pop from without locks,
+// after Dmitry Vyukov's bounded MPMC queue. Every slot of a circular array
+// of a power of two slots carries a sequence number telling which turn it
+// is ready for: position pos may be written once the sequence of its slot
+// is pos and read once it is pos + 1, after which the reader sets it to
+// pos + capacity for the next lap. A thread claims a position with a
+// compare and swap on m_tail or m_head, then owns the slot until it
+// publishes the new sequence with a release store, so pushes and pops on
+// different slots never wait for each other.
+//
+// Copying or moving an element in or out must not throw: the position is
+// claimed by then and its slot would stay busy. The destructor destroys
+// the elements left and must not race with the other calls.
+template <class T, class Allocator = std::allocator<T> >
+class mpmc_queue {
+	struct cell {
+		std::size_t sequence;
+		T           value;
+	};
+
+	typedef typename Allocator::template rebind<cell>::other cell_allocator;
+
+  public:
+	typedef T           value_type;
+	typedef Allocator   allocator_type;
+	typedef std::size_t size_type;
+
+	// Room for capacity elements, rounded up to a power of two and at least
+	// two. Throws std::length_error when that is more than the allocator can
+	// give.
+	explicit mpmc_queue(
+		size_type capacity, const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_cells(0), m_mask(0), m_tail(0),
+		  m_head(0) {
+		cell_allocator cells(m_allocator);
+		size_type      slots = 2;
+		while (slots < capacity) {
+			if (slots > cells.max_size() / 2) {
+				throw std::length_error(
+					std::string("mpmc_queue: capacity > max_size"));
+			}
+			slots *= 2;
+		}
+		// The values are constructed in place by push, only the sequence
+		// numbers are set here
+		m_cells = cells.allocate(slots);
+		m_mask = slots - 1;
+		for (size_type i = 0; i < slots; i++) {
+			m_cells[i].sequence = i;
+		}
+	}
+
+	~mpmc_queue() {
+		for (size_type i = m_head; i != m_tail; i++) {
+			m_allocator.destroy(&m_cells[i & m_mask].value);
+		}
+		cell_allocator(m_allocator).deallocate(m_cells, m_mask + 1);
+	}
+
+	// Returns false when the queue is full
+	bool try_push(const T &x) {
+		size_type pos = atomic_load(&m_tail, memory_order_relaxed);
+		cell     *c;
+		for (;;) {
+			c = &m_cells[pos & m_mask];
+			const std::ptrdiff_t diff = std::ptrdiff_t(
+				atomic_load(&c->sequence, memory_order_acquire) - pos);
+			if (diff == 0) {
+				// On failure pos is the position another push moved to
+				if (atomic_compare_exchange(&m_tail, pos, pos + 1,
+						memory_order_relaxed, memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				// The slot still holds the element of the previous lap
+				return false;
+			} else {
+				pos = atomic_load(&m_tail, memory_order_relaxed);
+			}
+		}
+		m_allocator.construct(&c->value, x);
+		atomic_store(&c->sequence, pos + 1, memory_order_release);
+		return true;
+	}
+
+	// Waits while the queue is full
+	void push(const T &x) {
+		backoff waiting;
+		while (!try_push(x)) {
+			waiting.wait();
+		}
+	}
+
+	// Claims as many consecutive positions as are free, up to n, with a
+	// single compare and swap and fills them. Returns how many of the n
+	// were pushed.
+	size_type try_push_n(const T *first, size_type n) {
+		if (n == 0) {
+			return 0;
+		}
+		size_type pos = atomic_load(&m_tail, memory_order_relaxed);
+		size_type claimed;
+		for (;;) {
+			claimed = 0;
+			while (claimed < n && m_sequence(pos + claimed) == pos + claimed) {
+				claimed++;
+			}
+			if (claimed == 0) {
+				if (std::ptrdiff_t(m_sequence(pos) - pos) < 0) {
+					return 0;
+				}
+				pos = atomic_load(&m_tail, memory_order_relaxed);
+			} else if (atomic_compare_exchange(&m_tail, pos, pos + claimed,
+						   memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		}
+		for (size_type i = 0; i < claimed; i++) {
+			cell *c = &m_cells[(pos + i) & m_mask];
+			m_allocator.construct(&c->value, first[i]);
+			atomic_store(&c->sequence, pos + i + 1, memory_order_release);
+		}
+		return claimed;
+	}
+
+	// Pushes all n elements, waiting for room as needed
+	void push_n(const T *first, size_type n) {
+		backoff waiting;
+		while (n != 0) {
+			const size_type pushed = try_push_n(first, n);
+			if (pushed == 0) {
+				waiting.wait();
+			} else {
+				waiting.reset();
+			}
+			first += pushed;
+			n -= pushed;
+		}
+	}
+
+	// Moves the oldest element to x, returns false when the queue is empty
+	bool try_pop(T &x) {
+		size_type pos = atomic_load(&m_head, memory_order_relaxed);
+		cell     *c;
+		for (;;) {
+			c = &m_cells[pos & m_mask];
+			const std::ptrdiff_t diff = std::ptrdiff_t(
+				atomic_load(&c->sequence, memory_order_acquire) - (pos + 1));
+			if (diff == 0) {
+				if (atomic_compare_exchange(&m_head, pos, pos + 1,
+						memory_order_relaxed, memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				// Nothing pushed at pos yet
+				return false;
+			} else {
+				pos = atomic_load(&m_head, memory_order_relaxed);
+			}
+		}
+		m_take(c, pos, x);
+		return true;
+	}
+
+	// Waits while the queue is empty
+	void pop(T &x) {
+		backoff waiting;
+		while (!try_pop(x)) {
+			waiting.wait();
+		}
+	}
+
+	// Claims as many consecutive elements as are ready, up to n, with a
+	// single compare and swap and moves them to out. Returns how many were
+	// popped.
+	size_type try_pop_n(T *out, size_type n) {
+		if (n == 0) {
+			return 0;
+		}
+		size_type pos = atomic_load(&m_head, memory_order_relaxed);
+		size_type claimed;
+		for (;;) {
+			claimed = 0;
+			while (claimed < n
+				&& m_sequence(pos + claimed) == pos + claimed + 1) {
+				claimed++;
+			}
+			if (claimed == 0) {
+				if (std::ptrdiff_t(m_sequence(pos) - (pos + 1)) < 0) {
+					return 0;
+				}
+				pos = atomic_load(&m_head, memory_order_relaxed);
+			} else if (atomic_compare_exchange(&m_head, pos, pos + claimed,
+						   memory_order_relaxed, memory_order_relaxed)) {
+				break;
+			}
+		}
+		for (size_type i = 0; i < claimed; i++) {
+			m_take(&m_cells[(pos + i) & m_mask], pos + i, out[i]);
+		}
+		return claimed;
+	}
+
+	// observers
+	// A snapshot, already stale when other threads push or pop
+	size_type size() const {
+		const size_type head = atomic_load(&m_head, memory_order_acquire);
+		const size_type tail = atomic_load(&m_tail, memory_order_acquire);
+		return std::ptrdiff_t(tail - head) > 0 ? tail - head : 0;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	size_type capacity() const {
+		return m_mask + 1;
+	}
+
+  private:
+	// Read by every thread, written only by the constructor
+	Allocator m_allocator;
+	cell     *m_cells;
+	size_type m_mask;
+	char      m_pad0[cache_line_size];
+	// Next position to push to
+	size_type m_tail;
+	char      m_pad1[cache_line_size];
+	// Next position to pop from
+	size_type m_head;
+	char      m_pad2[cache_line_size];
+
+	mpmc_queue(const mpmc_queue &);
+	mpmc_queue &operator=(const mpmc_queue &);
+
+	size_type m_sequence(size_type pos) const {
+		return atomic_load(&m_cells[pos & m_mask].sequence,
+			memory_order_acquire);
+	}
+
+	// Moves the element out of the slot claimed for pos and hands the slot
+	// to the push one lap later
+	void m_take(cell *c, size_type pos, T &x) {
+#if __cplusplus >= 201103L
+		x = std::move(c->value);
+#else
+		x = c->value;
+#endif
+		m_allocator.destroy(&c->value);
+		atomic_store(&c->sequence, pos + m_mask + 1, memory_order_release);
+	}
+};
+
+}  // namespace ft
@@ -1,5 +1,5 @@
 #pragma once
-#include "list.hpp"
+#include "deque.hpp"
 
 namespace ft {
 
@@ -13,7 +13,7 @@ bool operator==(const queue<T, Container> &x, const queue<T, Container> &y);
 template <class T, class Container>
 bool operator<(const queue<T, Container> &x, const queue<T, Container> &y);
 
-template <class T, class Container = ft::list<T> >
+template <class T, class Container = ft::deque<T> >
 class queue {
 	friend bool operator==
 		<> (const queue<T, Container> &x, const queue<T, Container> &y);
@@ -30,6 +30,10 @@ class queue {
 
   public:
 	explicit queue(const Container &container = Container()) : c(container) {}
+#if __cplusplus >= 201103L
+	// The implicit copy and move operations forward to the container
+	explicit queue(Container &&container) : c(std::move(container)) {}
+#endif
 
 	bool empty() const {
 		return c.empty();
@@ -59,6 +63,12 @@ class queue {
 		c.push_back(value);
 	}
 
+#if __cplusplus >= 201103L
+	void push(value_type &&value) {
+		c.push_back(std::move(value));
+	}
+#endif
+
 	void pop() {
 		c.pop_front();
 	}
@@ -0,0 +1,341 @@
+#pragma once
+#include <pthread.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstring>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+namespace detail {
+
+// Type of the keys a key extractor returns: its result_type, or the return
+// type of a function
+template <class KeyExtractor>
+struct key_result {
+	typedef typename KeyExtractor::result_type type;
+};
+
+template <class R, class A>
+struct key_result<R (*)(A)> {
+	typedef typename remove_const<R>::type type;
+};
+
+// Maps a key to an unsigned integer of the same size that sorts the same
+// way, so that it can be sorted a byte at a time. Keys of other types do not
+// have one and cannot be radix sorted.
+template <class Key, class Enable = void>
+struct radix_traits;
+
+// Two's complement integers sort like unsigned ones once the sign bit is
+// flipped
+template <class Key>
+struct radix_traits<Key, typename enable_if<is_integral<Key>::value>::type> {
+	typedef typename choose<sizeof(Key) <= sizeof(unsigned int),
+		unsigned int, unsigned long>::type bits_type;
+
+	static bits_type bits(Key key) {
+		const bool      is_signed = Key(-1) < Key(0);
+		const bits_type sign_bit = bits_type(1) << (sizeof(Key) * 8 - 1);
+		// Clears the bits sign extension sets above the key
+		const bits_type mask = bits_type(-1)
+			>> (sizeof(bits_type) - sizeof(Key)) * 8;
+		return (static_cast<bits_type>(key) & mask)
+			^ (is_signed ? sign_bit : 0);
+	}
+};
+
+// IEEE 754 floats sort like unsigned integers once the sign bit is set on
+// the positive ones and all the bits are flipped on the negative ones. -0.0
+// comes before 0.0, NaNs go to the ends.
+template <class Key>
+struct radix_traits<Key,
+	typename enable_if<is_floating_point<Key>::value
+					   && (sizeof(Key) == sizeof(unsigned int)
+						   || sizeof(Key) == sizeof(unsigned long))>::type> {
+	typedef typename choose<sizeof(Key) == sizeof(unsigned int),
+		unsigned int, unsigned long>::type bits_type;
+
+	static bits_type bits(Key key) {
+		const bits_type sign_bit = bits_type(1) << (sizeof(Key) * 8 - 1);
+		bits_type       b;
+		std::memcpy(&b, &key, sizeof(b));
+		return (b & sign_bit) ? ~b : b | sign_bit;
+	}
+};
+
+// Orders elements by their radix keys, for the small ranges
+template <class KeyExtractor>
+struct radix_key_less {
+	typedef typename key_result<KeyExtractor>::type key_type;
+	typedef radix_traits<key_type>                  traits;
+
+	KeyExtractor key;
+
+	explicit radix_key_less(KeyExtractor k) : key(k) {}
+
+	template <class T>
+	bool operator()(const T &x, const T &y) const {
+		return traits::bits(key(x)) < traits::bits(key(y));
+	}
+};
+
+// Below this many elements an insertion sort is faster than the passes
+static const std::size_t radix_sort_threshold = 64;
+// Fewest elements a thread of parallel_radix_sort is given
+static const std::size_t radix_chunk_threshold = 16384;
+
+template <class KeyExtractor, class T>
+inline std::size_t radix_digit(KeyExtractor &key, const T &x, int pass) {
+	typedef radix_traits<typename key_result<KeyExtractor>::type> traits;
+	return (traits::bits(key(x)) >> (pass * 8)) & 0xff;
+}
+
+// Counts the digits of passes [first_pass, last_pass) over [begin, end)
+template <class It, class KeyExtractor>
+void radix_count(It src, std::size_t begin, std::size_t end,
+	KeyExtractor key, std::size_t (*counts)[256], int first_pass,
+	int last_pass) {
+	for (std::size_t i = begin; i < end; i++) {
+		for (int pass = first_pass; pass < last_pass; pass++) {
+			counts[pass][radix_digit(key, src[i], pass)]++;
+		}
+	}
+}
+
+// Turns the counts of a pass into the offsets its digits start at, false
+// when all the keys have the same digit and the pass would change nothing
+inline bool radix_offsets(std::size_t *counts, std::size_t n) {
+	std::size_t sum = 0;
+	for (int digit = 0; digit < 256; digit++) {
+		if (counts[digit] == n) {
+			return false;
+		}
+		const std::size_t count = counts[digit];
+		counts[digit] = sum;
+		sum += count;
+	}
+	return true;
+}
+
+// Moves [begin, end) of src to dst by the digit of pass, offsets are where
+// the next element of each digit goes
+template <class Src, class Dst, class KeyExtractor>
+void radix_scatter(Src src, std::size_t begin, std::size_t end, Dst dst,
+	KeyExtractor key, int pass, std::size_t *offsets) {
+	for (std::size_t i = begin; i < end; i++) {
+		dst[offsets[radix_digit(key, src[i], pass)]++] = FT_MOVE(src[i]);
+	}
+}
+
+// The share of a pass one thread of parallel_radix_sort does: counting the
+// digits of its chunk, or moving the chunk to the offsets of its digits
+template <class Src, class Dst, class KeyExtractor>
+struct radix_chunk_task {
+	Src          src;
+	Dst          dst;
+	KeyExtractor key;
+	std::size_t  begin;
+	std::size_t  end;
+	std::size_t (*counts)[256];
+	int          first_pass;
+	int          last_pass;
+	bool         scatter;
+
+	void run() {
+		if (scatter) {
+			radix_scatter(src, begin, end, dst, key, first_pass,
+				counts[first_pass]);
+		} else {
+			radix_count(src, begin, end, key, counts, first_pass, last_pass);
+		}
+	}
+};
+
+template <class Task>
+void *run_task(void *task) {
+	static_cast<Task *>(task)->run();
+	return NULL;
+}
+
+// Runs tasks[1..count) on threads of their own and tasks[0] on the calling
+// one. A task whose thread cannot be created is run here too.
+template <class Task>
+void run_parallel(Task *tasks, std::size_t count) {
+	ft::vector<pthread_t> threads(count);
+	ft::vector<bool>      started(count, false);
+	for (std::size_t i = 1; i < count; i++) {
+		started[i] = pthread_create(
+						 &threads[i], NULL, run_task<Task>, &tasks[i])
+			== 0;
+	}
+	tasks[0].run();
+	for (std::size_t i = 1; i < count; i++) {
+		if (started[i]) {
+			pthread_join(threads[i], NULL);
+		} else {
+			tasks[i].run();
+		}
+	}
+}
+
+// One pass of parallel_radix_sort from src to dst: every thread counts the
+// digits of its chunk, each chunk is given the offsets after those of the
+// same digit in the chunks before it, then every thread moves its chunk
+template <class Src, class Dst, class KeyExtractor>
+void parallel_radix_pass(Src src, Dst dst, std::size_t n, KeyExtractor key,
+	int pass, std::size_t threads, std::size_t (*counts)[8][256]) {
+	typedef radix_chunk_task<Src, Dst, KeyExtractor> task;
+	ft::vector<task> tasks(threads);
+	for (std::size_t t = 0; t < threads; t++) {
+		ft::fill(counts[t][pass], counts[t][pass] + 256, std::size_t(0));
+		tasks[t].src = src;
+		tasks[t].dst = dst;
+		tasks[t].key = key;
+		tasks[t].begin = n * t / threads;
+		tasks[t].end = n * (t + 1) / threads;
+		tasks[t].counts = counts[t];
+		tasks[t].first_pass = pass;
+		tasks[t].last_pass = pass + 1;
+		tasks[t].scatter = false;
+	}
+	run_parallel(&tasks[0], threads);
+	std::size_t sum = 0;
+	for (int digit = 0; digit < 256; digit++) {
+		for (std::size_t t = 0; t < threads; t++) {
+			const std::size_t count = counts[t][pass][digit];
+			counts[t][pass][digit] = sum;
+			sum += count;
+		}
+	}
+	for (std::size_t t = 0; t < threads; t++) {
+		tasks[t].scatter = true;
+	}
+	run_parallel(&tasks[0], threads);
+}
+
+}  // namespace detail
+
+// Sorts a range by the keys key_extractor returns for its elements, least
+// significant byte first. Stable, sizeof(key) passes over the range at most:
+// a pass is skipped when all the keys have the same byte there. The keys are
+// integers, float or double; the elements are moved through a scratch
+// ft::vector and must be default constructible.
+template <class RandomIt, class KeyExtractor>
+void radix_sort(RandomIt first, RandomIt last, KeyExtractor key_extractor) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	typedef typename detail::key_result<KeyExtractor>::type key_type;
+	const int         passes = sizeof(key_type);
+	const std::size_t n = last - first;
+
+	if (n < detail::radix_sort_threshold) {
+		detail::insertion_sort(
+			first, last, detail::radix_key_less<KeyExtractor>(key_extractor));
+		return;
+	}
+	std::size_t counts[passes][256] = {};
+	detail::radix_count(first, 0, n, key_extractor, counts, 0, passes);
+	ft::vector<value_type> buffer(n);
+	bool                   in_buffer = false;
+	for (int pass = 0; pass < passes; pass++) {
+		if (!detail::radix_offsets(counts[pass], n)) {
+			continue;
+		}
+		if (in_buffer) {
+			detail::radix_scatter(buffer.begin(), 0, n, first, key_extractor,
+				pass, counts[pass]);
+		} else {
+			detail::radix_scatter(first, 0, n, buffer.begin(), key_extractor,
+				pass, counts[pass]);
+		}
+		in_buffer = !in_buffer;
+	}
+	if (in_buffer) {
+		ft::move(buffer.begin(), buffer.end(), first);
+	}
+}
+
+template <class RandomIt>
+void radix_sort(RandomIt first, RandomIt last) {
+	ft::radix_sort(first, last,
+		ft::identity<typename iterator_traits<RandomIt>::value_type>());
+}
+
+// radix_sort with the counting and the moving of every pass split between
+// threads, one per processor when threads is 0. Ranges too small to give
+// every thread a few pages of work are sorted on the calling thread.
+template <class RandomIt, class KeyExtractor>
+void parallel_radix_sort(RandomIt first, RandomIt last,
+	KeyExtractor key_extractor, std::size_t threads = 0) {
+	typedef typename iterator_traits<RandomIt>::value_type value_type;
+	typedef typename detail::key_result<KeyExtractor>::type key_type;
+	typedef detail::radix_chunk_task<RandomIt, value_type *, KeyExtractor>
+		count_task;
+	const int         passes = sizeof(key_type);
+	const std::size_t n = last - first;
+
+	if (threads == 0) {
+		const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = processors > 0 ? processors : 1;
+	}
+	threads = ft::min(threads, n / detail::radix_chunk_threshold);
+	if (threads <= 1) {
+		ft::radix_sort(first, last, key_extractor);
+		return;
+	}
+	// Per thread counts of every digit of every pass
+	ft::vector<std::size_t> count_storage(threads * 8 * 256, 0);
+	std::size_t(*counts)[8][256] =
+		reinterpret_cast<std::size_t(*)[8][256]>(&count_storage[0]);
+	ft::vector<count_task> tasks(threads);
+	for (std::size_t t = 0; t < threads; t++) {
+		tasks[t].src = first;
+		tasks[t].key = key_extractor;
+		tasks[t].begin = n * t / threads;
+		tasks[t].end = n * (t + 1) / threads;
+		tasks[t].counts = counts[t];
+		tasks[t].first_pass = 0;
+		tasks[t].last_pass = passes;
+		tasks[t].scatter = false;
+	}
+	detail::run_parallel(&tasks[0], threads);
+	ft::vector<value_type> buffer(n);
+	bool                   in_buffer = false;
+	for (int pass = 0; pass < passes; pass++) {
+		// Skipped when every key has the same digit
+		bool skip = false;
+		for (int digit = 0; digit < 256 && !skip; digit++) {
+			std::size_t total = 0;
+			for (std::size_t t = 0; t < threads; t++) {
+				total += counts[t][pass][digit];
+			}
+			skip = total == n;
+		}
+		if (skip) {
+			continue;
+		}
+		if (in_buffer) {
+			detail::parallel_radix_pass(&buffer[0], first, n, key_extractor,
+				pass, threads, counts);
+		} else {
+			detail::parallel_radix_pass(first, &buffer[0], n, key_extractor,
+				pass, threads, counts);
+		}
+		in_buffer = !in_buffer;
+	}
+	if (in_buffer) {
+		ft::move(buffer.begin(), buffer.end(), first);
+	}
+}
+
+template <class RandomIt>
+void parallel_radix_sort(RandomIt first, RandomIt last) {
+	ft::parallel_radix_sort(first, last,
+		ft::identity<typename iterator_traits<RandomIt>::value_type>());
+}
+
+}  // namespace ft
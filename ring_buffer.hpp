@@ -0,0 +1,578 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+namespace ft {
+
+// Full policies, they decide what a full ring_buffer does with one more
+// element.
+
+// Refuses it: try_push_back returns false and push_back throws, the elements
+// already queued are kept
+struct ring_buffer_reject : public false_type {};
+
+// Drops the oldest element to make room, the buffer holds the latest
+// capacity() elements pushed
+struct ring_buffer_overwrite : public true_type {};
+
+// A queue of at most capacity() elements in one block allocated by the
+// constructor, nothing is allocated afterwards. The capacity is rounded up to
+// a power of two and the elements are found by masking two running counters,
+// the positions of the front and one past the back, so push_back and
+// pop_front are a store, an increment and an and. It works as the Container
+// of ft::queue:
+//
+//     ft::queue<int, ft::ring_buffer<int> > q(ft::ring_buffer<int>(1024));
+//
+// A default constructed ring_buffer has no room at all.
+template <class T, class Allocator = std::allocator<T>,
+	class FullPolicy = ring_buffer_reject>
+class ring_buffer {
+  public:
+	// types
+	typedef typename Allocator::reference       reference;
+	typedef typename Allocator::const_reference const_reference;
+	typedef typename Allocator::size_type       size_type;
+	typedef typename Allocator::difference_type difference_type;
+	typedef T                                   value_type;
+	typedef Allocator                           allocator_type;
+	typedef typename Allocator::pointer         pointer;
+	typedef typename Allocator::const_pointer   const_pointer;
+	typedef FullPolicy                          full_policy;
+
+	// Position n from the front of the buffer
+	template <bool isconst = false>
+	class ring_iterator {
+		template <bool>
+		friend class ring_iterator;
+
+	  public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef T                               value_type;
+		typedef typename Allocator::difference_type difference_type;
+		typedef typename ft::choose<isconst, const T &, T &>::type reference;
+		typedef typename ft::choose<isconst, const T *, T *>::type pointer;
+
+		ring_iterator() : m_data(0), m_mask(0), m_index(0) {}
+
+		ring_iterator(T *data, size_type mask, size_type index)
+			: m_data(data), m_mask(mask), m_index(index) {}
+
+		ring_iterator(const ring_iterator<false> &rhs)
+			: m_data(rhs.m_data), m_mask(rhs.m_mask), m_index(rhs.m_index) {}
+
+		ring_iterator &operator=(const ring_iterator<false> &rhs) {
+			m_data = rhs.m_data;
+			m_mask = rhs.m_mask;
+			m_index = rhs.m_index;
+			return *this;
+		}
+
+		reference operator*() const {
+			return m_data[m_index & m_mask];
+		}
+
+		pointer operator->() const {
+			return &**this;
+		}
+
+		reference operator[](difference_type n) const {
+			return m_data[(m_index + n) & m_mask];
+		}
+
+		ring_iterator &operator++() {
+			++m_index;
+			return *this;
+		}
+
+		ring_iterator operator++(int) {
+			ring_iterator tmp(*this);
+			++m_index;
+			return tmp;
+		}
+
+		ring_iterator &operator--() {
+			--m_index;
+			return *this;
+		}
+
+		ring_iterator operator--(int) {
+			ring_iterator tmp(*this);
+			--m_index;
+			return tmp;
+		}
+
+		ring_iterator &operator+=(difference_type n) {
+			m_index += n;
+			return *this;
+		}
+
+		ring_iterator &operator-=(difference_type n) {
+			m_index -= n;
+			return *this;
+		}
+
+		ring_iterator operator+(difference_type n) const {
+			return ring_iterator(m_data, m_mask, m_index + n);
+		}
+
+		ring_iterator operator-(difference_type n) const {
+			return ring_iterator(m_data, m_mask, m_index - n);
+		}
+
+		friend ring_iterator operator+(
+			difference_type n, const ring_iterator &x) {
+			return x + n;
+		}
+
+		// The counters wrap around together, their difference does not
+		friend difference_type operator-(
+			const ring_iterator &x, const ring_iterator &y) {
+			return difference_type(x.m_index - y.m_index);
+		}
+
+		friend bool operator==(const ring_iterator &x, const ring_iterator &y) {
+			return x.m_index == y.m_index;
+		}
+
+		friend bool operator!=(const ring_iterator &x, const ring_iterator &y) {
+			return x.m_index != y.m_index;
+		}
+
+		friend bool operator<(const ring_iterator &x, const ring_iterator &y) {
+			return x - y < 0;
+		}
+
+		friend bool operator>(const ring_iterator &x, const ring_iterator &y) {
+			return y < x;
+		}
+
+		friend bool operator<=(const ring_iterator &x, const ring_iterator &y) {
+			return !(y < x);
+		}
+
+		friend bool operator>=(const ring_iterator &x, const ring_iterator &y) {
+			return !(x < y);
+		}
+
+	  private:
+		T        *m_data;
+		size_type m_mask;
+		size_type m_index;
+	};
+
+	typedef ring_iterator<false>                 iterator;
+	typedef ring_iterator<true>                  const_iterator;
+	typedef ft::reverse_iterator<iterator>       reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	// constructor/copy/destroy
+	ring_buffer()
+		: m_allocator(), m_data(0), m_capacity(0), m_head(0), m_tail(0) {}
+
+	// Room for capacity elements, rounded up to a power of two
+	explicit ring_buffer(
+		size_type capacity, const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_data(0), m_capacity(0), m_head(0),
+		  m_tail(0) {
+		if (capacity != 0) {
+			m_capacity = m_round_up(capacity);
+			m_data = m_allocator.allocate(m_capacity);
+		}
+	}
+
+	ring_buffer(const ring_buffer &x)
+		: m_allocator(x.m_allocator), m_data(0), m_capacity(0), m_head(0),
+		  m_tail(0) {
+		if (x.m_capacity != 0) {
+			m_data = m_allocator.allocate(x.m_capacity);
+			m_capacity = x.m_capacity;
+			try {
+				for (const_iterator it = x.begin(); it != x.end(); ++it) {
+					push_back(*it);
+				}
+			} catch (...) {
+				clear();
+				m_allocator.deallocate(m_data, m_capacity);
+				throw;
+			}
+		}
+	}
+
+	~ring_buffer() {
+		clear();
+		if (m_data != 0) {
+			m_allocator.deallocate(m_data, m_capacity);
+		}
+	}
+
+	// Takes the capacity of x as well, which allocates when it differs
+	ring_buffer &operator=(const ring_buffer &x) {
+		if (this != &x) {
+			ring_buffer tmp(x);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+#if __cplusplus >= 201103L
+	// Takes over the block of x, which is left without one
+	ring_buffer(ring_buffer &&x) noexcept
+		: m_allocator(x.m_allocator), m_data(x.m_data),
+		  m_capacity(x.m_capacity), m_head(x.m_head), m_tail(x.m_tail) {
+		x.m_data = 0;
+		x.m_capacity = 0;
+		x.m_head = x.m_tail = 0;
+	}
+
+	ring_buffer &operator=(ring_buffer &&x) noexcept {
+		if (this != &x) {
+			ring_buffer tmp(std::move(x));
+			swap(tmp);
+		}
+		return *this;
+	}
+#endif
+
+	allocator_type get_allocator() const {
+		return m_allocator;
+	}
+
+	// iterators
+	iterator begin() {
+		return iterator(m_data, m_mask(), m_head);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(m_data, m_mask(), m_head);
+	}
+
+	iterator end() {
+		return iterator(m_data, m_mask(), m_tail);
+	}
+
+	const_iterator end() const {
+		return const_iterator(m_data, m_mask(), m_tail);
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type size() const {
+		return m_tail - m_head;
+	}
+
+	size_type max_size() const {
+		return m_allocator.max_size();
+	}
+
+	size_type capacity() const {
+		return m_capacity;
+	}
+
+	bool empty() const {
+		return m_tail == m_head;
+	}
+
+	bool full() const {
+		return size() == m_capacity;
+	}
+
+	// element access
+	reference operator[](size_type n) {
+		return m_data[(m_head + n) & m_mask()];
+	}
+
+	const_reference operator[](size_type n) const {
+		return m_data[(m_head + n) & m_mask()];
+	}
+
+	reference at(size_type n) {
+		m_check_index(n);
+		return (*this)[n];
+	}
+
+	const_reference at(size_type n) const {
+		m_check_index(n);
+		return (*this)[n];
+	}
+
+	reference front() {
+		return m_data[m_head & m_mask()];
+	}
+
+	const_reference front() const {
+		return m_data[m_head & m_mask()];
+	}
+
+	reference back() {
+		return m_data[(m_tail - 1) & m_mask()];
+	}
+
+	const_reference back() const {
+		return m_data[(m_tail - 1) & m_mask()];
+	}
+
+	// modifiers
+	// On a full buffer, throws std::length_error or drops the front element
+	// depending on FullPolicy
+	void push_back(const T &x) {
+		if (!try_push_back(x)) {
+			throw std::length_error(
+				std::string("ring_buffer: push_back: full"));
+		}
+	}
+
+	// Returns false when the buffer is full and FullPolicy rejects x
+	bool try_push_back(const T &x) {
+		if (size() != m_capacity) {
+			m_allocator.construct(m_data + (m_tail & m_mask()), x);
+			++m_tail;
+			return true;
+		}
+		return m_push_full(x, FullPolicy());
+	}
+
+#if __cplusplus >= 201103L
+	void push_back(T &&x) {
+		if (!try_push_back(std::move(x))) {
+			throw std::length_error(
+				std::string("ring_buffer: push_back: full"));
+		}
+	}
+
+	bool try_push_back(T &&x) {
+		if (size() != m_capacity) {
+			m_allocator.construct(m_data + (m_tail & m_mask()), std::move(x));
+			++m_tail;
+			return true;
+		}
+		return m_push_full(std::move(x), FullPolicy());
+	}
+#endif
+
+	void pop_front() {
+		m_allocator.destroy(m_data + (m_head & m_mask()));
+		++m_head;
+	}
+
+	void pop_back() {
+		--m_tail;
+		m_allocator.destroy(m_data + (m_tail & m_mask()));
+	}
+
+	// Copies n elements to the back in at most two contiguous runs, one up
+	// to the end of the block and one from its start. With the reject
+	// policy only the ones that fit are pushed, overwrite drops the oldest
+	// elements, the first of the n included. Returns how many of the n were
+	// taken.
+	size_type push_n(const T *first, size_type n) {
+		const size_type taken = m_make_room(first, n, FullPolicy());
+		size_type       left = ft::min(taken, m_capacity);
+		while (left != 0) {
+			const size_type offset = m_tail & m_mask();
+			const size_type run = ft::min(left, m_capacity - offset);
+			m_construct_run(first, run, m_data + offset,
+				typename detail::is_bitwise_constructible<const T *, T *,
+					Allocator>::type());
+			first += run;
+			left -= run;
+		}
+		return taken;
+	}
+
+	// Moves up to n elements from the front to out and pops them, in at most
+	// two contiguous runs. Returns how many were popped.
+	size_type pop_n(T *out, size_type n) {
+		n = ft::min(n, size());
+		for (size_type left = n; left != 0;) {
+			const size_type offset = m_head & m_mask();
+			const size_type run = ft::min(left, m_capacity - offset);
+			out = ft::move(m_data + offset, m_data + offset + run, out);
+			ft::destroy(m_data + offset, m_data + offset + run, m_allocator);
+			m_head += run;
+			left -= run;
+		}
+		return n;
+	}
+
+	void swap(ring_buffer &x) {
+		ft::swap(m_allocator, x.m_allocator);
+		ft::swap(m_data, x.m_data);
+		ft::swap(m_capacity, x.m_capacity);
+		ft::swap(m_head, x.m_head);
+		ft::swap(m_tail, x.m_tail);
+	}
+
+	// Keeps the block
+	void clear() {
+		while (m_head != m_tail) {
+			pop_front();
+		}
+		m_head = m_tail = 0;
+	}
+
+  private:
+	Allocator m_allocator;
+	T        *m_data;
+	size_type m_capacity;
+	size_type m_head;
+	size_type m_tail;
+
+	size_type m_mask() const {
+		return m_capacity - 1;
+	}
+
+	// The power of two at least n, throws std::length_error past max_size()
+	// rather than wrapping around
+	size_type m_round_up(size_type n) const {
+		size_type capacity = 1;
+		while (capacity < n) {
+			if (capacity > max_size() / 2) {
+				throw std::length_error(
+					std::string("ring_buffer: capacity > max_size"));
+			}
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	void m_check_index(size_type n) const {
+		if (n >= size()) {
+			throw std::out_of_range(
+				std::string("ring_buffer: index out of range"));
+		}
+	}
+
+	// The slot of the oldest element is the next one, x is assigned over it
+	// so that x may be that element
+	bool m_push_full(const T &x, true_type) {
+		if (m_capacity != 0) {
+			m_data[m_tail & m_mask()] = x;
+			++m_head;
+			++m_tail;
+		}
+		return true;
+	}
+
+#if __cplusplus >= 201103L
+	bool m_push_full(T &&x, true_type) {
+		if (m_capacity != 0) {
+			m_data[m_tail & m_mask()] = std::move(x);
+			++m_head;
+			++m_tail;
+		}
+		return true;
+	}
+#endif
+
+	bool m_push_full(const T &, false_type) {
+		return false;
+	}
+
+	// Leaves room for the elements push_n will copy: as many of them as fit,
+	// or for overwrite the last capacity() of them, popping the oldest
+	// elements they replace and skipping the ones they would replace
+	size_type m_make_room(const T *, size_type n, false_type) {
+		return ft::min(n, m_capacity - size());
+	}
+
+	size_type m_make_room(const T *&first, size_type n, true_type) {
+		if (n > m_capacity) {
+			first += n - m_capacity;
+			clear();
+			return n;
+		}
+		for (size_type room = m_capacity - size(); room < n; room++) {
+			pop_front();
+		}
+		return n;
+	}
+
+	void m_construct_run(const T *first, size_type n, T *dest, true_type) {
+		ft::copy(first, first + n, dest);
+		m_tail += n;
+	}
+
+	// One at a time, the elements constructed stay in the buffer if a copy
+	// throws
+	void m_construct_run(const T *first, size_type n, T *dest, false_type) {
+		for (size_type i = 0; i < n; i++) {
+			m_allocator.construct(dest + i, first[i]);
+			++m_tail;
+		}
+	}
+};
+
+template <class T, class Allocator, class FullPolicy>
+bool operator==(const ring_buffer<T, Allocator, FullPolicy> &x,
+	const ring_buffer<T, Allocator, FullPolicy>             &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, class Allocator, class FullPolicy>
+bool operator!=(const ring_buffer<T, Allocator, FullPolicy> &x,
+	const ring_buffer<T, Allocator, FullPolicy>             &y) {
+	return !(x == y);
+}
+
+template <class T, class Allocator, class FullPolicy>
+bool operator<(const ring_buffer<T, Allocator, FullPolicy> &x,
+	const ring_buffer<T, Allocator, FullPolicy>            &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, class Allocator, class FullPolicy>
+bool operator>(const ring_buffer<T, Allocator, FullPolicy> &x,
+	const ring_buffer<T, Allocator, FullPolicy>            &y) {
+	return y < x;
+}
+
+template <class T, class Allocator, class FullPolicy>
+bool operator<=(const ring_buffer<T, Allocator, FullPolicy> &x,
+	const ring_buffer<T, Allocator, FullPolicy>             &y) {
+	return !(y < x);
+}
+
+template <class T, class Allocator, class FullPolicy>
+bool operator>=(const ring_buffer<T, Allocator, FullPolicy> &x,
+	const ring_buffer<T, Allocator, FullPolicy>             &y) {
+	return !(x < y);
+}
+
+template <class T, class Allocator, class FullPolicy>
+void swap(ring_buffer<T, Allocator, FullPolicy> &x,
+	ring_buffer<T, Allocator, FullPolicy>       &y) {
+	x.swap(y);
+}
+
+// The block is all the buffer points to
+template <class T, class Allocator, class FullPolicy>
+struct is_trivially_relocatable<ring_buffer<T, Allocator, FullPolicy> >
+	: public is_trivially_relocatable<Allocator> {};
+
+}  // namespace ft
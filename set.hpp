@@ -0,0 +1,450 @@
+#pragma once
+#include <memory>
+#include "bst.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "utils.hpp"
+
+namespace ft {
+
+template <class Key, class Compare = ft::less<Key>,
+	class Allocator = std::allocator<Key> >
+class set {
+  public:
+	// types:
+	typedef Key                                 key_type;
+	typedef Key                                 value_type;
+	typedef Compare                             key_compare;
+	typedef Compare                             value_compare;
+	typedef Allocator                           allocator_type;
+	typedef typename Allocator::reference       reference;
+	typedef typename Allocator::const_reference const_reference;
+	typedef typename Allocator::pointer         pointer;
+	typedef typename Allocator::const_pointer   const_pointer;
+
+  private:
+	typedef bst<key_type, value_type, identity<value_type>, key_compare,
+		allocator_type>
+												rep_type;
+	typedef typename rep_type::iterator rep_iterator;
+	rep_type                            m_tree;
+
+	// Elements of a set are immutable, so every iterator handed out is a
+	// const_iterator; the tree itself needs the mutable kind to erase
+	static rep_iterator m_to_rep(const typename rep_type::const_iterator &it) {
+		return rep_iterator(it.base(), it.getRoot());
+	}
+
+  public:
+	// types:
+	typedef typename rep_type::const_iterator         iterator;
+	typedef typename rep_type::const_iterator         const_iterator;
+	typedef typename rep_type::size_type              size_type;
+	typedef typename rep_type::difference_type        difference_type;
+	typedef typename rep_type::const_reverse_iterator reverse_iterator;
+	typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+
+	// construct/copy/destroy:
+	explicit set(const Compare &comp = Compare(),
+		const Allocator        &allocator = Allocator())
+		: m_tree(comp, allocator) {}
+	template <class InputIterator>
+	set(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			InputIterator>::type first,
+		InputIterator last, const Compare &comp = Compare(),
+		const Allocator &allocator = Allocator())
+		: m_tree(comp, allocator) {
+		m_tree.insert(first, last);
+	}
+	set(const set<Key, Compare, Allocator> &x) : m_tree(x.m_tree) {}
+	~set() {}
+	set<Key, Compare, Allocator> &operator=(
+		const set<Key, Compare, Allocator> &x) {
+		m_tree = x.m_tree;
+		return *this;
+	}
+#if __cplusplus >= 201103L
+	set(set<Key, Compare, Allocator> &&x) noexcept
+		: m_tree(std::move(x.m_tree)) {}
+	set<Key, Compare, Allocator> &operator=(
+		set<Key, Compare, Allocator> &&x) noexcept {
+		m_tree = std::move(x.m_tree);
+		return *this;
+	}
+#endif
+
+	allocator_type get_allocator() const {
+		return m_tree.get_allocator();
+	}
+
+	// iterators:
+	iterator begin() const {
+		return m_tree.begin();
+	}
+
+	iterator end() const {
+		return m_tree.end();
+	}
+
+	reverse_iterator rbegin() const {
+		return m_tree.rbegin();
+	}
+
+	reverse_iterator rend() const {
+		return m_tree.rend();
+	}
+
+	// capacity:
+	bool empty() const {
+		return m_tree.empty();
+	}
+
+	size_type size() const {
+		return m_tree.size();
+	}
+
+	size_type max_size() const {
+		return m_tree.max_size();
+	}
+
+	// modifiers:
+	ft::pair<iterator, bool> insert(const value_type &x) {
+		return m_tree.insert(x);
+	}
+
+	iterator insert(iterator position, const value_type &x) {
+		return m_tree.insert(m_to_rep(position), x);
+	}
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		m_tree.insert(first, last);
+	}
+
+	void erase(iterator position) {
+		m_tree.erase(m_to_rep(position));
+	}
+
+	size_type erase(const key_type &key) {
+		return m_tree.erase(key);
+	}
+
+	void erase(iterator first, iterator last) {
+		m_tree.erase(m_to_rep(first), m_to_rep(last));
+	}
+
+	void swap(set<Key, Compare, Allocator> &x) {
+		m_tree.swap(x.m_tree);
+	}
+
+	void clear() {
+		m_tree.clear();
+	}
+
+	// observers:
+	key_compare key_comp() const {
+		return m_tree.key_comp();
+	}
+
+	value_compare value_comp() const {
+		return m_tree.key_comp();
+	}
+
+	// set operations:
+	iterator find(const key_type &key) const {
+		return m_tree.find(key);
+	}
+
+	size_type count(const key_type &key) const {
+		return m_tree.count(key);
+	}
+
+	iterator lower_bound(const key_type &key) const {
+		return m_tree.lower_bound(key);
+	}
+
+	iterator upper_bound(const key_type &key) const {
+		return m_tree.upper_bound(key);
+	}
+
+	ft::pair<iterator, iterator> equal_range(const key_type &key) const {
+		return m_tree.equal_range(key);
+	}
+
+#ifdef FT_BST_STATS
+	// instrumentation:
+	bst_stats stats() const {
+		return m_tree.stats();
+	}
+
+	void reset_stats() {
+		m_tree.reset_stats();
+	}
+#endif
+};
+
+template <class Key, class Compare, class Allocator>
+bool operator==(const set<Key, Compare, Allocator> &x,
+	const set<Key, Compare, Allocator> &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator!=(const set<Key, Compare, Allocator> &x,
+	const set<Key, Compare, Allocator> &y) {
+	return !(x == y);
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator<(const set<Key, Compare, Allocator> &x,
+	const set<Key, Compare, Allocator> &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator>(const set<Key, Compare, Allocator> &x,
+	const set<Key, Compare, Allocator> &y) {
+	return y < x;
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator<=(const set<Key, Compare, Allocator> &x,
+	const set<Key, Compare, Allocator> &y) {
+	return !(y < x);
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator>=(const set<Key, Compare, Allocator> &x,
+	const set<Key, Compare, Allocator> &y) {
+	return !(x < y);
+}
+
+// specialized algorithms:
+template <class Key, class Compare, class Allocator>
+void swap(set<Key, Compare, Allocator> &x, set<Key, Compare, Allocator> &y) {
+	x.swap(y);
+}
+
+template <class Key, class Compare = ft::less<Key>,
+	class Allocator = std::allocator<Key> >
+class multiset {
+  public:
+	// types:
+	typedef Key                                 key_type;
+	typedef Key                                 value_type;
+	typedef Compare                             key_compare;
+	typedef Compare                             value_compare;
+	typedef Allocator                           allocator_type;
+	typedef typename Allocator::reference       reference;
+	typedef typename Allocator::const_reference const_reference;
+	typedef typename Allocator::pointer         pointer;
+	typedef typename Allocator::const_pointer   const_pointer;
+
+  private:
+	typedef bst<key_type, value_type, identity<value_type>, key_compare,
+		allocator_type>
+												rep_type;
+	typedef typename rep_type::iterator rep_iterator;
+	rep_type                            m_tree;
+
+	// Elements of a multiset are immutable, so every iterator handed out is a
+	// const_iterator; the tree itself needs the mutable kind to erase
+	static rep_iterator m_to_rep(const typename rep_type::const_iterator &it) {
+		return rep_iterator(it.base(), it.getRoot());
+	}
+
+  public:
+	// types:
+	typedef typename rep_type::const_iterator         iterator;
+	typedef typename rep_type::const_iterator         const_iterator;
+	typedef typename rep_type::size_type              size_type;
+	typedef typename rep_type::difference_type        difference_type;
+	typedef typename rep_type::const_reverse_iterator reverse_iterator;
+	typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+
+	// construct/copy/destroy:
+	explicit multiset(const Compare &comp = Compare(),
+		const Allocator             &allocator = Allocator())
+		: m_tree(comp, allocator) {}
+	template <class InputIterator>
+	multiset(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+				 InputIterator>::type first,
+		InputIterator last, const Compare &comp = Compare(),
+		const Allocator &allocator = Allocator())
+		: m_tree(comp, allocator) {
+		m_tree.insert_equal(first, last);
+	}
+	multiset(const multiset<Key, Compare, Allocator> &x)
+		: m_tree(x.m_tree) {}
+	~multiset() {}
+	multiset<Key, Compare, Allocator> &operator=(
+		const multiset<Key, Compare, Allocator> &x) {
+		m_tree = x.m_tree;
+		return *this;
+	}
+#if __cplusplus >= 201103L
+	multiset(multiset<Key, Compare, Allocator> &&x) noexcept
+		: m_tree(std::move(x.m_tree)) {}
+	multiset<Key, Compare, Allocator> &operator=(
+		multiset<Key, Compare, Allocator> &&x) noexcept {
+		m_tree = std::move(x.m_tree);
+		return *this;
+	}
+#endif
+
+	allocator_type get_allocator() const {
+		return m_tree.get_allocator();
+	}
+
+	// iterators:
+	iterator begin() const {
+		return m_tree.begin();
+	}
+
+	iterator end() const {
+		return m_tree.end();
+	}
+
+	reverse_iterator rbegin() const {
+		return m_tree.rbegin();
+	}
+
+	reverse_iterator rend() const {
+		return m_tree.rend();
+	}
+
+	// capacity:
+	bool empty() const {
+		return m_tree.empty();
+	}
+
+	size_type size() const {
+		return m_tree.size();
+	}
+
+	size_type max_size() const {
+		return m_tree.max_size();
+	}
+
+	// modifiers:
+	iterator insert(const value_type &x) {
+		return m_tree.insert_equal(x);
+	}
+
+	iterator insert(iterator position, const value_type &x) {
+		return m_tree.insert_equal(m_to_rep(position), x);
+	}
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		m_tree.insert_equal(first, last);
+	}
+
+	void erase(iterator position) {
+		m_tree.erase(m_to_rep(position));
+	}
+
+	size_type erase(const key_type &key) {
+		return m_tree.erase(key);
+	}
+
+	void erase(iterator first, iterator last) {
+		m_tree.erase(m_to_rep(first), m_to_rep(last));
+	}
+
+	void swap(multiset<Key, Compare, Allocator> &x) {
+		m_tree.swap(x.m_tree);
+	}
+
+	void clear() {
+		m_tree.clear();
+	}
+
+	// observers:
+	key_compare key_comp() const {
+		return m_tree.key_comp();
+	}
+
+	value_compare value_comp() const {
+		return m_tree.key_comp();
+	}
+
+	// multiset operations:
+	iterator find(const key_type &key) const {
+		return m_tree.find(key);
+	}
+
+	size_type count(const key_type &key) const {
+		return m_tree.count(key);
+	}
+
+	iterator lower_bound(const key_type &key) const {
+		return m_tree.lower_bound(key);
+	}
+
+	iterator upper_bound(const key_type &key) const {
+		return m_tree.upper_bound(key);
+	}
+
+	ft::pair<iterator, iterator> equal_range(const key_type &key) const {
+		return m_tree.equal_range(key);
+	}
+
+#ifdef FT_BST_STATS
+	// instrumentation:
+	bst_stats stats() const {
+		return m_tree.stats();
+	}
+
+	void reset_stats() {
+		m_tree.reset_stats();
+	}
+#endif
+};
+
+template <class Key, class Compare, class Allocator>
+bool operator==(const multiset<Key, Compare, Allocator> &x,
+	const multiset<Key, Compare, Allocator> &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator!=(const multiset<Key, Compare, Allocator> &x,
+	const multiset<Key, Compare, Allocator> &y) {
+	return !(x == y);
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator<(const multiset<Key, Compare, Allocator> &x,
+	const multiset<Key, Compare, Allocator> &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator>(const multiset<Key, Compare, Allocator> &x,
+	const multiset<Key, Compare, Allocator> &y) {
+	return y < x;
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator<=(const multiset<Key, Compare, Allocator> &x,
+	const multiset<Key, Compare, Allocator> &y) {
+	return !(y < x);
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator>=(const multiset<Key, Compare, Allocator> &x,
+	const multiset<Key, Compare, Allocator> &y) {
+	return !(x < y);
+}
+
+// specialized algorithms:
+template <class Key, class Compare, class Allocator>
+void swap(
+	multiset<Key, Compare, Allocator> &x, multiset<Key, Compare, Allocator> &y) {
+	x.swap(y);
+}
+
+}  // namespace ft
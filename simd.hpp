@@ -0,0 +1,137 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#if defined(__SSE2__) && defined(__GNUC__)
+#	include <immintrin.h>
+#	define FT_SIMD_X86 1
+#endif
+
+// Vectorized byte kernels behind the algorithm.hpp fast paths. SSE2 is part
+// of x86-64, AVX2 is used when the CPU running the program has it.
+
+namespace ft {
+
+namespace detail {
+
+// Offset of the first byte that differs between a and b, n if none does.
+// Compares a word at a time, then finds the byte within the word.
+inline std::size_t mismatch_bytes_scalar(
+	const unsigned char *a, const unsigned char *b, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + sizeof(unsigned long) <= n; i += sizeof(unsigned long)) {
+		unsigned long x;
+		unsigned long y;
+		std::memcpy(&x, a + i, sizeof(x));
+		std::memcpy(&y, b + i, sizeof(y));
+		if (x != y) {
+			break;
+		}
+	}
+	for (; i < n; i++) {
+		if (a[i] != b[i]) {
+			return i;
+		}
+	}
+	return n;
+}
+
+// Stores the first 16 bytes of pattern over and over, bytes must be a
+// multiple of the period of the pattern
+inline void fill_pattern_scalar(
+	unsigned char *dst, std::size_t bytes, const unsigned char *pattern) {
+	std::size_t i = 0;
+	for (; i + 16 <= bytes; i += 16) {
+		std::memcpy(dst + i, pattern, 16);
+	}
+	std::memcpy(dst + i, pattern, bytes - i);
+}
+
+#ifdef FT_SIMD_X86
+inline std::size_t mismatch_bytes_sse2(
+	const unsigned char *a, const unsigned char *b, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		const __m128i x =
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+		const __m128i y =
+			_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+		const unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+		if (equal != 0xffff) {
+			return i + __builtin_ctz(~equal);
+		}
+	}
+	return i + mismatch_bytes_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline std::size_t mismatch_bytes_avx2(
+	const unsigned char *a, const unsigned char *b, std::size_t n) {
+	std::size_t i = 0;
+	for (; i + 32 <= n; i += 32) {
+		const __m256i x =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+		const __m256i y =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+		const unsigned equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+		if (equal != 0xffffffffU) {
+			return i + __builtin_ctz(~equal);
+		}
+	}
+	return i + mismatch_bytes_sse2(a + i, b + i, n - i);
+}
+
+inline void fill_pattern_sse2(
+	unsigned char *dst, std::size_t bytes, const unsigned char *pattern) {
+	const __m128i value =
+		_mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+	std::size_t i = 0;
+	for (; i + 16 <= bytes; i += 16) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), value);
+	}
+	std::memcpy(dst + i, pattern, bytes - i);
+}
+
+__attribute__((target("avx2"))) inline void fill_pattern_avx2(
+	unsigned char *dst, std::size_t bytes, const unsigned char *pattern) {
+	const __m256i value = _mm256_broadcastsi128_si256(
+		_mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern)));
+	std::size_t i = 0;
+	for (; i + 32 <= bytes; i += 32) {
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), value);
+	}
+	fill_pattern_sse2(dst + i, bytes - i, pattern);
+}
+
+inline bool cpu_has_avx2() {
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+	return has_avx2;
+}
+#endif
+
+inline std::size_t mismatch_bytes(const void *a, const void *b, std::size_t n) {
+	const unsigned char *x = static_cast<const unsigned char *>(a);
+	const unsigned char *y = static_cast<const unsigned char *>(b);
+#ifdef FT_SIMD_X86
+	return cpu_has_avx2() ? mismatch_bytes_avx2(x, y, n)
+						  : mismatch_bytes_sse2(x, y, n);
+#else
+	return mismatch_bytes_scalar(x, y, n);
+#endif
+}
+
+inline void fill_pattern(
+	void *dst, std::size_t bytes, const unsigned char *pattern) {
+	unsigned char *d = static_cast<unsigned char *>(dst);
+#ifdef FT_SIMD_X86
+	if (cpu_has_avx2()) {
+		fill_pattern_avx2(d, bytes, pattern);
+	} else {
+		fill_pattern_sse2(d, bytes, pattern);
+	}
+#else
+	fill_pattern_scalar(d, bytes, pattern);
+#endif
+}
+
+}  // namespace detail
+
+}  // namespace ft
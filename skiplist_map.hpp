@@ -0,0 +1,656 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include "algorithm.hpp"
+#include "atomic.hpp"
+#include "epoch.hpp"
+#include "functional.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "utils.hpp"
+
+namespace ft {
+
+// Skip list node. The tower of next pointers is allocated together with the
+// node, so nodes have a variable size. The low bit of next[i] marks the node
+// as deleted at level i, which freezes that link against concurrent inserts.
+template <class Value>
+struct skiplist_node {
+	union value_storage {
+		char        buffer[sizeof(Value)];
+		long double align_long_double;
+		long long   align_long_long;
+		void       *align_pointer;
+	};
+
+	value_storage  storage;
+	unsigned int   height;
+	// Inserter and deleter both drop their reference once they stopped
+	// touching the tower, the last one retires the node
+	unsigned int   links;
+	skiplist_node *next[1];
+
+	Value &value() {
+		return *reinterpret_cast<Value *>(storage.buffer);
+	}
+
+	static std::size_t bytes(unsigned int height) {
+		return sizeof(skiplist_node) + (height - 1) * sizeof(skiplist_node *);
+	}
+
+	static bool is_marked(skiplist_node *p) {
+		return reinterpret_cast<std::size_t>(p) & 1;
+	}
+
+	static skiplist_node *marked(skiplist_node *p) {
+		return reinterpret_cast<skiplist_node *>(
+			reinterpret_cast<std::size_t>(p) | 1);
+	}
+
+	static skiplist_node *unmarked(skiplist_node *p) {
+		return reinterpret_cast<skiplist_node *>(
+			reinterpret_cast<std::size_t>(p) & ~std::size_t(1));
+	}
+
+	// First node after this one that is not being deleted
+	skiplist_node *next_live() {
+		skiplist_node *n =
+			unmarked(atomic_load(&next[0], memory_order_acquire));
+
+		while (n && is_marked(atomic_load(&n->next[0], memory_order_acquire))) {
+			n = unmarked(atomic_load(&n->next[0], memory_order_acquire));
+		}
+		return n;
+	}
+};
+
+// Ordered map that supports concurrent find, insert, erase and iteration
+// from any number of threads without locks. Links are updated with CAS and
+// unlinked nodes are reclaimed through the epoch_domain, so a node stays
+// readable while any thread that could have reached it is still inside a
+// critical section. Every iterator holds such a critical section open for
+// the thread that created it: iterators must not be handed to, or destroyed
+// by, another thread.
+//
+// Unlike ft::map the iterators are forward only and mapped values are not
+// synchronized: concurrent writes through operator[] or iterators to the
+// same element are a data race. Copy, assignment, swap and the destructor
+// must not run concurrently with other operations on the same map.
+template <class Key, class T, class Compare = ft::less<Key>,
+	class Allocator = std::allocator<ft::pair<const Key, T> > >
+class skiplist_map {
+  public:
+	// types:
+	typedef Key                                 key_type;
+	typedef T                                   mapped_type;
+	typedef ft::pair<const Key, T>              value_type;
+	typedef Compare                             key_compare;
+	typedef Allocator                           allocator_type;
+	typedef typename Allocator::reference       reference;
+	typedef typename Allocator::const_reference const_reference;
+	typedef typename Allocator::pointer         pointer;
+	typedef typename Allocator::const_pointer   const_pointer;
+	typedef typename Allocator::size_type       size_type;
+	typedef typename Allocator::difference_type difference_type;
+
+  private:
+	typedef skiplist_node<value_type> node_type;
+	typedef node_type                *node_pointer;
+	typedef typename Allocator::template rebind<char>::other byte_allocator;
+
+	// With a 1/2 promotion probability 32 levels stay logarithmic far past
+	// the number of nodes that fit in memory
+	enum { max_level = 32 };
+
+  public:
+	template <bool isconst = false>
+	class skiplist_iterator {
+	  public:
+		typedef std::forward_iterator_tag   iterator_category;
+		typedef skiplist_map::value_type    value_type;
+		typedef skiplist_map::difference_type difference_type;
+		typedef skiplist_map::size_type     size_type;
+		typedef typename ft::choose<isconst, const value_type &,
+			value_type &>::type             reference;
+		typedef typename ft::choose<isconst, const value_type *,
+			value_type *>::type             pointer;
+
+		skiplist_iterator() : m_node(NULL) {}
+
+		skiplist_iterator(node_pointer node) : m_node(node) {}
+
+		skiplist_iterator(const skiplist_iterator<false> &rhs)
+			: m_node(rhs.base()) {}
+
+		skiplist_iterator &operator=(const skiplist_iterator<false> &rhs) {
+			m_node = rhs.base();
+			return *this;
+		}
+
+		reference operator*() const {
+			return m_node->value();
+		}
+
+		pointer operator->() const {
+			return &(operator*());
+		}
+
+		skiplist_iterator &operator++() {
+			m_node = m_node->next_live();
+			return *this;
+		}
+
+		skiplist_iterator operator++(int) {
+			skiplist_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		friend bool operator==(
+			const skiplist_iterator &x, const skiplist_iterator &y) {
+			return x.m_node == y.m_node;
+		}
+
+		friend bool operator!=(
+			const skiplist_iterator &x, const skiplist_iterator &y) {
+			return !(x == y);
+		}
+
+		node_pointer base() const {
+			return m_node;
+		}
+
+	  protected:
+		node_pointer m_node;
+		epoch_pin    m_pin;
+	};
+
+	typedef skiplist_iterator<false> iterator;
+	typedef skiplist_iterator<true>  const_iterator;
+
+	class value_compare
+		: public ft::binary_function<value_type, value_type, bool> {
+		friend class skiplist_map;
+
+	  protected:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+
+	  public:
+		bool operator()(const value_type &x, const value_type &y) const {
+			return comp(x.first, y.first);
+		}
+	};
+
+	// construct/copy/destroy:
+	explicit skiplist_map(const Compare &comp = Compare(),
+		const Allocator                 &allocator = Allocator())
+		: m_comp(comp), m_allocator(allocator), m_head(m_create_head()),
+		  m_size(0), m_seed(reinterpret_cast<std::size_t>(this)) {}
+	template <class InputIterator>
+	skiplist_map(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+					 InputIterator>::type first,
+		InputIterator last, const Compare &comp = Compare(),
+		const Allocator &allocator = Allocator())
+		: m_comp(comp), m_allocator(allocator), m_head(m_create_head()),
+		  m_size(0), m_seed(reinterpret_cast<std::size_t>(this)) {
+		insert(first, last);
+	}
+	skiplist_map(const skiplist_map<Key, T, Compare, Allocator> &x)
+		: m_comp(x.m_comp), m_allocator(x.m_allocator),
+		  m_head(m_create_head()), m_size(0),
+		  m_seed(reinterpret_cast<std::size_t>(this)) {
+		insert(x.begin(), x.end());
+	}
+	~skiplist_map() {
+		node_pointer n = m_head;
+
+		while (n) {
+			node_pointer next = node_type::unmarked(n->next[0]);
+			if (n != m_head) {
+				m_destroy_node(n);
+			}
+			n = next;
+		}
+		m_destroy_head(m_head);
+	}
+	skiplist_map<Key, T, Compare, Allocator> &operator=(
+		const skiplist_map<Key, T, Compare, Allocator> &x) {
+		if (this != &x) {
+			clear();
+			insert(x.begin(), x.end());
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const {
+		return m_allocator;
+	}
+
+	// iterators:
+	iterator begin() {
+		return iterator(m_head->next_live());
+	}
+
+	const_iterator begin() const {
+		return const_iterator(m_head->next_live());
+	}
+
+	iterator end() {
+		return iterator();
+	}
+
+	const_iterator end() const {
+		return const_iterator();
+	}
+
+	// capacity:
+	bool empty() const {
+		return size() == 0;
+	}
+
+	// Exact when no operation is in flight, otherwise a snapshot
+	size_type size() const {
+		return atomic_load(&m_size, memory_order_relaxed);
+	}
+
+	size_type max_size() const {
+		return byte_allocator().max_size() / node_type::bytes(2);
+	}
+
+	// element access:
+	T &operator[](const key_type &key) {
+		return insert(ft::make_pair(key, T())).first->second;
+	}
+
+	// modifiers:
+	ft::pair<iterator, bool> insert(const value_type &x) {
+		epoch_guard  guard;
+		node_pointer preds[max_level];
+		node_pointer succs[max_level];
+		node_pointer node = NULL;
+
+		while (true) {
+			if (m_find(x.first, preds, succs)) {
+				if (node) {
+					m_destroy_node(node);
+				}
+				return ft::make_pair(iterator(succs[0]), false);
+			}
+			if (node == NULL) {
+				node = m_create_node(x, m_random_height());
+			}
+			for (unsigned int level = 0; level < node->height; level++) {
+				node->next[level] = succs[level];
+			}
+			// Linking level 0 publishes the node
+			node_pointer expected = succs[0];
+			if (atomic_compare_exchange(&preds[0]->next[0], expected, node)) {
+				break;
+			}
+		}
+		atomic_fetch_add(&m_size, size_type(1), memory_order_relaxed);
+		iterator it(node);
+		m_link_upper_levels(node, preds, succs);
+		if (node_type::is_marked(atomic_load(&node->next[0]))) {
+			// Erased while we were linking: some links may have been made
+			// after the eraser cleaned up, unlink them again
+			m_find(x.first, preds, succs);
+		}
+		m_release(node);
+		return ft::make_pair(it, true);
+	}
+
+	// The hint is of no use to a skip list, the search starts at the head
+	iterator insert(iterator position, const value_type &x) {
+		(void)position;
+		return insert(x).first;
+	}
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		for (; first != last; ++first) {
+			insert(*first);
+		}
+	}
+
+	void erase(iterator position) {
+		epoch_guard guard;
+
+		m_erase_node(position.base());
+	}
+
+	size_type erase(const key_type &key) {
+		epoch_guard  guard;
+		node_pointer preds[max_level];
+		node_pointer succs[max_level];
+
+		if (!m_find(key, preds, succs)) {
+			return 0;
+		}
+		return m_erase_node(succs[0]) ? 1 : 0;
+	}
+
+	void erase(iterator first, iterator last) {
+		while (first != last) {
+			erase(first++);
+		}
+	}
+
+	void swap(skiplist_map<Key, T, Compare, Allocator> &x) {
+		ft::swap(m_comp, x.m_comp);
+		ft::swap(m_allocator, x.m_allocator);
+		ft::swap(m_head, x.m_head);
+		ft::swap(m_size, x.m_size);
+	}
+
+	// Safe to call concurrently, erases the nodes one at a time
+	void clear() {
+		epoch_guard  guard;
+		node_pointer node;
+
+		while ((node = m_head->next_live()) != NULL) {
+			m_erase_node(node);
+		}
+	}
+
+	// observers:
+	key_compare key_comp() const {
+		return m_comp;
+	}
+	value_compare value_comp() const {
+		return value_compare(m_comp);
+	}
+
+	// map operations:
+	iterator find(const key_type &key) {
+		epoch_guard  guard;
+		node_pointer node = m_search(key, false);
+
+		return iterator(
+			node && !m_comp(key, node->value().first) ? node : NULL);
+	}
+
+	const_iterator find(const key_type &key) const {
+		epoch_guard  guard;
+		node_pointer node = m_search(key, false);
+
+		return const_iterator(
+			node && !m_comp(key, node->value().first) ? node : NULL);
+	}
+
+	size_type count(const key_type &key) const {
+		return find(key) != end() ? 1 : 0;
+	}
+
+	iterator lower_bound(const key_type &key) {
+		epoch_guard guard;
+
+		return iterator(m_search(key, false));
+	}
+
+	const_iterator lower_bound(const key_type &key) const {
+		epoch_guard guard;
+
+		return const_iterator(m_search(key, false));
+	}
+
+	iterator upper_bound(const key_type &key) {
+		epoch_guard guard;
+
+		return iterator(m_search(key, true));
+	}
+
+	const_iterator upper_bound(const key_type &key) const {
+		epoch_guard guard;
+
+		return const_iterator(m_search(key, true));
+	}
+
+	ft::pair<iterator, iterator> equal_range(const key_type &key) {
+		return ft::make_pair(lower_bound(key), upper_bound(key));
+	}
+
+	ft::pair<const_iterator, const_iterator> equal_range(
+		const key_type &key) const {
+		return ft::make_pair(lower_bound(key), upper_bound(key));
+	}
+
+  private:
+	key_compare    m_comp;
+	allocator_type m_allocator;
+	node_pointer   m_head;
+	size_type      m_size;
+	std::size_t    m_seed;
+
+	unsigned int m_random_height() {
+		// splitmix64 over a shared counter, good enough to decorrelate
+		// heights drawn by concurrent inserters
+		unsigned long long x = atomic_fetch_add(&m_seed,
+			std::size_t(0x9E3779B97F4A7C15ULL), memory_order_relaxed);
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+		x ^= x >> 31;
+
+		unsigned int height = 1;
+		while ((x & 1) && height < max_level) {
+			height++;
+			x >>= 1;
+		}
+		return height;
+	}
+
+	node_pointer m_create_head() {
+		node_pointer head = reinterpret_cast<node_pointer>(
+			byte_allocator(m_allocator).allocate(node_type::bytes(max_level)));
+		head->height = max_level;
+		head->links = 0;
+		for (unsigned int level = 0; level < max_level; level++) {
+			head->next[level] = NULL;
+		}
+		return head;
+	}
+
+	void m_destroy_head(node_pointer head) {
+		byte_allocator(m_allocator)
+			.deallocate(reinterpret_cast<char *>(head),
+				node_type::bytes(max_level));
+	}
+
+	node_pointer m_create_node(const value_type &x, unsigned int height) {
+		node_pointer node = reinterpret_cast<node_pointer>(
+			byte_allocator(m_allocator).allocate(node_type::bytes(height)));
+		try {
+			m_allocator.construct(&node->value(), x);
+		} catch (...) {
+			byte_allocator(m_allocator)
+				.deallocate(reinterpret_cast<char *>(node),
+					node_type::bytes(height));
+			throw;
+		}
+		node->height = height;
+		node->links = 2;
+		return node;
+	}
+
+	// Static so that the epoch domain can free a node after its map is gone
+	static void m_destroy_node(void *p) {
+		node_pointer node = static_cast<node_pointer>(p);
+
+		allocator_type().destroy(&node->value());
+		byte_allocator().deallocate(
+			reinterpret_cast<char *>(node), node_type::bytes(node->height));
+	}
+
+	void m_release(node_pointer node) {
+		if (atomic_fetch_sub(&node->links, 1U, memory_order_acq_rel) == 1) {
+			epoch_domain::retire(node, &skiplist_map::m_destroy_node);
+		}
+	}
+
+	// Fills preds and succs with the last node less than key and the first
+	// node not less than key at each level, unlinking the marked nodes met
+	// on the way. Returns true if succs[0] holds key.
+	bool m_find(const key_type &key, node_pointer *preds, node_pointer *succs) {
+		bool restart = true;
+
+		while (restart) {
+			restart = false;
+			node_pointer pred = m_head;
+			for (int level = max_level - 1; level >= 0 && !restart; level--) {
+				node_pointer curr = node_type::unmarked(
+					atomic_load(&pred->next[level], memory_order_acquire));
+				while (curr) {
+					node_pointer succ =
+						atomic_load(&curr->next[level], memory_order_acquire);
+					if (node_type::is_marked(succ)) {
+						node_pointer expected = curr;
+						if (!atomic_compare_exchange(&pred->next[level],
+								expected, node_type::unmarked(succ))) {
+							restart = true;
+							break;
+						}
+						curr = node_type::unmarked(succ);
+					} else if (m_comp(curr->value().first, key)) {
+						pred = curr;
+						curr = succ;
+					} else {
+						break;
+					}
+				}
+				preds[level] = pred;
+				succs[level] = curr;
+			}
+		}
+		return succs[0] && !m_comp(key, succs[0]->value().first);
+	}
+
+	// Read only search skipping over the marked nodes: first node not less
+	// than key, or greater than key if strict
+	node_pointer m_search(const key_type &key, bool strict) const {
+		node_pointer pred = m_head;
+		node_pointer curr = NULL;
+
+		for (int level = max_level - 1; level >= 0; level--) {
+			curr = node_type::unmarked(
+				atomic_load(&pred->next[level], memory_order_acquire));
+			while (curr) {
+				node_pointer succ =
+					atomic_load(&curr->next[level], memory_order_acquire);
+				if (node_type::is_marked(succ)) {
+					curr = node_type::unmarked(succ);
+				} else if (strict ? !m_comp(key, curr->value().first)
+								  : m_comp(curr->value().first, key)) {
+					pred = curr;
+					curr = succ;
+				} else {
+					break;
+				}
+			}
+		}
+		return curr;
+	}
+
+	// Links node above level 0. Gives up as soon as the node is marked,
+	// an eraser owns it from then on.
+	void m_link_upper_levels(
+		node_pointer node, node_pointer *preds, node_pointer *succs) {
+		for (unsigned int level = 1; level < node->height; level++) {
+			while (true) {
+				node_pointer succ = succs[level];
+				node_pointer own = atomic_load(&node->next[level]);
+				if (node_type::is_marked(own)) {
+					return;
+				}
+				if (own != succ
+					&& !atomic_compare_exchange(
+						&node->next[level], own, succ)) {
+					return;
+				}
+				node_pointer expected = succ;
+				if (atomic_compare_exchange(
+						&preds[level]->next[level], expected, node)) {
+					break;
+				}
+				if (!m_find(node->value().first, preds, succs)
+					|| succs[0] != node) {
+					return;
+				}
+			}
+		}
+	}
+
+	// Marks the tower top down, whoever marks level 0 erased the node.
+	// Returns false if another thread got there first.
+	bool m_erase_node(node_pointer node) {
+		for (int level = node->height - 1; level > 0; level--) {
+			node_pointer succ = atomic_load(&node->next[level]);
+			while (!node_type::is_marked(succ)
+				   && !atomic_compare_exchange(&node->next[level], succ,
+					   node_type::marked(succ))) {
+			}
+		}
+		node_pointer succ = atomic_load(&node->next[0]);
+		while (true) {
+			if (node_type::is_marked(succ)) {
+				return false;
+			}
+			if (atomic_compare_exchange(
+					&node->next[0], succ, node_type::marked(succ))) {
+				break;
+			}
+		}
+		node_pointer preds[max_level];
+		node_pointer succs[max_level];
+		m_find(node->value().first, preds, succs);
+		atomic_fetch_sub(&m_size, size_type(1), memory_order_relaxed);
+		m_release(node);
+		return true;
+	}
+};
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator==(const skiplist_map<Key, T, Compare, Allocator> &x,
+	const skiplist_map<Key, T, Compare, Allocator> &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator!=(const skiplist_map<Key, T, Compare, Allocator> &x,
+	const skiplist_map<Key, T, Compare, Allocator> &y) {
+	return !(x == y);
+}
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator<(const skiplist_map<Key, T, Compare, Allocator> &x,
+	const skiplist_map<Key, T, Compare, Allocator> &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator>(const skiplist_map<Key, T, Compare, Allocator> &x,
+	const skiplist_map<Key, T, Compare, Allocator> &y) {
+	return y < x;
+}
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator<=(const skiplist_map<Key, T, Compare, Allocator> &x,
+	const skiplist_map<Key, T, Compare, Allocator> &y) {
+	return !(y < x);
+}
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator>=(const skiplist_map<Key, T, Compare, Allocator> &x,
+	const skiplist_map<Key, T, Compare, Allocator> &y) {
+	return !(x < y);
+}
+
+// specialized algorithms:
+template <class Key, class T, class Compare, class Allocator>
+void swap(skiplist_map<Key, T, Compare, Allocator> &x,
+	skiplist_map<Key, T, Compare, Allocator> &y) {
+	x.swap(y);
+}
+
+}  // namespace ft
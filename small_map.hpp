@@ -0,0 +1,553 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "map.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "utils.hpp"
+
+namespace ft {
+
+// Ordered map that keeps up to N entries in a sorted array inside the object
+// and only moves them into an ft::map once the N + 1th key is inserted.
+// shrink_to_fit() and clear() move a promoted map back to inline storage.
+template <class Key, class T, std::size_t N = 8,
+	class Compare = ft::less<Key>,
+	class Allocator = std::allocator<ft::pair<const Key, T> > >
+class small_map {
+  public:
+	// types:
+	typedef Key                                 key_type;
+	typedef T                                   mapped_type;
+	typedef ft::pair<const Key, T>              value_type;
+	typedef Compare                             key_compare;
+	typedef Allocator                           allocator_type;
+	typedef typename Allocator::reference       reference;
+	typedef typename Allocator::const_reference const_reference;
+	typedef typename Allocator::pointer         pointer;
+	typedef typename Allocator::const_pointer   const_pointer;
+
+  private:
+	typedef ft::map<Key, T, Compare, Allocator> map_type;
+
+	// Raw storage for the inline elements, the union members only force
+	// an alignment suitable for any value_type
+	union inline_storage {
+		char        buffer[N * sizeof(value_type)];
+		long double align_long_double;
+		long long   align_long_long;
+		void       *align_pointer;
+	};
+
+  public:
+	// types:
+	typedef typename map_type::size_type       size_type;
+	typedef typename map_type::difference_type difference_type;
+
+	template <bool isconst = false>
+	class small_map_iterator {
+	  public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef small_map::value_type           value_type;
+		typedef small_map::difference_type      difference_type;
+		typedef small_map::size_type            size_type;
+		typedef typename ft::choose<isconst, const value_type &,
+			value_type &>::type                 reference;
+		typedef typename ft::choose<isconst, const value_type *,
+			value_type *>::type                 pointer;
+		typedef typename ft::choose<isconst, typename map_type::const_iterator,
+			typename map_type::iterator>::type  map_iterator;
+
+		small_map_iterator() : m_current(NULL), m_it(), m_inline(true) {}
+
+		small_map_iterator(pointer current)
+			: m_current(current), m_it(), m_inline(true) {}
+
+		small_map_iterator(map_iterator it)
+			: m_current(NULL), m_it(it), m_inline(false) {}
+
+		small_map_iterator(const small_map_iterator<false> &rhs)
+			: m_current(rhs.inline_base()), m_it(rhs.map_base()),
+			  m_inline(rhs.is_inline()) {}
+
+		small_map_iterator &operator=(const small_map_iterator<false> &rhs) {
+			m_current = rhs.inline_base();
+			m_it = rhs.map_base();
+			m_inline = rhs.is_inline();
+			return *this;
+		}
+
+		reference operator*() const {
+			return m_inline ? *m_current : *m_it;
+		}
+
+		pointer operator->() const {
+			return &(operator*());
+		}
+
+		small_map_iterator &operator++() {
+			if (m_inline) {
+				++m_current;
+			} else {
+				++m_it;
+			}
+			return *this;
+		}
+
+		small_map_iterator operator++(int) {
+			small_map_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		small_map_iterator &operator--() {
+			if (m_inline) {
+				--m_current;
+			} else {
+				--m_it;
+			}
+			return *this;
+		}
+
+		small_map_iterator operator--(int) {
+			small_map_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		friend bool operator==(
+			const small_map_iterator &x, const small_map_iterator &y) {
+			return x.m_inline ? x.m_current == y.m_current : x.m_it == y.m_it;
+		}
+
+		friend bool operator!=(
+			const small_map_iterator &x, const small_map_iterator &y) {
+			return !(x == y);
+		}
+
+		pointer inline_base() const {
+			return m_current;
+		}
+
+		map_iterator map_base() const {
+			return m_it;
+		}
+
+		bool is_inline() const {
+			return m_inline;
+		}
+
+	  protected:
+		pointer      m_current;
+		map_iterator m_it;
+		bool         m_inline;
+	};
+
+	typedef small_map_iterator<false>            iterator;
+	typedef small_map_iterator<true>             const_iterator;
+	typedef ft::reverse_iterator<iterator>       reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	class value_compare
+		: public ft::binary_function<value_type, value_type, bool> {
+		friend class small_map;
+
+	  protected:
+		Compare comp;
+		value_compare(Compare c) : comp(c) {}
+
+	  public:
+		bool operator()(const value_type &x, const value_type &y) const {
+			return comp(x.first, y.first);
+		}
+	};
+
+	// construct/copy/destroy:
+	explicit small_map(const Compare &comp = Compare(),
+		const Allocator              &allocator = Allocator())
+		: m_allocator(allocator), m_key_compare(comp), m_size(0),
+		  m_promoted(false), m_map(comp, allocator) {}
+	template <class InputIterator>
+	small_map(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+				  InputIterator>::type first,
+		InputIterator last, const Compare &comp = Compare(),
+		const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_key_compare(comp), m_size(0),
+		  m_promoted(false), m_map(comp, allocator) {
+		insert(first, last);
+	}
+	small_map(const small_map<Key, T, N, Compare, Allocator> &x)
+		: m_allocator(x.m_allocator), m_key_compare(x.m_key_compare),
+		  m_size(0), m_promoted(x.m_promoted), m_map(x.m_map) {
+		m_copy_inline(x);
+	}
+	~small_map() {
+		m_destroy_inline();
+	}
+	small_map<Key, T, N, Compare, Allocator> &operator=(
+		const small_map<Key, T, N, Compare, Allocator> &x) {
+		if (this != &x) {
+			m_destroy_inline();
+			m_key_compare = x.m_key_compare;
+			m_map = x.m_map;
+			m_promoted = x.m_promoted;
+			m_copy_inline(x);
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const {
+		return m_allocator;
+	}
+
+	// iterators:
+	iterator begin() {
+		return m_promoted ? iterator(m_map.begin()) : iterator(m_data());
+	}
+
+	const_iterator begin() const {
+		return m_promoted ? const_iterator(m_map.begin())
+						  : const_iterator(m_data());
+	}
+
+	iterator end() {
+		return m_promoted ? iterator(m_map.end()) : iterator(m_data() + m_size);
+	}
+
+	const_iterator end() const {
+		return m_promoted ? const_iterator(m_map.end())
+						  : const_iterator(m_data() + m_size);
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity:
+	bool empty() const {
+		return size() == 0;
+	}
+
+	size_type size() const {
+		return m_promoted ? m_map.size() : m_size;
+	}
+
+	size_type max_size() const {
+		return m_map.max_size();
+	}
+
+	// Returns true while the elements live in the inline array
+	bool is_inline() const {
+		return !m_promoted;
+	}
+
+	// Moves the elements back to inline storage if they fit
+	void shrink_to_fit() {
+		if (!m_promoted || m_map.size() > N) {
+			return;
+		}
+		m_demote();
+	}
+
+	// element access:
+	T &operator[](const key_type &key) {
+		return insert(ft::make_pair(key, T())).first->second;
+	}
+
+	// modifiers:
+	ft::pair<iterator, bool> insert(const value_type &x) {
+		if (m_promoted) {
+			return m_map.insert(x);
+		}
+		size_type pos = m_lower_bound_index(x.first);
+		if (pos != m_size && !m_key_compare(x.first, m_data()[pos].first)) {
+			return ft::make_pair(iterator(m_data() + pos), false);
+		}
+		if (m_size == N) {
+			m_promote();
+			return m_map.insert(x);
+		}
+		m_shift_right(pos);
+		m_allocator.construct(m_data() + pos, x);
+		++m_size;
+		return ft::make_pair(iterator(m_data() + pos), true);
+	}
+
+	iterator insert(iterator position, const value_type &x) {
+		if (m_promoted && !position.is_inline()) {
+			return m_map.insert(position.map_base(), x);
+		}
+		return insert(x).first;
+	}
+
+	template <class InputIterator>
+	void insert(InputIterator first, InputIterator last) {
+		while (first != last) {
+			insert(*first++);
+		}
+	}
+
+	void erase(iterator position) {
+		if (m_promoted) {
+			m_map.erase(position.map_base());
+			return;
+		}
+		m_erase_index(position.inline_base() - m_data());
+	}
+
+	size_type erase(const key_type &key) {
+		if (m_promoted) {
+			return m_map.erase(key);
+		}
+		size_type pos = m_lower_bound_index(key);
+		if (pos == m_size || m_key_compare(key, m_data()[pos].first)) {
+			return 0;
+		}
+		m_erase_index(pos);
+		return 1;
+	}
+
+	void erase(iterator first, iterator last) {
+		if (m_promoted) {
+			m_map.erase(first.map_base(), last.map_base());
+			return;
+		}
+		size_type n = last.inline_base() - first.inline_base();
+		while (n--) {
+			m_erase_index(first.inline_base() - m_data());
+		}
+	}
+
+	void swap(small_map<Key, T, N, Compare, Allocator> &x) {
+		if (m_promoted && x.m_promoted) {
+			m_map.swap(x.m_map);
+			ft::swap(m_key_compare, x.m_key_compare);
+			return;
+		}
+		small_map<Key, T, N, Compare, Allocator> tmp(x);
+		x = *this;
+		*this = tmp;
+	}
+
+	void clear() {
+		m_destroy_inline();
+		m_map.clear();
+		m_promoted = false;
+	}
+
+	// observers:
+	key_compare key_comp() const {
+		return m_key_compare;
+	}
+
+	value_compare value_comp() const {
+		return value_compare(m_key_compare);
+	}
+
+	// map operations:
+	iterator find(const key_type &key) {
+		if (m_promoted) {
+			return m_map.find(key);
+		}
+		size_type pos = m_lower_bound_index(key);
+		if (pos == m_size || m_key_compare(key, m_data()[pos].first)) {
+			return end();
+		}
+		return iterator(m_data() + pos);
+	}
+
+	const_iterator find(const key_type &key) const {
+		if (m_promoted) {
+			return m_map.find(key);
+		}
+		size_type pos = m_lower_bound_index(key);
+		if (pos == m_size || m_key_compare(key, m_data()[pos].first)) {
+			return end();
+		}
+		return const_iterator(m_data() + pos);
+	}
+
+	size_type count(const key_type &key) const {
+		return find(key) == end() ? 0 : 1;
+	}
+
+	iterator lower_bound(const key_type &key) {
+		if (m_promoted) {
+			return m_map.lower_bound(key);
+		}
+		return iterator(m_data() + m_lower_bound_index(key));
+	}
+
+	const_iterator lower_bound(const key_type &key) const {
+		if (m_promoted) {
+			return m_map.lower_bound(key);
+		}
+		return const_iterator(m_data() + m_lower_bound_index(key));
+	}
+
+	iterator upper_bound(const key_type &key) {
+		if (m_promoted) {
+			return m_map.upper_bound(key);
+		}
+		return iterator(m_data() + m_upper_bound_index(key));
+	}
+
+	const_iterator upper_bound(const key_type &key) const {
+		if (m_promoted) {
+			return m_map.upper_bound(key);
+		}
+		return const_iterator(m_data() + m_upper_bound_index(key));
+	}
+
+	ft::pair<iterator, iterator> equal_range(const key_type &key) {
+		return ft::make_pair(lower_bound(key), upper_bound(key));
+	}
+
+	ft::pair<const_iterator, const_iterator> equal_range(
+		const key_type &key) const {
+		return ft::make_pair(lower_bound(key), upper_bound(key));
+	}
+
+  private:
+	allocator_type m_allocator;
+	key_compare    m_key_compare;
+	inline_storage m_storage;
+	size_type      m_size;
+	bool           m_promoted;
+	map_type       m_map;
+
+	value_type *m_data() {
+		return reinterpret_cast<value_type *>(m_storage.buffer);
+	}
+
+	const value_type *m_data() const {
+		return reinterpret_cast<const value_type *>(m_storage.buffer);
+	}
+
+	// For the handful of inline entries a linear scan beats a binary
+	// search, it is branch predictable and walks a single cache line or two
+	size_type m_lower_bound_index(const key_type &key) const {
+		size_type i = 0;
+		while (i < m_size && m_key_compare(m_data()[i].first, key)) {
+			++i;
+		}
+		return i;
+	}
+
+	size_type m_upper_bound_index(const key_type &key) const {
+		size_type i = m_lower_bound_index(key);
+		if (i < m_size && !m_key_compare(key, m_data()[i].first)) {
+			++i;
+		}
+		return i;
+	}
+
+	// The keys are const, so elements are moved by copy construction
+	// followed by destruction instead of assignment
+	void m_shift_right(size_type pos) {
+		for (size_type i = m_size; i > pos; --i) {
+			m_allocator.construct(m_data() + i, m_data()[i - 1]);
+			m_allocator.destroy(m_data() + i - 1);
+		}
+	}
+
+	void m_erase_index(size_type pos) {
+		m_allocator.destroy(m_data() + pos);
+		for (size_type i = pos; i + 1 < m_size; ++i) {
+			m_allocator.construct(m_data() + i, m_data()[i + 1]);
+			m_allocator.destroy(m_data() + i + 1);
+		}
+		--m_size;
+	}
+
+	void m_copy_inline(const small_map<Key, T, N, Compare, Allocator> &x) {
+		for (size_type i = 0; i < x.m_size; ++i) {
+			m_allocator.construct(m_data() + i, x.m_data()[i]);
+		}
+		m_size = x.m_size;
+	}
+
+	void m_destroy_inline() {
+		for (size_type i = 0; i < m_size; ++i) {
+			m_allocator.destroy(m_data() + i);
+		}
+		m_size = 0;
+	}
+
+	void m_promote() {
+		for (size_type i = 0; i < m_size; ++i) {
+			m_map.insert(m_map.end(), m_data()[i]);
+		}
+		m_destroy_inline();
+		m_promoted = true;
+	}
+
+	void m_demote() {
+		typename map_type::const_iterator it = m_map.begin();
+		for (; it != m_map.end(); ++it) {
+			m_allocator.construct(m_data() + m_size++, *it);
+		}
+		m_map.clear();
+		m_promoted = false;
+	}
+};
+
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+bool operator==(const small_map<Key, T, N, Compare, Allocator> &x,
+	const small_map<Key, T, N, Compare, Allocator>             &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+bool operator!=(const small_map<Key, T, N, Compare, Allocator> &x,
+	const small_map<Key, T, N, Compare, Allocator>             &y) {
+	return !(x == y);
+}
+
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+bool operator<(const small_map<Key, T, N, Compare, Allocator> &x,
+	const small_map<Key, T, N, Compare, Allocator>            &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+bool operator>(const small_map<Key, T, N, Compare, Allocator> &x,
+	const small_map<Key, T, N, Compare, Allocator>            &y) {
+	return y < x;
+}
+
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+bool operator<=(const small_map<Key, T, N, Compare, Allocator> &x,
+	const small_map<Key, T, N, Compare, Allocator>             &y) {
+	return !(y < x);
+}
+
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+bool operator>=(const small_map<Key, T, N, Compare, Allocator> &x,
+	const small_map<Key, T, N, Compare, Allocator>             &y) {
+	return !(x < y);
+}
+
+// specialized algorithms:
+template <class Key, class T, std::size_t N, class Compare, class Allocator>
+void swap(small_map<Key, T, N, Compare, Allocator> &x,
+	small_map<Key, T, N, Compare, Allocator>       &y) {
+	x.swap(y);
+}
+
+}  // namespace ft
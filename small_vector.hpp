@@ -0,0 +1,529 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201103L
+#	include <type_traits>
+#endif
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// Vector that keeps up to N elements in an array inside the object and only
+// allocates once the N + 1th element is added. Iterators are invalidated by
+// swap() as well when the elements are inline, since they move with the
+// object. shrink_to_fit() moves them back inline if they fit.
+template <class T, std::size_t N = 16, class Allocator = std::allocator<T> >
+class small_vector {
+  public:
+	// types
+	typedef typename Allocator::reference        reference;
+	typedef typename Allocator::const_reference  const_reference;
+	typedef typename Allocator::pointer          iterator;
+	typedef typename Allocator::const_pointer    const_iterator;
+	typedef typename Allocator::size_type        size_type;
+	typedef typename Allocator::difference_type  difference_type;
+	typedef T                                    value_type;
+	typedef Allocator                            allocator_type;
+	typedef typename Allocator::pointer          pointer;
+	typedef typename Allocator::const_pointer    const_pointer;
+	typedef ft::reverse_iterator<iterator>       reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  private:
+	// Raw storage for the inline elements, the union members only force
+	// an alignment suitable for any value_type
+	union inline_storage {
+		char        buffer[N * sizeof(T)];
+		long double align_long_double;
+		long long   align_long_long;
+		void       *align_pointer;
+	};
+
+  public:
+	// constructor/copy/destroy
+	explicit small_vector(const Allocator &allocator = Allocator())
+		: m_allocator(allocator) {
+		m_reset_inline();
+	}
+	explicit small_vector(size_type n, const T &value = T(),
+		const Allocator &allocator = Allocator())
+		: m_allocator(allocator) {
+		m_reset_inline();
+		assign(n, value);
+	}
+	template <class InputIterator>
+	small_vector(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+					 InputIterator>::type first,
+		InputIterator last, const Allocator &allocator = Allocator())
+		: m_allocator(allocator) {
+		m_reset_inline();
+		assign(first, last);
+	}
+	small_vector(const small_vector<T, N, Allocator> &x)
+		: m_allocator(x.m_allocator) {
+		m_reset_inline();
+		assign(x.begin(), x.end());
+	}
+	~small_vector() {
+		clear();
+		m_release();
+	}
+	small_vector<T, N, Allocator> &operator=(
+		const small_vector<T, N, Allocator> &x) {
+		if (this != &x) {
+			assign(x.begin(), x.end());
+		}
+		return *this;
+	}
+#if __cplusplus >= 201103L
+	// Inline elements are moved one by one, so these cannot throw when T's
+	// move constructor cannot
+	small_vector(small_vector<T, N, Allocator> &&x) noexcept(
+		std::is_nothrow_move_constructible<T>::value)
+		: m_allocator(x.m_allocator) {
+		m_reset_inline();
+		m_take(x);
+	}
+	small_vector<T, N, Allocator> &operator=(
+		small_vector<T, N, Allocator> &&x) noexcept(
+		std::is_nothrow_move_constructible<T>::value) {
+		if (this != &x) {
+			clear();
+			m_release();
+			m_reset_inline();
+			m_take(x);
+		}
+		return *this;
+	}
+#endif
+
+	void assign(size_type n, const T &u) {
+		const T value = u;
+		clear();
+		reserve(n);
+		ft::uninitialized_fill_n(m_begin, n, value, m_allocator);
+		m_end = m_begin + n;
+	}
+
+	template <class InputIterator>
+	void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+					InputIterator>::type first,
+		InputIterator                    last) {
+		clear();
+		m_range_insert(m_end, first, last,
+			typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	allocator_type get_allocator() const {
+		return m_allocator;
+	}
+
+	// iterators
+	iterator begin() {
+		return m_begin;
+	}
+
+	const_iterator begin() const {
+		return m_begin;
+	}
+
+	iterator end() {
+		return m_end;
+	}
+
+	const_iterator end() const {
+		return m_end;
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type size() const {
+		return m_end - m_begin;
+	}
+
+	size_type max_size() const {
+		return m_allocator.max_size();
+	}
+
+	void resize(size_type n, T val = T()) {
+		if (n < size()) {
+			ft::destroy(m_begin + n, m_end, m_allocator);
+			m_end = m_begin + n;
+		} else if (n > size()) {
+			if (n > capacity()) {
+				m_grow(n - size());
+			}
+			ft::uninitialized_fill(m_end, m_begin + n, val, m_allocator);
+			m_end = m_begin + n;
+		}
+	}
+
+	size_type capacity() const {
+		return m_end_of_storage - m_begin;
+	}
+
+	bool empty() const {
+		return m_begin == m_end;
+	}
+
+	void reserve(size_type n) {
+		if (n <= capacity()) {
+			return;
+		} else if (n > max_size()) {
+			throw std::length_error(
+				std::string("small_vector: reserve: n > max_size"));
+		}
+		m_relocate(n);
+	}
+
+	// Returns true while the elements live in the inline array
+	bool is_inline() const {
+		return m_begin == m_inline_data();
+	}
+
+	// Moves the elements back to inline storage if they fit, releases the
+	// unused capacity otherwise
+	void shrink_to_fit() {
+		if (!is_inline() && size() != capacity()) {
+			m_relocate(size());
+		}
+	}
+
+	// element access
+	reference operator[](size_type n) {
+		return m_begin[n];
+	}
+
+	const_reference operator[](size_type n) const {
+		return m_begin[n];
+	}
+
+	reference at(size_type n) {
+		if (n >= size()) {
+			throw std::out_of_range(
+				std::string("small_vector: index out of range"));
+		}
+		return m_begin[n];
+	}
+
+	const_reference at(size_type n) const {
+		if (n >= size()) {
+			throw std::out_of_range(
+				std::string("small_vector: index out of range"));
+		}
+		return m_begin[n];
+	}
+
+	reference front() {
+		return *m_begin;
+	}
+
+	const_reference front() const {
+		return *m_begin;
+	}
+
+	reference back() {
+		return *(m_end - 1);
+	}
+
+	const_reference back() const {
+		return *(m_end - 1);
+	}
+
+	// modifiers
+	void push_back(const T &x) {
+		if (m_end == m_end_of_storage) {
+			// x may be an element about to be moved
+			const T value = x;
+			m_grow(1);
+			m_allocator.construct(m_end, value);
+		} else {
+			m_allocator.construct(m_end, x);
+		}
+		++m_end;
+	}
+
+#if __cplusplus >= 201103L
+	void push_back(T &&x) {
+		emplace_back(std::move(x));
+	}
+
+	template <class... Args>
+	reference emplace_back(Args &&...args) {
+		if (m_end == m_end_of_storage) {
+			T value(std::forward<Args>(args)...);
+			m_grow(1);
+			m_allocator.construct(m_end, std::move(value));
+		} else {
+			m_allocator.construct(m_end, std::forward<Args>(args)...);
+		}
+		++m_end;
+		return back();
+	}
+#endif
+
+	void pop_back() {
+		--m_end;
+		m_allocator.destroy(m_end);
+	}
+
+	iterator insert(iterator position, const T &x) {
+		const size_type n = position - m_begin;
+		insert(position, 1, x);
+		return m_begin + n;
+	}
+
+	void insert(iterator position, size_type count, const T &x) {
+		const T         value = x;
+		const size_type offset = position - m_begin;
+		m_open_gap(offset, count);
+		ft::uninitialized_fill_n(m_begin + offset, count, value, m_allocator);
+		m_end += count;
+	}
+
+	template <class InputIterator>
+	void insert(iterator position,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			InputIterator>::type first,
+		InputIterator            last) {
+		m_range_insert(position, first, last,
+			typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	iterator erase(iterator position) {
+		return erase(position, position + 1);
+	}
+
+	iterator erase(iterator first, iterator last) {
+		// Moving the tail onto itself would empty moved-from elements
+		if (first == last) {
+			return first;
+		}
+		const iterator dst = ft::move(last, m_end, first);
+		ft::destroy(dst, m_end, m_allocator);
+		m_end = dst;
+		return first;
+	}
+
+	// Exchanges the heap blocks when both vectors have one, the elements
+	// themselves otherwise
+	void swap(small_vector<T, N, Allocator> &x) {
+		if (!is_inline() && !x.is_inline()) {
+			ft::swap(m_begin, x.m_begin);
+			ft::swap(m_end, x.m_end);
+			ft::swap(m_end_of_storage, x.m_end_of_storage);
+		} else if (!is_inline() || !x.is_inline()) {
+			small_vector<T, N, Allocator> &on_heap = is_inline() ? x : *this;
+			small_vector<T, N, Allocator> &in_place = is_inline() ? *this : x;
+			const iterator                 begin = on_heap.m_begin;
+			const iterator                 end = on_heap.m_end;
+			const iterator                 end_of_storage =
+				on_heap.m_end_of_storage;
+			on_heap.m_reset_inline();
+			on_heap.m_end = ft::uninitialized_move_if_noexcept(in_place.m_begin,
+				in_place.m_end, on_heap.m_begin, m_allocator);
+			in_place.clear();
+			in_place.m_begin = begin;
+			in_place.m_end = end;
+			in_place.m_end_of_storage = end_of_storage;
+		} else {
+			const bool                     x_longer = size() < x.size();
+			small_vector<T, N, Allocator> &longer = x_longer ? x : *this;
+			small_vector<T, N, Allocator> &shorter = x_longer ? *this : x;
+			const size_type                common = shorter.size();
+			for (size_type i = 0; i < common; i++) {
+				ft::swap(m_begin[i], x.m_begin[i]);
+			}
+			shorter.m_end = ft::uninitialized_move_if_noexcept(
+				longer.m_begin + common, longer.m_end, shorter.m_end,
+				m_allocator);
+			ft::destroy(longer.m_begin + common, longer.m_end, m_allocator);
+			longer.m_end = longer.m_begin + common;
+		}
+		ft::swap(m_allocator, x.m_allocator);
+	}
+
+	void clear() {
+		ft::destroy(m_begin, m_end, m_allocator);
+		m_end = m_begin;
+	}
+
+  private:
+	allocator_type m_allocator;
+	iterator       m_begin;
+	iterator       m_end;
+	iterator       m_end_of_storage;
+	inline_storage m_storage;
+
+	pointer m_inline_data() {
+		return reinterpret_cast<pointer>(m_storage.buffer);
+	}
+
+	const_pointer m_inline_data() const {
+		return reinterpret_cast<const_pointer>(m_storage.buffer);
+	}
+
+	void m_reset_inline() {
+		m_begin = m_inline_data();
+		m_end = m_begin;
+		m_end_of_storage = m_begin + N;
+	}
+
+	// Frees the heap block, the elements must have been destroyed
+	void m_release() {
+		if (!is_inline()) {
+			m_allocator.deallocate(m_begin, capacity());
+		}
+	}
+
+	// Makes room for n more elements, growing like ft::vector
+	void m_grow(size_type n) {
+		if (max_size() - size() < n) {
+			throw std::length_error(
+				std::string("small_vector: capacity: size() + n > max_size"));
+		}
+		const size_type len =
+			vector_growth_2x::next_capacity(size(), n, sizeof(T));
+		m_relocate((len < size() + n || len > max_size()) ? max_size() : len);
+	}
+
+	// Moves the elements to inline storage when new_capacity fits in it, to
+	// a heap block of new_capacity otherwise
+	void m_relocate(size_type new_capacity) {
+		const bool     to_inline = new_capacity <= N;
+		const iterator new_begin = to_inline
+			? m_inline_data()
+			: m_allocator.allocate(new_capacity, this);
+		if (new_begin == m_begin) {
+			return;
+		}
+		const size_type old_capacity = capacity();
+		const bool      was_inline = is_inline();
+		const iterator  new_end = ft::uninitialized_move_if_noexcept(
+			 m_begin, m_end, new_begin, m_allocator);
+		clear();
+		if (!was_inline) {
+			m_allocator.deallocate(m_begin, old_capacity);
+		}
+		m_begin = new_begin;
+		m_end = new_end;
+		m_end_of_storage = m_begin + (to_inline ? N : new_capacity);
+	}
+
+	// Shifts the elements from offset on count places to the right, leaving
+	// count uninitialized slots at offset. m_end is not updated.
+	void m_open_gap(size_type offset, size_type count) {
+		if (size() + count > capacity()) {
+			m_grow(count);
+		}
+		for (iterator it = m_end; it != m_begin + offset;) {
+			--it;
+			m_allocator.construct(it + count, FT_MOVE(*it));
+			m_allocator.destroy(it);
+		}
+	}
+
+	// Input iterators can only be read once, they are appended one at a
+	// time and rotated into place
+	template <class InputIterator>
+	void m_range_insert(iterator position, InputIterator first,
+		InputIterator last, std::input_iterator_tag) {
+		const size_type offset = position - m_begin;
+		const size_type old_size = size();
+		for (; first != last; ++first) {
+			push_back(*first);
+		}
+		ft::rotate(m_begin + offset, m_begin + old_size, m_end);
+	}
+
+	template <class ForwardIterator>
+	void m_range_insert(iterator position, ForwardIterator first,
+		ForwardIterator last, std::forward_iterator_tag) {
+		const size_type offset = position - m_begin;
+		const size_type count = ft::distance(first, last);
+		m_open_gap(offset, count);
+		ft::uninitialized_copy(first, last, m_begin + offset, m_allocator);
+		m_end += count;
+	}
+
+#if __cplusplus >= 201103L
+	// Takes the elements of x, stealing its heap block if it has one
+	void m_take(small_vector<T, N, Allocator> &x) {
+		if (x.is_inline()) {
+			m_end = ft::uninitialized_move_if_noexcept(
+				x.m_begin, x.m_end, m_begin, m_allocator);
+			x.clear();
+		} else {
+			m_begin = x.m_begin;
+			m_end = x.m_end;
+			m_end_of_storage = x.m_end_of_storage;
+			x.m_reset_inline();
+		}
+	}
+#endif
+};
+
+template <class T, std::size_t N, class Allocator>
+bool operator==(const small_vector<T, N, Allocator> &x,
+	const small_vector<T, N, Allocator>             &y) {
+	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class T, std::size_t N, class Allocator>
+bool operator!=(const small_vector<T, N, Allocator> &x,
+	const small_vector<T, N, Allocator>             &y) {
+	return !(x == y);
+}
+
+template <class T, std::size_t N, class Allocator>
+bool operator<(const small_vector<T, N, Allocator> &x,
+	const small_vector<T, N, Allocator>             &y) {
+	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <class T, std::size_t N, class Allocator>
+bool operator>(const small_vector<T, N, Allocator> &x,
+	const small_vector<T, N, Allocator>             &y) {
+	return y < x;
+}
+
+template <class T, std::size_t N, class Allocator>
+bool operator<=(const small_vector<T, N, Allocator> &x,
+	const small_vector<T, N, Allocator>             &y) {
+	return !(y < x);
+}
+
+template <class T, std::size_t N, class Allocator>
+bool operator>=(const small_vector<T, N, Allocator> &x,
+	const small_vector<T, N, Allocator>             &y) {
+	return !(x < y);
+}
+
+template <class T, std::size_t N, class Allocator>
+void swap(small_vector<T, N, Allocator> &x, small_vector<T, N, Allocator> &y) {
+	x.swap(y);
+}
+
+}  // namespace ft
@@ -0,0 +1,319 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "aligned_allocator.hpp"
+#include "atomic.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// Stands for the columns a soa_vector does not use
+struct soa_end {};
+
+// The elements of one column of a soa_vector, contiguous and starting on a
+// cache line. Invalidated like the iterators of the column.
+template <class T>
+class soa_span {
+  public:
+	typedef T          *iterator;
+	typedef T          &reference;
+	typedef std::size_t size_type;
+
+	soa_span(T *data, size_type size) : m_data(data), m_size(size) {}
+
+	// Tells the compiler about the alignment so that scans vectorize with
+	// aligned loads straight away
+	T *data() const {
+		return static_cast<T *>(FT_ASSUME_ALIGNED(m_data, cache_line_size));
+	}
+
+	iterator begin() const {
+		return data();
+	}
+
+	iterator end() const {
+		return m_data + m_size;
+	}
+
+	size_type size() const {
+		return m_size;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	reference operator[](size_type n) const {
+		return m_data[n];
+	}
+
+  private:
+	T        *m_data;
+	size_type m_size;
+};
+
+namespace detail {
+
+// The columns of a soa_vector as a list: the first one here, the others in
+// the base class, down to a list of soa_end that holds nothing. Every
+// operation on a row goes down the list, and undoes its change to the
+// columns before when a later one throws.
+template <class T0, class T1, class T2, class T3, class T4, class T5>
+struct soa_columns : public soa_columns<T1, T2, T3, T4, T5, soa_end> {
+	typedef soa_columns<T1, T2, T3, T4, T5, soa_end> rest_type;
+	typedef T0                                       value_type;
+	typedef ft::vector<T0, aligned_allocator<T0> >   column_type;
+
+	enum { count = rest_type::count + 1 };
+
+	column_type column;
+
+	void push_back(const T0 &x0, const T1 &x1, const T2 &x2, const T3 &x3,
+		const T4 &x4, const T5 &x5) {
+		column.push_back(x0);
+		try {
+			rest_type::push_back(x1, x2, x3, x4, x5, soa_end());
+		} catch (...) {
+			column.pop_back();
+			throw;
+		}
+	}
+
+	void pop_back() {
+		column.pop_back();
+		rest_type::pop_back();
+	}
+
+	void resize(std::size_t n) {
+		const std::size_t old_size = column.size();
+		column.resize(n);
+		try {
+			rest_type::resize(n);
+		} catch (...) {
+			column.resize(old_size);
+			throw;
+		}
+	}
+
+	void reserve(std::size_t n) {
+		column.reserve(n);
+		rest_type::reserve(n);
+	}
+
+	void clear() {
+		column.clear();
+		rest_type::clear();
+	}
+
+	void swap(soa_columns &x) {
+		column.swap(x.column);
+		rest_type::swap(x);
+	}
+};
+
+template <>
+struct soa_columns<soa_end, soa_end, soa_end, soa_end, soa_end, soa_end> {
+	enum { count = 0 };
+
+	void push_back(const soa_end &, const soa_end &, const soa_end &,
+		const soa_end &, const soa_end &, const soa_end &) {}
+
+	void pop_back() {}
+
+	void resize(std::size_t) {}
+
+	void reserve(std::size_t) {}
+
+	void clear() {}
+
+	void swap(soa_columns &) {}
+};
+
+// Column I of a list of columns
+template <std::size_t I, class Columns>
+struct soa_column {
+	typedef soa_column<I - 1, typename Columns::rest_type> next;
+	typedef typename next::value_type                      value_type;
+	typedef typename next::column_type                     column_type;
+
+	static column_type &get(Columns &columns) {
+		return next::get(columns);
+	}
+
+	static const column_type &get(const Columns &columns) {
+		return next::get(columns);
+	}
+};
+
+template <class Columns>
+struct soa_column<0, Columns> {
+	typedef typename Columns::value_type  value_type;
+	typedef typename Columns::column_type column_type;
+
+	static column_type &get(Columns &columns) {
+		return columns.column;
+	}
+
+	static const column_type &get(const Columns &columns) {
+		return columns.column;
+	}
+};
+
+}  // namespace detail
+
+// A vector of rows of up to six fields, stored as one ft::vector per field:
+// a pass over one field reads only that field, packed and cache line
+// aligned, where a vector of structs would drag the whole rows through the
+// cache. Column I is reached with column<I>(), a row with operator[], which
+// returns a proxy whose get<I>() is field I of the row.
+//
+//     ft::soa_vector<int, double> v;
+//     v.push_back(1, 2.5);
+//     ft::soa_span<double> prices = v.column<1>();
+//     v[0].get<1>() *= 2;
+template <class T0, class T1 = soa_end, class T2 = soa_end,
+	class T3 = soa_end, class T4 = soa_end, class T5 = soa_end>
+class soa_vector {
+	typedef detail::soa_columns<T0, T1, T2, T3, T4, T5> columns_type;
+
+  public:
+	typedef std::size_t size_type;
+
+	enum { column_count = columns_type::count };
+
+	// Type of column I
+	template <std::size_t I>
+	struct column_value {
+		typedef typename detail::soa_column<I, columns_type>::value_type type;
+	};
+
+	// Row n of a soa_vector, the fields are references into the columns
+	template <bool isconst = false>
+	class row_reference {
+	  public:
+		typedef typename ft::choose<isconst, const columns_type *,
+			columns_type *>::type columns_pointer;
+
+		row_reference(columns_pointer columns, size_type n)
+			: m_columns(columns), m_index(n) {}
+
+		template <std::size_t I>
+		typename ft::choose<isconst, const typename column_value<I>::type &,
+			typename column_value<I>::type &>::type
+		get() const {
+			return detail::soa_column<I, columns_type>::get(
+				*m_columns)[m_index];
+		}
+
+		size_type index() const {
+			return m_index;
+		}
+
+	  private:
+		columns_pointer m_columns;
+		size_type       m_index;
+	};
+
+	typedef row_reference<false> reference;
+	typedef row_reference<true>  const_reference;
+
+	// capacity
+	size_type size() const {
+		return m_first_column().size();
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	size_type capacity() const {
+		return m_first_column().capacity();
+	}
+
+	void reserve(size_type n) {
+		m_columns.reserve(n);
+	}
+
+	// New fields are value initialized
+	void resize(size_type n) {
+		m_columns.resize(n);
+	}
+
+	// element access
+	reference operator[](size_type n) {
+		return reference(&m_columns, n);
+	}
+
+	const_reference operator[](size_type n) const {
+		return const_reference(&m_columns, n);
+	}
+
+	reference at(size_type n) {
+		m_check_index(n);
+		return (*this)[n];
+	}
+
+	const_reference at(size_type n) const {
+		m_check_index(n);
+		return (*this)[n];
+	}
+
+	template <std::size_t I>
+	soa_span<typename column_value<I>::type> column() {
+		typename detail::soa_column<I, columns_type>::column_type &c =
+			detail::soa_column<I, columns_type>::get(m_columns);
+		return soa_span<typename column_value<I>::type>(
+			c.empty() ? 0 : &c[0], c.size());
+	}
+
+	template <std::size_t I>
+	soa_span<const typename column_value<I>::type> column() const {
+		const typename detail::soa_column<I, columns_type>::column_type &c =
+			detail::soa_column<I, columns_type>::get(m_columns);
+		return soa_span<const typename column_value<I>::type>(
+			c.empty() ? 0 : &c[0], c.size());
+	}
+
+	// modifiers
+	// Appends a row, the fields not given are value initialized
+	void push_back(const T0 &x0, const T1 &x1 = T1(), const T2 &x2 = T2(),
+		const T3 &x3 = T3(), const T4 &x4 = T4(), const T5 &x5 = T5()) {
+		m_columns.push_back(x0, x1, x2, x3, x4, x5);
+	}
+
+	void pop_back() {
+		m_columns.pop_back();
+	}
+
+	void clear() {
+		m_columns.clear();
+	}
+
+	void swap(soa_vector &x) {
+		m_columns.swap(x.m_columns);
+	}
+
+  private:
+	columns_type m_columns;
+
+	const typename columns_type::column_type &m_first_column() const {
+		return m_columns.column;
+	}
+
+	void m_check_index(size_type n) const {
+		if (n >= size()) {
+			throw std::out_of_range(
+				std::string("soa_vector: index out of range"));
+		}
+	}
+};
+
+template <class T0, class T1, class T2, class T3, class T4, class T5>
+void swap(soa_vector<T0, T1, T2, T3, T4, T5> &x,
+	soa_vector<T0, T1, T2, T3, T4, T5> &y) {
+	x.swap(y);
+}
+
+}  // namespace ft
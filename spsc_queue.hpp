@@ -0,0 +1,215 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
+#include "algorithm.hpp"
+#include "atomic.hpp"
+
+namespace ft {
+
+// A bounded queue from one producer thread to one consumer thread, without
+// locks. The elements live in a circular array of a power of two slots,
+// allocated once. The producer owns m_tail and the consumer m_head; each
+// publishes its counter with a release store that the other reads with
+// acquire, and keeps a copy of the other's counter on its own cache line,
+// refreshed only when the queue looks full or empty, so that in steady state
+// neither reads the line the other writes.
+//
+// Only one thread may push and only one may pop at a time. The destructor
+// destroys the elements left and must not race with either.
+template <class T, class Allocator = std::allocator<T> >
+class spsc_queue {
+  public:
+	typedef T           value_type;
+	typedef Allocator   allocator_type;
+	typedef std::size_t size_type;
+
+	// Room for capacity elements, rounded up to a power of two. Throws
+	// std::length_error when that is more than the allocator can give.
+	explicit spsc_queue(
+		size_type capacity, const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_data(0), m_mask(0), m_head(0),
+		  m_tail_cache(0), m_tail(0), m_head_cache(0) {
+		size_type slots = 1;
+		while (slots < capacity) {
+			if (slots > m_allocator.max_size() / 2) {
+				throw std::length_error(
+					std::string("spsc_queue: capacity > max_size"));
+			}
+			slots *= 2;
+		}
+		m_data = m_allocator.allocate(slots);
+		m_mask = slots - 1;
+	}
+
+	~spsc_queue() {
+		for (size_type i = m_head; i != m_tail; i++) {
+			m_allocator.destroy(m_data + (i & m_mask));
+		}
+		m_allocator.deallocate(m_data, m_mask + 1);
+	}
+
+	// producer
+	// Returns false when the queue is full
+	bool try_push(const T &x) {
+		const size_type tail = m_tail;
+		if (tail - m_head_cache > m_mask && m_room(tail) == 0) {
+			return false;
+		}
+		m_allocator.construct(m_data + (tail & m_mask), x);
+		atomic_store(&m_tail, tail + 1, memory_order_release);
+		return true;
+	}
+
+	// Waits while the queue is full
+	void push(const T &x) {
+		backoff waiting;
+		while (!try_push(x)) {
+			waiting.wait();
+		}
+	}
+
+	// Pushes as many of the n elements as fit and publishes them at once.
+	// Returns how many were pushed.
+	size_type try_push_n(const T *first, size_type n) {
+		const size_type tail = m_tail;
+		size_type       room = m_mask + 1 - (tail - m_head_cache);
+		if (room < n) {
+			room = m_room(tail);
+		}
+		n = ft::min(n, room);
+		size_type i = 0;
+		try {
+			for (; i < n; i++) {
+				m_allocator.construct(m_data + ((tail + i) & m_mask), first[i]);
+			}
+		} catch (...) {
+			// The ones copied so far stay queued
+			atomic_store(&m_tail, tail + i, memory_order_release);
+			throw;
+		}
+		atomic_store(&m_tail, tail + n, memory_order_release);
+		return n;
+	}
+
+	// Pushes all n elements, waiting for room as needed
+	void push_n(const T *first, size_type n) {
+		backoff waiting;
+		while (n != 0) {
+			const size_type pushed = try_push_n(first, n);
+			if (pushed == 0) {
+				waiting.wait();
+			} else {
+				waiting.reset();
+			}
+			first += pushed;
+			n -= pushed;
+		}
+	}
+
+	// consumer
+	// Moves the front element to x, returns false when the queue is empty
+	bool try_pop(T &x) {
+		const size_type head = m_head;
+		if (head == m_tail_cache && m_ready(head) == 0) {
+			return false;
+		}
+		T *const slot = m_data + (head & m_mask);
+#if __cplusplus >= 201103L
+		x = std::move(*slot);
+#else
+		x = *slot;
+#endif
+		m_allocator.destroy(slot);
+		atomic_store(&m_head, head + 1, memory_order_release);
+		return true;
+	}
+
+	// Waits while the queue is empty
+	void pop(T &x) {
+		backoff waiting;
+		while (!try_pop(x)) {
+			waiting.wait();
+		}
+	}
+
+	// Moves up to n elements to out and frees their slots at once. Returns
+	// how many were popped.
+	size_type try_pop_n(T *out, size_type n) {
+		const size_type head = m_head;
+		size_type       ready = m_tail_cache - head;
+		if (ready < n) {
+			ready = m_ready(head);
+		}
+		n = ft::min(n, ready);
+		size_type i = 0;
+		try {
+			for (; i < n; i++) {
+				T *const slot = m_data + ((head + i) & m_mask);
+#if __cplusplus >= 201103L
+				out[i] = std::move(*slot);
+#else
+				out[i] = *slot;
+#endif
+				m_allocator.destroy(slot);
+			}
+		} catch (...) {
+			// The ones popped so far are destroyed, their slots are freed
+			atomic_store(&m_head, head + i, memory_order_release);
+			throw;
+		}
+		atomic_store(&m_head, head + n, memory_order_release);
+		return n;
+	}
+
+	// observers
+	// Exact only for the producer or the consumer between their own calls
+	size_type size() const {
+		return atomic_load(&m_tail, memory_order_acquire)
+			- atomic_load(&m_head, memory_order_acquire);
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	size_type capacity() const {
+		return m_mask + 1;
+	}
+
+  private:
+	// Read by both threads, written only by the constructor
+	Allocator m_allocator;
+	T        *m_data;
+	size_type m_mask;
+	char      m_pad0[cache_line_size];
+	// Written by the consumer
+	size_type m_head;
+	size_type m_tail_cache;
+	char      m_pad1[cache_line_size];
+	// Written by the producer
+	size_type m_tail;
+	size_type m_head_cache;
+	char      m_pad2[cache_line_size];
+
+	spsc_queue(const spsc_queue &);
+	spsc_queue &operator=(const spsc_queue &);
+
+	// Free slots from tail on, after reading where the consumer is
+	size_type m_room(size_type tail) {
+		m_head_cache = atomic_load(&m_head, memory_order_acquire);
+		return m_mask + 1 - (tail - m_head_cache);
+	}
+
+	// Elements from head on, after reading where the producer is
+	size_type m_ready(size_type head) {
+		m_tail_cache = atomic_load(&m_tail, memory_order_acquire);
+		return m_tail_cache - head;
+	}
+};
+
+}  // namespace ft
@@ -30,6 +30,10 @@ class stack {
 
   public:
 	explicit stack(const Container &container = Container()) : c(container) {}
+#if __cplusplus >= 201103L
+	// The implicit copy and move operations forward to the container
+	explicit stack(Container &&container) : c(std::move(container)) {}
+#endif
 
 	bool empty() const {
 		return c.empty();
@@ -51,6 +55,12 @@ class stack {
 		c.push_back(value);
 	}
 
+#if __cplusplus >= 201103L
+	void push(value_type &&value) {
+		c.push_back(std::move(value));
+	}
+#endif
+
 	void pop() {
 		c.pop_back();
 	}
@@ -0,0 +1,523 @@
+#pragma once
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "atomic.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+namespace detail {
+
+// A unit of work for a thread_pool: run(arg) on one of its threads
+struct pool_task {
+	void (*run)(void *);
+	void *arg;
+};
+
+// Holds a mutex for the lifetime of the guard
+class mutex_guard {
+  public:
+	explicit mutex_guard(pthread_mutex_t &mutex) : m_mutex(mutex) {
+		pthread_mutex_lock(&m_mutex);
+	}
+	~mutex_guard() {
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+  private:
+	pthread_mutex_t &m_mutex;
+
+	mutex_guard(const mutex_guard &);
+	mutex_guard &operator=(const mutex_guard &);
+};
+
+// A queue of tasks any thread can push to and take from, under a mutex.
+// Holds the tasks submitted from outside a pool, oldest first.
+class locked_deque {
+  public:
+	locked_deque() : m_head(0) {
+		pthread_mutex_init(&m_lock, NULL);
+	}
+	~locked_deque() {
+		pthread_mutex_destroy(&m_lock);
+	}
+
+	void push(const pool_task &task) {
+		mutex_guard guard(m_lock);
+		// Drops the taken slots once they are the larger part
+		if (m_head > 0 && m_head >= m_tasks.size() - m_head) {
+			m_tasks.erase(m_tasks.begin(), m_tasks.begin() + m_head);
+			m_head = 0;
+		}
+		m_tasks.push_back(task);
+	}
+
+	bool steal(pool_task &task) {
+		mutex_guard guard(m_lock);
+		if (m_tasks.size() == m_head) {
+			return false;
+		}
+		task = m_tasks[m_head++];
+		if (m_tasks.size() == m_head) {
+			m_tasks.clear();
+			m_head = 0;
+		}
+		return true;
+	}
+
+  private:
+	pthread_mutex_t       m_lock;
+	ft::vector<pool_task> m_tasks;
+	std::size_t           m_head;  // first task not taken yet
+
+	locked_deque(const locked_deque &);
+	locked_deque &operator=(const locked_deque &);
+};
+
+// The Chase-Lev deque of one worker, with the memory orders of Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models". Only the
+// owner pushes and pops, at the bottom, without a lock or a compare and
+// swap unless a single task is left; the other threads steal from the top
+// with a compare and swap. The tasks are kept in a circular array that the
+// owner doubles when it is full. The arrays it replaces may still be read
+// by thieves and are freed with the deque.
+class work_stealing_deque {
+  public:
+	work_stealing_deque()
+		: m_top(0), m_bottom(0), m_array(new task_array(64, NULL)) {}
+	~work_stealing_deque() {
+		task_array *a = m_array;
+		while (a != NULL) {
+			task_array *previous = a->previous;
+			delete a;
+			a = previous;
+		}
+	}
+
+	void push(const pool_task &task) {
+		const long  b = atomic_load(&m_bottom, memory_order_relaxed);
+		const long  t = atomic_load(&m_top, memory_order_acquire);
+		task_array *a = atomic_load(&m_array, memory_order_relaxed);
+		if (b - t > a->mask) {
+			a = m_grow(a, t, b);
+		}
+		a->put(b, task);
+		// Publishes the task to the thieves that read m_bottom
+		atomic_store(&m_bottom, b + 1, memory_order_release);
+	}
+
+	bool pop(pool_task &task) {
+		const long  b = atomic_load(&m_bottom, memory_order_relaxed) - 1;
+		task_array *a = atomic_load(&m_array, memory_order_relaxed);
+		// Ordered before reading m_top, so that a thief either sees the
+		// task taken or the owner sees the thief's increment of m_top
+		atomic_store(&m_bottom, b, memory_order_seq_cst);
+		long t = atomic_load(&m_top, memory_order_seq_cst);
+		if (t > b) {
+			atomic_store(&m_bottom, b + 1, memory_order_relaxed);
+			return false;
+		}
+		task = a->get(b);
+		if (t == b) {
+			// The last task, a thief may be taking it too
+			const bool won = atomic_compare_exchange(&m_top, t, t + 1,
+				memory_order_seq_cst, memory_order_relaxed);
+			atomic_store(&m_bottom, b + 1, memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	bool steal(pool_task &task) {
+		long       t = atomic_load(&m_top, memory_order_seq_cst);
+		const long b = atomic_load(&m_bottom, memory_order_seq_cst);
+		if (t >= b) {
+			return false;
+		}
+		task_array *a = atomic_load(&m_array, memory_order_acquire);
+		task = a->get(t);
+		// Fails when the owner or another thief took it first
+		return atomic_compare_exchange(&m_top, t, t + 1, memory_order_seq_cst,
+			memory_order_relaxed);
+	}
+
+	// Tasks in the deque, racy unless called by the owner
+	long size() const {
+		return atomic_load(&m_bottom, memory_order_relaxed)
+			- atomic_load(&m_top, memory_order_relaxed);
+	}
+
+  private:
+	// Slots are read and written with atomics: a thief may read one the
+	// owner is overwriting, its compare and swap then fails
+	struct task_array {
+		long        mask;
+		task_array *previous;
+		pool_task  *slots;
+
+		task_array(long size, task_array *p)
+			: mask(size - 1), previous(p), slots(new pool_task[size]) {}
+		~task_array() {
+			delete[] slots;
+		}
+
+		void put(long i, const pool_task &task) {
+			atomic_store(&slots[i & mask].run, task.run, memory_order_relaxed);
+			atomic_store(&slots[i & mask].arg, task.arg, memory_order_relaxed);
+		}
+
+		pool_task get(long i) const {
+			pool_task task;
+			task.run = atomic_load(&slots[i & mask].run, memory_order_relaxed);
+			task.arg = atomic_load(&slots[i & mask].arg, memory_order_relaxed);
+			return task;
+		}
+
+	  private:
+		task_array(const task_array &);
+		task_array &operator=(const task_array &);
+	};
+
+	long        m_top;
+	char        m_pad[cache_line_size];  // m_top is written by the thieves
+	long        m_bottom;
+	task_array *m_array;
+
+	work_stealing_deque(const work_stealing_deque &);
+	work_stealing_deque &operator=(const work_stealing_deque &);
+
+	task_array *m_grow(task_array *a, long t, long b) {
+		task_array *bigger = new task_array(2 * (a->mask + 1), a);
+		for (long i = t; i < b; i++) {
+			bigger->put(i, a->get(i));
+		}
+		atomic_store(&m_array, bigger, memory_order_release);
+		return bigger;
+	}
+};
+
+}  // namespace detail
+
+// A fixed set of worker threads running the tasks submitted to it. Every
+// worker has a work_stealing_deque: the tasks a worker submits go to its
+// own deque and it runs the newest of them first, while a worker out of
+// work steals the oldest task of another, usually the largest. Tasks
+// submitted from other threads go to a shared deque. Idle workers sleep
+// until a task is submitted.
+//
+// A thread waiting for tasks with wait_for() runs queued ones in the
+// meantime, so tasks can wait for the tasks they submit, and a pool of zero
+// workers runs everything on the threads that wait.
+class thread_pool {
+  public:
+	// Starts threads workers, pinned each to one of the processors the
+	// process may run on when pin_threads is set and the system can. Throws
+	// std::runtime_error when a thread cannot be created.
+	explicit thread_pool(std::size_t threads, bool pin_threads = false)
+		: m_workers(threads), m_queued(0), m_sleepers(0), m_stop(false) {
+		pthread_key_create(&m_key, NULL);
+		pthread_mutex_init(&m_sleep_lock, NULL);
+		pthread_cond_init(&m_wake, NULL);
+		m_deques = new detail::work_stealing_deque[threads];
+		const ft::vector<int> cpus = pin_threads ? m_allowed_cpus()
+												 : ft::vector<int>();
+		for (std::size_t i = 0; i < threads; i++) {
+			m_workers[i].pool = this;
+			m_workers[i].index = i;
+			m_workers[i].seed = i + 1;
+			m_workers[i].cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+			if (pthread_create(&m_workers[i].thread, NULL, m_run_worker,
+					&m_workers[i])
+				!= 0) {
+				m_workers.resize(i);
+				m_shutdown();
+				throw std::runtime_error(
+					std::string("thread_pool: cannot create thread"));
+			}
+		}
+	}
+
+	// Stops and joins the workers, the tasks submitted must have finished
+	~thread_pool() {
+		m_shutdown();
+	}
+
+	// Number of worker threads
+	std::size_t size() const {
+		return m_workers.size();
+	}
+
+	// Processors online, at least 1
+	static std::size_t hardware_threads() {
+		const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+		return processors > 0 ? processors : 1;
+	}
+
+	// Queues run(arg) to be run by a worker or a waiting thread
+	void submit(void (*run)(void *), void *arg) {
+		detail::pool_task task = {run, arg};
+		const worker     *self = m_current_worker();
+		if (self != NULL) {
+			m_deques[self->index].push(task);
+		} else {
+			m_shared.push(task);
+		}
+		atomic_fetch_add(&m_queued, 1L);
+		if (atomic_load(&m_sleepers) != 0) {
+			detail::mutex_guard guard(m_sleep_lock);
+			pthread_cond_signal(&m_wake);
+		}
+	}
+
+	// Runs one queued task on the calling thread, its own ones first, false
+	// if there were none
+	bool run_pending_task() {
+		detail::pool_task task;
+		if (!m_take(m_current_worker(), task)) {
+			return false;
+		}
+		task.run(task.arg);
+		return true;
+	}
+
+	// Runs queued tasks until *pending, decremented with release by the
+	// tasks waited for, drops to zero
+	void wait_for(const long *pending) {
+		while (atomic_load(pending, memory_order_acquire) != 0) {
+			if (!run_pending_task()) {
+				sched_yield();
+			}
+		}
+	}
+
+  private:
+	struct worker {
+		thread_pool *pool;
+		std::size_t  index;
+		unsigned     seed;  // of the choice of the victims to steal from
+		int          cpu;   // pinned to, or -1
+		pthread_t    thread;
+	};
+
+	ft::vector<worker>           m_workers;
+	detail::work_stealing_deque *m_deques;  // one per worker
+	detail::locked_deque         m_shared;
+	pthread_key_t                m_key;  // the worker of the calling thread
+	long                         m_queued;
+	long                         m_sleepers;
+	bool                         m_stop;
+	pthread_mutex_t              m_sleep_lock;
+	pthread_cond_t               m_wake;
+
+	thread_pool(const thread_pool &);
+	thread_pool &operator=(const thread_pool &);
+
+	worker *m_current_worker() const {
+		return static_cast<worker *>(pthread_getspecific(m_key));
+	}
+
+	// Pops a task of the deque of self, or steals one from the shared deque
+	// and then from the workers, starting at a random one
+	bool m_take(worker *self, detail::pool_task &task) {
+		const std::size_t count = m_workers.size();
+		bool found = (self != NULL && m_deques[self->index].pop(task))
+			|| m_shared.steal(task);
+		if (!found && count > 0) {
+			std::size_t start = 0;
+			if (self != NULL) {
+				// xorshift
+				self->seed ^= self->seed << 13;
+				self->seed ^= self->seed >> 17;
+				self->seed ^= self->seed << 5;
+				start = self->seed % count;
+			}
+			for (std::size_t i = 0; i < count && !found; i++) {
+				const std::size_t victim = (start + i) % count;
+				found = (self == NULL || victim != self->index)
+					&& m_deques[victim].steal(task);
+			}
+		}
+		if (found) {
+			atomic_fetch_sub(&m_queued, 1L);
+		}
+		return found;
+	}
+
+	// The processors the process may run on, empty if unknown
+	static ft::vector<int> m_allowed_cpus() {
+		ft::vector<int> cpus;
+#if defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+			for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+				if (CPU_ISSET(cpu, &set)) {
+					cpus.push_back(cpu);
+				}
+			}
+		}
+#endif
+		return cpus;
+	}
+
+	static void m_pin(int cpu) {
+#if defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		// Best effort, the worker runs unpinned when it fails
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+		(void)cpu;
+#endif
+	}
+
+	static void *m_run_worker(void *arg) {
+		worker      *w = static_cast<worker *>(arg);
+		thread_pool *pool = w->pool;
+		pthread_setspecific(pool->m_key, w);
+		if (w->cpu >= 0) {
+			m_pin(w->cpu);
+		}
+		for (;;) {
+			if (pool->run_pending_task()) {
+				continue;
+			}
+			detail::mutex_guard guard(pool->m_sleep_lock);
+			// A task submitted after m_sleepers is raised signals m_wake
+			atomic_fetch_add(&pool->m_sleepers, 1L);
+			while (atomic_load(&pool->m_queued) == 0 && !pool->m_stop) {
+				pthread_cond_wait(&pool->m_wake, &pool->m_sleep_lock);
+			}
+			atomic_fetch_sub(&pool->m_sleepers, 1L);
+			if (pool->m_stop) {
+				return NULL;
+			}
+		}
+	}
+
+	void m_shutdown() {
+		{
+			detail::mutex_guard guard(m_sleep_lock);
+			m_stop = true;
+			pthread_cond_broadcast(&m_wake);
+		}
+		for (std::size_t i = 0; i < m_workers.size(); i++) {
+			pthread_join(m_workers[i].thread, NULL);
+		}
+		delete[] m_deques;
+		pthread_cond_destroy(&m_wake);
+		pthread_mutex_destroy(&m_sleep_lock);
+		pthread_key_delete(m_key);
+	}
+};
+
+// The pool behind ft::par and the task groups, one worker less than there
+// are processors since the thread that waits for the work runs tasks too
+inline thread_pool &default_thread_pool() {
+	static thread_pool pool(thread_pool::hardware_threads() - 1);
+	return pool;
+}
+
+namespace detail {
+
+// A copy of the function a task_group runs. It deletes itself before
+// counting itself done, the group may be gone right after.
+template <class Function>
+struct group_task {
+	Function function;
+	long    *pending;
+	long    *failed;
+
+	group_task(const Function &f, long *p, long *e)
+		: function(f), pending(p), failed(e) {}
+
+	static void run(void *arg) {
+		group_task *task = static_cast<group_task *>(arg);
+		long       *pending = task->pending;
+		try {
+			task->function();
+		} catch (...) {
+			atomic_store(task->failed, 1L);
+		}
+		delete task;
+		atomic_fetch_sub(pending, 1L, memory_order_release);
+	}
+};
+
+}  // namespace detail
+
+// Functions run as tasks of a pool and waited for together. wait() runs
+// queued tasks until all the functions submitted have returned; a function
+// may submit to the group it runs in, or wait for a group of its own.
+class task_group {
+  public:
+	explicit task_group(thread_pool &pool = default_thread_pool())
+		: m_pool(pool), m_pending(0), m_failed(0) {}
+	// Waits for the functions still running
+	~task_group() {
+		m_pool.wait_for(&m_pending);
+	}
+
+	// Queues a copy of function, called without arguments
+	template <class Function>
+	void submit(const Function &function) {
+		detail::group_task<Function> *task = new detail::group_task<Function>(
+			function, &m_pending, &m_failed);
+		atomic_fetch_add(&m_pending, 1L);
+		m_pool.submit(detail::group_task<Function>::run, task);
+	}
+
+	// Returns once all the functions submitted have returned. Throws
+	// std::runtime_error if any of them threw since the last wait().
+	void wait() {
+		m_pool.wait_for(&m_pending);
+		if (atomic_exchange(&m_failed, 0L) != 0) {
+			throw std::runtime_error(
+				std::string("task_group: a task threw an exception"));
+		}
+	}
+
+  private:
+	thread_pool &m_pool;
+	long         m_pending;
+	long         m_failed;
+
+	task_group(const task_group &);
+	task_group &operator=(const task_group &);
+};
+
+// Calls the functions in parallel and returns when they all have: the
+// first on the calling thread, the others as tasks of the default pool
+template <class F1, class F2>
+void parallel_invoke(F1 f1, F2 f2) {
+	task_group group;
+	group.submit(f2);
+	f1();
+	group.wait();
+}
+
+template <class F1, class F2, class F3>
+void parallel_invoke(F1 f1, F2 f2, F3 f3) {
+	task_group group;
+	group.submit(f2);
+	group.submit(f3);
+	f1();
+	group.wait();
+}
+
+template <class F1, class F2, class F3, class F4>
+void parallel_invoke(F1 f1, F2 f2, F3 f3, F4 f4) {
+	task_group group;
+	group.submit(f2);
+	group.submit(f3);
+	group.submit(f4);
+	f1();
+	group.wait();
+}
+
+}  // namespace ft
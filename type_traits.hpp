@@ -1,5 +1,31 @@
 #pragma once
 
+// Triviality cannot be detected in portable C++98, use the compiler
+// intrinsics when they exist
+#if defined(__has_builtin)
+#	if __has_builtin(__is_trivially_copyable)
+#		define FT_IS_TRIVIALLY_COPYABLE(T) __is_trivially_copyable(T)
+#	endif
+#	if __has_builtin(__is_trivially_destructible)
+#		define FT_IS_TRIVIALLY_DESTRUCTIBLE(T) __is_trivially_destructible(T)
+#	endif
+#	if __has_builtin(__is_trivially_constructible)
+#		define FT_IS_TRIVIALLY_DEFAULT_CONSTRUCTIBLE(T)                     \
+			__is_trivially_constructible(T)
+#	endif
+#endif
+#if defined(__GNUC__) && !defined(FT_IS_TRIVIALLY_COPYABLE)
+#	define FT_IS_TRIVIALLY_COPYABLE(T)                                      \
+		(__has_trivial_copy(T) && __has_trivial_assign(T)                   \
+			&& __has_trivial_destructor(T))
+#endif
+#if defined(__GNUC__) && !defined(FT_IS_TRIVIALLY_DESTRUCTIBLE)
+#	define FT_IS_TRIVIALLY_DESTRUCTIBLE(T) __has_trivial_destructor(T)
+#endif
+#if defined(__GNUC__) && !defined(FT_IS_TRIVIALLY_DEFAULT_CONSTRUCTIBLE)
+#	define FT_IS_TRIVIALLY_DEFAULT_CONSTRUCTIBLE(T) __has_trivial_constructor(T)
+#endif
+
 namespace ft {
 
 template <bool B, class T = void>
@@ -94,4 +120,135 @@ struct is_integral<bool> : public true_type {};
 template <>
 struct is_integral<wchar_t> : public true_type {};
 
+template <class T>
+struct is_floating_point : public false_type {};
+
+template <class T>
+struct is_floating_point<const T> : public is_floating_point<T> {};
+
+template <class T>
+struct is_floating_point<volatile const T> : public is_floating_point<T> {};
+
+template <class T>
+struct is_floating_point<volatile T> : public is_floating_point<T> {};
+
+template <>
+struct is_floating_point<float> : public true_type {};
+
+template <>
+struct is_floating_point<double> : public true_type {};
+
+template <>
+struct is_floating_point<long double> : public true_type {};
+
+template <class T>
+struct is_pointer : public false_type {};
+
+template <class T>
+struct is_pointer<T *> : public true_type {};
+
+template <class T>
+struct is_pointer<T *const> : public true_type {};
+
+template <class T, class U>
+struct is_same : public false_type {};
+
+template <class T>
+struct is_same<T, T> : public true_type {};
+
+// Without compiler support only arithmetic types and pointers are known to
+// be trivial, which is always a safe answer
+template <class T>
+struct is_scalar
+	: public integral_constant<bool, is_integral<T>::value
+										 || is_floating_point<T>::value
+										 || is_pointer<T>::value> {};
+
+// Objects that can be copied with memcpy
+#ifdef FT_IS_TRIVIALLY_COPYABLE
+template <class T>
+struct is_trivially_copyable
+	: public integral_constant<bool, FT_IS_TRIVIALLY_COPYABLE(T)> {};
+#else
+template <class T>
+struct is_trivially_copyable : public is_scalar<T> {};
+#endif
+
+// Objects whose destructor does nothing
+#ifdef FT_IS_TRIVIALLY_DESTRUCTIBLE
+template <class T>
+struct is_trivially_destructible
+	: public integral_constant<bool, FT_IS_TRIVIALLY_DESTRUCTIBLE(T)> {};
+#else
+template <class T>
+struct is_trivially_destructible : public is_scalar<T> {};
+#endif
+
+// Objects whose default constructor does nothing
+#ifdef FT_IS_TRIVIALLY_DEFAULT_CONSTRUCTIBLE
+template <class T>
+struct is_trivially_default_constructible
+	: public integral_constant<bool,
+		  FT_IS_TRIVIALLY_DEFAULT_CONSTRUCTIBLE(T)> {};
+#else
+template <class T>
+struct is_trivially_default_constructible : public is_scalar<T> {};
+#endif
+
+// Objects that can be moved to another address with memcpy, the old copy
+// being dropped without running its destructor. Trivially copyable types are;
+// specialize it to true_type for other types that never point into
+// themselves and are not registered anywhere by address.
+template <class T>
+struct is_trivially_relocatable : public is_trivially_copyable<T> {};
+
+namespace detail {
+
+// Ranges of arithmetic types and pointers of 1, 2, 4 or 8 bytes can be
+// filled by repeating the bit pattern of the value: memset or vector stores
+template <class Iterator>
+struct is_pattern_fillable : public false_type {};
+
+template <class T>
+struct is_pattern_fillable<T *>
+	: public integral_constant<bool,
+		  is_scalar<T>::value
+			  && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4
+				  || sizeof(T) == 8)> {};
+
+template <class T>
+struct is_pattern_fillable<const T *> : public false_type {};
+
+// Two ranges of integers of the same type can be compared bytewise, for
+// equality with memcmp and for ordering by the first byte that differs
+template <class It1, class It2>
+struct is_bitwise_comparable : public false_type {};
+
+template <class T>
+struct is_bitwise_comparable<T *, T *> : public is_integral<T> {};
+
+template <class T>
+struct is_bitwise_comparable<const T *, T *> : public is_integral<T> {};
+
+template <class T>
+struct is_bitwise_comparable<T *, const T *> : public is_integral<T> {};
+
+template <class T>
+struct is_bitwise_comparable<const T *, const T *> : public is_integral<T> {};
+
+// A range read through InputIt can be copied into OutputIt with memmove
+// when both are pointers to the same trivially copyable type
+template <class InputIt, class OutputIt>
+struct is_bitwise_copyable : public false_type {};
+
+template <class T>
+struct is_bitwise_copyable<T *, T *>
+	: public integral_constant<bool, is_trivially_copyable<T>::value> {};
+
+template <class T>
+struct is_bitwise_copyable<const T *, T *>
+	: public integral_constant<bool, is_trivially_copyable<T>::value> {};
+
+}  // namespace detail
+
 }  // namespace ft
@@ -1,6 +1,32 @@
 #pragma once
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
 #include "functional.hpp"
 
+// Keeps a cold path out of its caller so the hot path stays small enough
+// to be inlined
+#if defined(__GNUC__) || defined(__clang__)
+#	define FT_NOINLINE __attribute__((noinline))
+#else
+#	define FT_NOINLINE
+#endif
+
+// Promises the compiler that p is aligned to n bytes, so that loops over it
+// need no prologue to reach an aligned address before they vectorize
+#if defined(__GNUC__) || defined(__clang__)
+#	define FT_ASSUME_ALIGNED(p, n) __builtin_assume_aligned(p, n)
+#else
+#	define FT_ASSUME_ALIGNED(p, n) (p)
+#endif
+
+// Casts to an rvalue in a C++11 build, a plain copy in C++98
+#if __cplusplus >= 201103L
+#	define FT_MOVE(x) std::move(x)
+#else
+#	define FT_MOVE(x) (x)
+#endif
+
 namespace ft {
 
 template <bool flag, class IsTrue, class IsFalse>
@@ -23,4 +49,11 @@ struct select_first : public unary_function<T, U> {
 	}
 };
 
+template <class T>
+struct identity : public unary_function<T, T> {
+	const T &operator()(const T &x) const {
+		return x;
+	}
+};
+
 }  // namespace ft
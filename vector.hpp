@@ -1,15 +1,100 @@
 #pragma once
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#if __cplusplus >= 201103L
+#	include <utility>
+#endif
 #include "algorithm.hpp"
 #include "iterator.hpp"
 #include "memory.hpp"
 #include "type_traits.hpp"
+#include "utils.hpp"
 
 namespace ft {
 
-template <class T, class Allocator = std::allocator<T> >
+// Growth policies, they decide the capacity a vector reallocates to when it
+// holds size elements of element_size bytes and n more do not fit. The result
+// must be at least size + n, the vector clamps it to max_size().
+
+// Doubles the capacity: the fewest reallocations, but up to half of the
+// block is unused right after growing
+struct vector_growth_2x {
+	static std::size_t next_capacity(
+		std::size_t size, std::size_t n, std::size_t) {
+		return size + ft::max(size, n);
+	}
+};
+
+// Grows by half: a third of the block unused at worst, and the blocks freed
+// by earlier reallocations eventually add up to the next request so the
+// allocator can reuse them
+struct vector_growth_1_5x {
+	static std::size_t next_capacity(
+		std::size_t size, std::size_t n, std::size_t) {
+		return size + ft::max(size / 2, n);
+	}
+};
+
+// Allocates exactly what is needed, push_back copies the whole vector every
+// time; for vectors sized up front with reserve()
+struct vector_growth_exact {
+	static std::size_t next_capacity(
+		std::size_t size, std::size_t n, std::size_t) {
+		return size + n;
+	}
+};
+
+// Grows by half, then rounds the block up to the size class the allocator
+// would serve it from anyway and hands the slack to the vector. Blocks below
+// a page use four classes per power of two like malloc bins, larger ones are
+// rounded to whole pages, and from 2 MiB on to whole huge pages.
+struct vector_growth_size_class {
+	static const std::size_t min_block_size = 16;
+	static const std::size_t page_size = 4096;
+	static const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+	static std::size_t next_capacity(
+		std::size_t size, std::size_t n, std::size_t element_size) {
+		const std::size_t capacity =
+			vector_growth_1_5x::next_capacity(size, n, element_size);
+		if (capacity > static_cast<std::size_t>(-1) / element_size) {
+			return capacity;
+		}
+		return block_size(capacity * element_size) / element_size;
+	}
+
+	// Smallest size class holding bytes
+	static std::size_t block_size(std::size_t bytes) {
+		if (bytes >= huge_page_size) {
+			return round_up(bytes, huge_page_size);
+		}
+		if (bytes > page_size) {
+			return round_up(bytes, page_size);
+		}
+		if (bytes <= min_block_size) {
+			return min_block_size;
+		}
+		std::size_t power = min_block_size;
+		while (power * 2 < bytes) {
+			power *= 2;
+		}
+		return round_up(bytes, power / 4);
+	}
+
+	static std::size_t round_up(std::size_t bytes, std::size_t step) {
+		if (bytes > static_cast<std::size_t>(-1) - step) {
+			return bytes;
+		}
+		return (bytes + step - 1) / step * step;
+	}
+};
+
+// GrowthPolicy picks the capacity of every reallocation made by push_back,
+// insert and resize, reserve() and the constructors allocate exactly
+template <class T, class Allocator = std::allocator<T>,
+	class GrowthPolicy = vector_growth_2x>
 class vector {
   public:
 	// types
@@ -25,6 +110,7 @@ class vector {
 	typedef typename Allocator::const_pointer    const_pointer;
 	typedef ft::reverse_iterator<iterator>       reverse_iterator;
 	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+	typedef GrowthPolicy                         growth_policy;
 
 	// constructor/copy/destroy
 	explicit vector(const Allocator &allocator = Allocator());
@@ -34,9 +120,15 @@ class vector {
 	vector(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 			   InputIterator>::type first,
 		InputIterator last, const Allocator &allocator = Allocator());
-	vector(const vector<T, Allocator> &x);
+	vector(const vector<T, Allocator, GrowthPolicy> &x);
 	~vector();
-	vector<T, Allocator> &operator=(const vector<T, Allocator> &x);
+	vector<T, Allocator, GrowthPolicy> &operator=(
+		const vector<T, Allocator, GrowthPolicy> &x);
+#if __cplusplus >= 201103L
+	vector(vector<T, Allocator, GrowthPolicy> &&x) noexcept;
+	vector<T, Allocator, GrowthPolicy> &operator=(
+		vector<T, Allocator, GrowthPolicy> &&x) noexcept;
+#endif
 	void                  assign(size_type n, const T &u);
 	template <class InputIterator>
 	void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
@@ -58,6 +150,7 @@ class vector {
 	size_type              size() const;
 	size_type              max_size() const;
 	void                   resize(size_type n, T val = T());
+	void                   resize_uninitialized(size_type n);
 	size_type              capacity() const;
 	bool                   empty() const;
 	void                   reserve(size_type n);
@@ -74,8 +167,18 @@ class vector {
 
 	// modifiers
 	void                   push_back(const T &x);
+	template <class Writer>
+	size_type              append_with(size_type n, Writer writer);
+#if __cplusplus >= 201103L
+	void                   push_back(T &&x);
+	template <class... Args>
+	reference              emplace_back(Args &&...args);
+#endif
 	void                   pop_back();
 	iterator               insert(iterator position, const T &x);
+#if __cplusplus >= 201103L
+	iterator               insert(iterator position, T &&x);
+#endif
 	void                   insert(iterator position, size_type n, const T &x);
 	template <class InputIterator>
 	void     insert(iterator         position,
@@ -84,7 +187,7 @@ class vector {
 			InputIterator            last);
 	iterator erase(iterator position);
 	iterator erase(iterator first, iterator last);
-	void     swap(vector<T, Allocator> &);
+	void     swap(vector<T, Allocator, GrowthPolicy> &);
 	void     clear();
 
   protected:
@@ -93,36 +196,84 @@ class vector {
 	iterator       m_end;
 	iterator       m_end_of_storage;
 	size_type      m_calculate_new_capacity(size_type n);
+	void           m_reallocate(size_type new_capacity);
+	void           m_reallocate(size_type new_capacity, false_type);
+	void           m_reallocate(size_type new_capacity, true_type);
+	// Range constructor, assign and insert. Input iterators can only be
+	// read once and are appended one at a time, forward iterators are
+	// measured first and copied in one go.
+	template <class InputIterator>
+	void m_range_initialize(InputIterator first, InputIterator last,
+		std::input_iterator_tag);
+	template <class ForwardIterator>
+	void m_range_initialize(ForwardIterator first, ForwardIterator last,
+		std::forward_iterator_tag);
+	template <class InputIterator>
+	void m_range_assign(InputIterator first, InputIterator last,
+		std::input_iterator_tag);
+	template <class ForwardIterator>
+	void m_range_assign(ForwardIterator first, ForwardIterator last,
+		std::forward_iterator_tag);
+	template <class InputIterator>
+	void m_range_insert(iterator position, InputIterator first,
+		InputIterator last, std::input_iterator_tag);
+	template <class ForwardIterator>
+	void m_range_insert(iterator position, ForwardIterator first,
+		ForwardIterator last, std::forward_iterator_tag);
+	// Slow path of push_back and emplace_back, the vector is full
+#if __cplusplus >= 201103L
+	template <class... Args>
+	FT_NOINLINE void m_realloc_append(Args &&...args);
+#else
+	FT_NOINLINE void m_realloc_append(const T &x);
+#endif
 };
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(const Allocator &allocator)
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(const Allocator &allocator)
 	: m_allocator(allocator), m_begin(0), m_end(0), m_end_of_storage(0) {}
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(
 	size_type n, const T &value, const Allocator &allocator)
 	: m_allocator(allocator), m_begin(m_allocator.allocate(n, this)),
 	  m_end(m_begin + n), m_end_of_storage(m_end) {
 	ft::uninitialized_fill_n(begin(), n, value, get_allocator());
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy>
 template <class InputIterator>
-vector<T, Allocator>::vector(
+vector<T, Allocator, GrowthPolicy>::vector(
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 		InputIterator>::type first,
-	InputIterator last, const Allocator &allocator) {
+	InputIterator last, const Allocator &allocator)
+	: m_allocator(allocator), m_begin(0), m_end(0), m_end_of_storage(0) {
+	m_range_initialize(first, last,
+		typename ft::iterator_traits<InputIterator>::iterator_category());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::m_range_initialize(
+	InputIterator first, InputIterator last, std::input_iterator_tag) {
+	for (; first != last; ++first) {
+		push_back(*first);
+	}
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class ForwardIterator>
+void vector<T, Allocator, GrowthPolicy>::m_range_initialize(
+	ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
 	const size_type n = ft::distance(first, last);
-	m_allocator = allocator;
 	m_begin = m_allocator.allocate(n, this);
-	m_end = m_begin + n;
-	m_end_of_storage = m_end;
-	ft::uninitialized_copy(first, last, begin(), get_allocator());
+	m_end_of_storage = m_begin + n;
+	m_end = ft::uninitialized_copy(first, last, m_begin, get_allocator());
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(const vector<T, Allocator> &x) {
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(
+	const vector<T, Allocator, GrowthPolicy> &x) {
 	m_allocator = x.get_allocator();
 	m_begin = m_allocator.allocate(x.size(), this);
 	m_end = m_begin + x.size();
@@ -130,15 +281,16 @@ vector<T, Allocator>::vector(const vector<T, Allocator> &x) {
 	ft::uninitialized_copy(x.begin(), x.end(), begin(), get_allocator());
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::~vector() {
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::~vector() {
 	clear();
 	m_allocator.deallocate(m_begin, capacity());
 }
 
-template <class T, class Allocator>
-vector<T, Allocator> &vector<T, Allocator>::operator=(
-	const vector<T, Allocator> &x) {
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy> &
+vector<T, Allocator, GrowthPolicy>::operator=(
+	const vector<T, Allocator, GrowthPolicy> &x) {
 	if (this == &x) {
 		return *this;
 	}
@@ -165,8 +317,35 @@ vector<T, Allocator> &vector<T, Allocator>::operator=(
 	return *this;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::assign(size_type n, const T &u) {
+#if __cplusplus >= 201103L
+// Takes over the block of x, which is left empty
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy>::vector(
+	vector<T, Allocator, GrowthPolicy> &&x) noexcept
+	: m_allocator(x.m_allocator), m_begin(x.m_begin), m_end(x.m_end),
+	  m_end_of_storage(x.m_end_of_storage) {
+	x.m_begin = x.m_end = x.m_end_of_storage = 0;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+vector<T, Allocator, GrowthPolicy> &
+vector<T, Allocator, GrowthPolicy>::operator=(
+	vector<T, Allocator, GrowthPolicy> &&x) noexcept {
+	if (this != &x) {
+		clear();
+		m_allocator.deallocate(m_begin, capacity());
+		m_allocator = x.m_allocator;
+		m_begin = x.m_begin;
+		m_end = x.m_end;
+		m_end_of_storage = x.m_end_of_storage;
+		x.m_begin = x.m_end = x.m_end_of_storage = 0;
+	}
+	return *this;
+}
+#endif
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::assign(size_type n, const T &u) {
 	if (capacity() < n) {
 		clear();
 		m_allocator.deallocate(begin(), capacity());
@@ -185,12 +364,36 @@ void vector<T, Allocator>::assign(size_type n, const T &u) {
 	}
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy>
 template <class InputIterator>
-void vector<T, Allocator>::assign(
+void vector<T, Allocator, GrowthPolicy>::assign(
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 		InputIterator>::type first,
 	InputIterator            last) {
+	m_range_assign(first, last,
+		typename ft::iterator_traits<InputIterator>::iterator_category());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::m_range_assign(
+	InputIterator first, InputIterator last, std::input_iterator_tag) {
+	iterator dst = begin();
+	for (; first != last && dst != end(); ++first) {
+		*dst++ = *first;
+	}
+	if (first == last) {
+		erase(dst, end());
+	}
+	for (; first != last; ++first) {
+		push_back(*first);
+	}
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class ForwardIterator>
+void vector<T, Allocator, GrowthPolicy>::m_range_assign(
+	ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
 	const size_type n = ft::distance(first, last);
 	if (capacity() < n) {
 		clear();
@@ -215,81 +418,78 @@ void vector<T, Allocator>::assign(
 	}
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::allocator_type
-vector<T, Allocator>::get_allocator() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::allocator_type
+vector<T, Allocator, GrowthPolicy>::get_allocator() const {
 	return m_allocator;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator vector<T, Allocator>::begin() {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::begin() {
 	return m_begin;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_iterator
-vector<T, Allocator>::begin() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator
+vector<T, Allocator, GrowthPolicy>::begin() const {
 	return m_begin;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator vector<T, Allocator>::end() {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::end() {
 	return m_end;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_iterator
-vector<T, Allocator>::end() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_iterator
+vector<T, Allocator, GrowthPolicy>::end() const {
 	return m_end;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reverse_iterator vector<T, Allocator>::rbegin() {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reverse_iterator
+vector<T, Allocator, GrowthPolicy>::rbegin() {
 	return reverse_iterator(end());
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reverse_iterator
-vector<T, Allocator>::rbegin() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reverse_iterator
+vector<T, Allocator, GrowthPolicy>::rbegin() const {
 	return const_reverse_iterator(end());
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reverse_iterator vector<T, Allocator>::rend() {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reverse_iterator
+vector<T, Allocator, GrowthPolicy>::rend() {
 	return reverse_iterator(begin());
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reverse_iterator
-vector<T, Allocator>::rend() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reverse_iterator
+vector<T, Allocator, GrowthPolicy>::rend() const {
 	return const_reverse_iterator(begin());
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::size_type vector<T, Allocator>::size() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::size() const {
 	return end() - begin();
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::size_type
-vector<T, Allocator>::max_size() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::max_size() const {
 	return m_allocator.max_size();
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::resize(size_type n, T val) {
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize(size_type n, T val) {
 	if (n > capacity()) {
-		const size_type new_capacity = m_calculate_new_capacity(n - size());
-		const iterator  new_begin = m_allocator.allocate(new_capacity, this);
-		iterator        dst =
-			ft::uninitialized_copy(begin(), end(), new_begin, get_allocator());
-		clear();
-		m_allocator.deallocate(begin(), capacity());
-		m_begin = new_begin;
-		m_end = new_begin + n;
-		m_end_of_storage = m_begin + new_capacity;
-		ft::uninitialized_fill(dst, end(), val, get_allocator());
-	} else if (n < size()) {
+		m_reallocate(m_calculate_new_capacity(n - size()));
+	}
+	if (n < size()) {
 		ft::destroy(begin() + n, end(), get_allocator());
 		m_end = begin() + n;
 	} else {
@@ -298,56 +498,69 @@ void vector<T, Allocator>::resize(size_type n, T val) {
 	}
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::size_type
-vector<T, Allocator>::capacity() const {
+// Like resize(), but the new elements are default initialized: those with a
+// trivial default constructor are left as the allocator returned them, for a
+// buffer that is about to be overwritten anyway
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::resize_uninitialized(size_type n) {
+	if (n > capacity()) {
+		m_reallocate(m_calculate_new_capacity(n - size()));
+	}
+	if (n < size()) {
+		ft::destroy(begin() + n, end(), get_allocator());
+	} else {
+		ft::uninitialized_default_construct(
+			end(), begin() + n, get_allocator());
+	}
+	m_end = begin() + n;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::capacity() const {
 	return m_end_of_storage - begin();
 }
 
-template <class T, class Allocator>
-bool vector<T, Allocator>::empty() const {
+template <class T, class Allocator, class GrowthPolicy>
+bool vector<T, Allocator, GrowthPolicy>::empty() const {
 	return begin() == end();
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::reserve(size_type n) {
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::reserve(size_type n) {
 	if (n <= capacity()) {
 		return;
 	} else if (n > max_size()) {
 		throw std::length_error(std::string("vector: reserve: n > max_size"));
 	}
-	const iterator new_begin = m_allocator.allocate(n, this);
-	const iterator new_end =
-		ft::uninitialized_copy(begin(), end(), new_begin, get_allocator());
-	clear();
-	m_allocator.deallocate(begin(), capacity());
-	m_begin = new_begin;
-	m_end = new_end;
-	m_end_of_storage = m_begin + n;
+	m_reallocate(n);
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reference vector<T, Allocator>::operator[](
-	size_type n) {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reference
+vector<T, Allocator, GrowthPolicy>::operator[](size_type n) {
 	return m_begin[n];
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reference vector<T, Allocator>::operator[](
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reference
+vector<T, Allocator, GrowthPolicy>::operator[](
 	size_type n) const {
 	return m_begin[n];
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reference vector<T, Allocator>::at(size_type n) {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reference
+vector<T, Allocator, GrowthPolicy>::at(size_type n) {
 	if (n >= size()) {
 		throw std::out_of_range(std::string("vector: index out of range"));
 	}
 	return m_begin[n];
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reference vector<T, Allocator>::at(
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reference
+vector<T, Allocator, GrowthPolicy>::at(
 	size_type n) const {
 	if (n >= size()) {
 		throw std::out_of_range(std::string("vector: index out of range"));
@@ -355,77 +568,159 @@ typename vector<T, Allocator>::const_reference vector<T, Allocator>::at(
 	return m_begin[n];
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reference vector<T, Allocator>::front() {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reference
+vector<T, Allocator, GrowthPolicy>::front() {
 	return *m_begin;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reference
-vector<T, Allocator>::front() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reference
+vector<T, Allocator, GrowthPolicy>::front() const {
 	return *m_begin;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::reference vector<T, Allocator>::back() {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::reference
+vector<T, Allocator, GrowthPolicy>::back() {
 	return *(m_end - 1);
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::const_reference
-vector<T, Allocator>::back() const {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::const_reference
+vector<T, Allocator, GrowthPolicy>::back() const {
 	return *(m_end - 1);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::push_back(const T &x) {
-	insert(end(), x);
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::push_back(const T &x) {
+	if (m_end != m_end_of_storage) {
+		m_allocator.construct(m_end, x);
+		++m_end;
+	} else {
+		m_realloc_append(x);
+	}
+}
+
+// Makes room for n more elements and lets writer(first, n) construct them in
+// place, straight from a read() or a decoder. writer returns how many it
+// constructed, at most n, and the size grows by that many.
+template <class T, class Allocator, class GrowthPolicy>
+template <class Writer>
+typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::append_with(size_type n, Writer writer) {
+	if (n > capacity() - size()) {
+		m_reallocate(m_calculate_new_capacity(n));
+	}
+	const size_type written = writer(m_end, n);
+	m_end += written;
+	return written;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::pop_back() {
+#if __cplusplus >= 201103L
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::push_back(T &&x) {
+	if (m_end != m_end_of_storage) {
+		m_allocator.construct(m_end, std::move(x));
+		++m_end;
+	} else {
+		m_realloc_append(std::move(x));
+	}
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class... Args>
+typename vector<T, Allocator, GrowthPolicy>::reference
+vector<T, Allocator, GrowthPolicy>::emplace_back(Args &&...args) {
+	if (m_end != m_end_of_storage) {
+		std::allocator_traits<Allocator>::construct(
+			m_allocator, m_end, std::forward<Args>(args)...);
+		++m_end;
+	} else {
+		m_realloc_append(std::forward<Args>(args)...);
+	}
+	return back();
+}
+#endif
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::pop_back() {
 	if (size()) {
 		m_end--;
 		m_allocator.destroy(m_end);
 	}
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator vector<T, Allocator>::insert(
-	iterator position, const T &x) {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::insert(iterator position, const T &x) {
 	const size_type n = position - begin();
 	insert(position, 1, x);
 	return begin() + n;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::insert(
+#if __cplusplus >= 201103L
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::insert(iterator position, T &&x) {
+	const size_type n = position - begin();
+	if (position == end()) {
+		push_back(std::move(x));
+	} else if (m_end != m_end_of_storage) {
+		m_allocator.construct(m_end, std::move(back()));
+		ft::move_backward(position, m_end - 1, m_end);
+		++m_end;
+		*position = std::move(x);
+	} else {
+		const size_type new_capacity = m_calculate_new_capacity(1);
+		const iterator  new_begin = m_allocator.allocate(new_capacity, this);
+		m_allocator.construct(new_begin + n, std::move(x));
+		ft::uninitialized_move_if_noexcept(
+			begin(), position, new_begin, get_allocator());
+		const iterator dst = ft::uninitialized_move_if_noexcept(
+			position, end(), new_begin + n + 1, get_allocator());
+		clear();
+		m_allocator.deallocate(m_begin, capacity());
+		m_begin = new_begin;
+		m_end = dst;
+		m_end_of_storage = m_begin + new_capacity;
+	}
+	return begin() + n;
+}
+#endif
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::insert(
 	iterator position, size_type count, const T &x) {
 	if (count == 0) {
 		return;
 	}
 	if (size() + count <= capacity()) {
+		// x may be an element about to be shifted
+		const T value = x;
 		if (static_cast<size_type>(end() - position) > count) {
-			ft::uninitialized_copy(
+			ft::uninitialized_move_if_noexcept(
 				end() - count, end(), end(), get_allocator());
-			ft::copy_backward(position, end() - count, end());
-			ft::fill(position, position + count, x);
+			ft::move_backward(position, end() - count, end());
+			ft::fill(position, position + count, value);
 		} else {
-			ft::uninitialized_copy(
+			ft::uninitialized_move_if_noexcept(
 				position, end(), position + count, get_allocator());
 			ft::uninitialized_fill_n(
-				end(), count - (end() - position), x, get_allocator());
-			ft::fill(position, end(), x);
+				end(), count - (end() - position), value, get_allocator());
+			ft::fill(position, end(), value);
 		}
 		m_end += count;
 	} else {
 		const size_type new_capacity = m_calculate_new_capacity(count);
 		const iterator  new_begin = m_allocator.allocate(new_capacity, this);
-		iterator        dst = ft::uninitialized_copy(
-				   begin(), position, new_begin, get_allocator());
-		ft::uninitialized_fill_n(dst, count, x, get_allocator());
-		dst = ft::uninitialized_copy(
-			position, end(), dst + count, get_allocator());
+		const iterator  new_position = new_begin + (position - begin());
+		// Fill first, x may be an element about to be moved
+		ft::uninitialized_fill_n(new_position, count, x, get_allocator());
+		ft::uninitialized_move_if_noexcept(
+			begin(), position, new_begin, get_allocator());
+		const iterator dst = ft::uninitialized_move_if_noexcept(
+			position, end(), new_position + count, get_allocator());
 		clear();
 		m_allocator.deallocate(m_begin, m_end_of_storage - m_begin);
 		m_begin = new_begin;
@@ -434,130 +729,237 @@ void vector<T, Allocator>::insert(
 	}
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy>
 template <class InputIterator>
-void vector<T, Allocator>::insert(iterator position,
+void vector<T, Allocator, GrowthPolicy>::insert(iterator position,
 	typename ft::enable_if<!ft::is_integral<InputIterator>::value,
 		InputIterator>::type               first,
 	InputIterator                          last) {
+	m_range_insert(position, first, last,
+		typename ft::iterator_traits<InputIterator>::iterator_category());
+}
+
+// Appends the range, growing geometrically, and rotates it into place
+template <class T, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+void vector<T, Allocator, GrowthPolicy>::m_range_insert(iterator position,
+	InputIterator first, InputIterator last, std::input_iterator_tag) {
+	const size_type offset = position - begin();
+	const size_type old_size = size();
+	for (; first != last; ++first) {
+		push_back(*first);
+	}
+	ft::rotate(begin() + offset, begin() + old_size, end());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class ForwardIterator>
+void vector<T, Allocator, GrowthPolicy>::m_range_insert(iterator position,
+	ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
 	if (first == last) {
 		return;
 	}
 	const size_type n = ft::distance(first, last);
 	if (size() + n <= capacity()) {
-		if (static_cast<size_type>(end() - position) > n) {
-			ft::uninitialized_copy(end() - n, end(), end(), get_allocator());
-			ft::copy_backward(position, position + n, end());
+		const size_type elements_after = end() - position;
+		if (elements_after > n) {
+			ft::uninitialized_move_if_noexcept(
+				end() - n, end(), end(), get_allocator());
+			ft::move_backward(position, end() - n, end());
 			ft::copy(first, last, position);
 		} else {
-			ft::uninitialized_copy(
+			ForwardIterator middle = first;
+			ft::advance(middle, elements_after);
+			ft::uninitialized_move_if_noexcept(
 				position, end(), position + n, get_allocator());
-			InputIterator it = first;
-			ft::advance(it, end() - position);
-			ft::copy(first, it, position);
-			ft::uninitialized_copy(it, last, end(), get_allocator());
+			ft::copy(first, middle, position);
+			ft::uninitialized_copy(middle, last, end(), get_allocator());
 		}
 		m_end += n;
 	} else {
 		const size_type new_capacity = m_calculate_new_capacity(n);
 		const iterator  new_begin = m_allocator.allocate(new_capacity, this);
-		iterator        dst = ft::uninitialized_copy(
-				   begin(), position, new_begin, get_allocator());
-		ft::uninitialized_copy(position, end(), dst + n, get_allocator());
-		ft::uninitialized_copy(first, last, dst, get_allocator());
-		dst = ft::uninitialized_copy(position, end(), dst + n, get_allocator());
+		const iterator  new_position = new_begin + (position - begin());
+		ft::uninitialized_copy(first, last, new_position, get_allocator());
+		ft::uninitialized_move_if_noexcept(
+			begin(), position, new_begin, get_allocator());
+		const iterator dst = ft::uninitialized_move_if_noexcept(
+			position, end(), new_position + n, get_allocator());
 		clear();
 		m_allocator.deallocate(m_begin, m_end_of_storage - m_begin);
 		m_begin = new_begin;
 		m_end = dst;
 		m_end_of_storage = m_begin + new_capacity;
 	}
-	return;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator vector<T, Allocator>::erase(
-	iterator position) {
-	iterator ret = position;
-	for (; position + 1 != end(); position++) {
-		*position = *(position + 1);
-	}
-	m_allocator.destroy(m_end);
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::erase(iterator position) {
+	ft::move(position + 1, end(), position);
 	--m_end;
-	return ret;
+	m_allocator.destroy(m_end);
+	return position;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::iterator vector<T, Allocator>::erase(
-	iterator first, iterator last) {
-	iterator src = last;
-	iterator dst = first;
-	while (src != end()) {
-		*dst++ = *src++;
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::iterator
+vector<T, Allocator, GrowthPolicy>::erase(iterator first, iterator last) {
+	// Moving the tail onto itself would empty moved-from elements
+	if (first == last) {
+		return first;
 	}
+	const iterator dst = ft::move(last, end(), first);
 	ft::destroy(dst, end(), get_allocator());
 	m_end = dst;
 	return first;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::swap(vector<T, Allocator> &x) {
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::swap(
+	vector<T, Allocator, GrowthPolicy> &x) {
 	ft::swap(m_allocator, x.m_allocator);
 	ft::swap(m_begin, x.m_begin);
 	ft::swap(m_end, x.m_end);
 	ft::swap(m_end_of_storage, x.m_end_of_storage);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::clear() {
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::clear() {
 	ft::destroy(begin(), end(), get_allocator());
 	m_end = m_begin;
 }
 
-template <class T, class Allocator>
-typename vector<T, Allocator>::size_type
-vector<T, Allocator>::m_calculate_new_capacity(size_type n) {
+template <class T, class Allocator, class GrowthPolicy>
+typename vector<T, Allocator, GrowthPolicy>::size_type
+vector<T, Allocator, GrowthPolicy>::m_calculate_new_capacity(size_type n) {
 	if (max_size() - size() < n) {
 		throw std::length_error(
 			std::string("vector: capacity: size() + n > max_size"));
 	}
-	const size_type len = size() + ft::max(size(), n);
-	return (len < size() || len > max_size()) ? max_size() : len;
+	const size_type len = GrowthPolicy::next_capacity(size(), n, sizeof(T));
+	return (len < size() + n || len > max_size()) ? max_size() : len;
+}
+
+// The new element is constructed first: its arguments may refer to elements
+// of the old block
+#if __cplusplus >= 201103L
+template <class T, class Allocator, class GrowthPolicy>
+template <class... Args>
+void vector<T, Allocator, GrowthPolicy>::m_realloc_append(Args &&...args) {
+#else
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::m_realloc_append(const T &x) {
+#endif
+	const size_type new_capacity = m_calculate_new_capacity(1);
+	if (detail::is_reallocatable<T, Allocator>::value) {
+		// The block is resized in place, take the new element out of it first
+#if __cplusplus >= 201103L
+		T value(std::forward<Args>(args)...);
+		m_reallocate(new_capacity);
+		m_allocator.construct(m_end, std::move(value));
+#else
+		const T value(x);
+		m_reallocate(new_capacity);
+		m_allocator.construct(m_end, value);
+#endif
+		++m_end;
+		return;
+	}
+	const iterator new_begin = m_allocator.allocate(new_capacity, this);
+#if __cplusplus >= 201103L
+	std::allocator_traits<Allocator>::construct(
+		m_allocator, new_begin + size(), std::forward<Args>(args)...);
+#else
+	m_allocator.construct(new_begin + size(), x);
+#endif
+	const iterator new_end = ft::uninitialized_move_if_noexcept(
+		begin(), end(), new_begin, get_allocator());
+	clear();
+	m_allocator.deallocate(m_begin, capacity());
+	m_begin = new_begin;
+	m_end = new_end + 1;
+	m_end_of_storage = m_begin + new_capacity;
+}
+
+// Moves the elements to a block of new_capacity, through the allocator's
+// reallocate() when the element type allows it
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::m_reallocate(size_type new_capacity) {
+	m_reallocate(new_capacity,
+		typename detail::is_reallocatable<T, Allocator>::type());
 }
 
-template <class T, class Allocator>
-bool operator==(const vector<T, Allocator> &x, const vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::m_reallocate(
+	size_type new_capacity, false_type) {
+	const iterator new_begin = m_allocator.allocate(new_capacity, this);
+	const iterator new_end = ft::uninitialized_move_if_noexcept(
+		begin(), end(), new_begin, get_allocator());
+	clear();
+	m_allocator.deallocate(m_begin, capacity());
+	m_begin = new_begin;
+	m_end = new_end;
+	m_end_of_storage = m_begin + new_capacity;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void vector<T, Allocator, GrowthPolicy>::m_reallocate(
+	size_type new_capacity, true_type) {
+	const size_type n = size();
+	m_begin = m_allocator.reallocate(m_begin, capacity(), new_capacity);
+	m_end = m_begin + n;
+	m_end_of_storage = m_begin + new_capacity;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+bool operator==(const vector<T, Allocator, GrowthPolicy> &x,
+	const vector<T, Allocator, GrowthPolicy> &y) {
 	return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin());
 }
 
-template <class T, class Allocator>
-bool operator!=(const vector<T, Allocator> &x, const vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+bool operator!=(const vector<T, Allocator, GrowthPolicy> &x,
+	const vector<T, Allocator, GrowthPolicy> &y) {
 	return !(x == y);
 }
 
-template <class T, class Allocator>
-bool operator<(const vector<T, Allocator> &x, const vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+bool operator<(const vector<T, Allocator, GrowthPolicy> &x,
+	const vector<T, Allocator, GrowthPolicy> &y) {
 	return ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
 }
 
-template <class T, class Allocator>
-bool operator>(const vector<T, Allocator> &x, const vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+bool operator>(const vector<T, Allocator, GrowthPolicy> &x,
+	const vector<T, Allocator, GrowthPolicy> &y) {
 	return y < x;
 }
 
-template <class T, class Allocator>
-bool operator<=(const vector<T, Allocator> &x, const vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+bool operator<=(const vector<T, Allocator, GrowthPolicy> &x,
+	const vector<T, Allocator, GrowthPolicy> &y) {
 	return !(y < x);
 }
 
-template <class T, class Allocator>
-bool operator>=(const vector<T, Allocator> &x, const vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+bool operator>=(const vector<T, Allocator, GrowthPolicy> &x,
+	const vector<T, Allocator, GrowthPolicy> &y) {
 	return !(x < y);
 }
 
-template <class T, class Allocator>
-void swap(vector<T, Allocator> &x, vector<T, Allocator> &y) {
+template <class T, class Allocator, class GrowthPolicy>
+void swap(vector<T, Allocator, GrowthPolicy> &x,
+	vector<T, Allocator, GrowthPolicy> &y) {
 	x.swap(y);
 }
 
+// A vector only points to its block, it can be relocated whenever its
+// allocator can
+template <class T, class Allocator, class GrowthPolicy>
+struct is_trivially_relocatable<vector<T, Allocator, GrowthPolicy> >
+	: public is_trivially_relocatable<Allocator> {};
+
 }  // namespace ft
+
+#include "vector_bool.hpp"
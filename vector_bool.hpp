@@ -0,0 +1,847 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+namespace detail {
+
+typedef unsigned long bit_word;
+
+static const std::size_t bits_per_word = sizeof(bit_word) * 8;
+
+// Words holding n bits
+inline std::size_t bit_words(std::size_t n) {
+	return (n + bits_per_word - 1) / bits_per_word;
+}
+
+// Mask of the bits of a word below offset
+inline bit_word low_bits(std::size_t offset) {
+	return (bit_word(1) << offset) - 1;
+}
+
+// Sets the n bits from pos to value, a word at a time
+inline void fill_bits(
+	bit_word *words, std::size_t pos, std::size_t n, bool value) {
+	while (n != 0) {
+		const std::size_t offset = pos % bits_per_word;
+		const std::size_t count = ft::min(n, bits_per_word - offset);
+		const bit_word    mask =
+			(count == bits_per_word ? ~bit_word(0) : low_bits(count)) << offset;
+		if (value) {
+			words[pos / bits_per_word] |= mask;
+		} else {
+			words[pos / bits_per_word] &= ~mask;
+		}
+		pos += count;
+		n -= count;
+	}
+}
+
+// Moves the bits [pos, size) n places up, leaving [pos, pos + n) clear. The
+// words must have room for size + n bits and the ones past size must be
+// clear. The tail is shifted as one big number: every word is put together
+// from the two it straddles, from the top down.
+inline void shift_bits_up(
+	bit_word *words, std::size_t pos, std::size_t n, std::size_t size) {
+	const std::size_t first = pos / bits_per_word;
+	const std::size_t old_words = bit_words(size);
+	const std::size_t shift = n % bits_per_word;
+	const bit_word    low = words[first] & low_bits(pos % bits_per_word);
+
+	words[first] &= ~low_bits(pos % bits_per_word);
+	for (std::size_t i = bit_words(size + n); i-- > first;) {
+		bit_word word = 0;
+		if (i >= first + n / bits_per_word) {
+			const std::size_t src = i - n / bits_per_word;
+			if (src < old_words) {
+				word = words[src] << shift;
+			}
+			if (shift != 0 && src > first && src - 1 < old_words) {
+				word |= words[src - 1] >> (bits_per_word - shift);
+			}
+		}
+		words[i] = word;
+	}
+	words[first] |= low;
+}
+
+// Moves the bits [pos + n, size) n places down over [pos, pos + n), the n
+// bits freed at the top are cleared. The bits past size must be clear.
+inline void shift_bits_down(
+	bit_word *words, std::size_t pos, std::size_t n, std::size_t size) {
+	const std::size_t first = pos / bits_per_word;
+	const std::size_t old_words = bit_words(size);
+	const std::size_t shift = n % bits_per_word;
+	const bit_word    low = words[first] & low_bits(pos % bits_per_word);
+
+	for (std::size_t i = first; i < old_words; i++) {
+		const std::size_t src = i + n / bits_per_word;
+		bit_word          word = 0;
+		if (src < old_words) {
+			word = words[src] >> shift;
+		}
+		if (shift != 0 && src + 1 < old_words) {
+			word |= words[src + 1] << (bits_per_word - shift);
+		}
+		words[i] = word;
+	}
+	words[first] = (words[first] & ~low_bits(pos % bits_per_word)) | low;
+}
+
+// Stands for one bit of a vector<bool>: converts to bool and assigns it
+class bit_reference {
+  public:
+	bit_reference(bit_word *word, bit_word mask) : m_word(word), m_mask(mask) {}
+
+	bit_reference(const bit_reference &x)
+		: m_word(x.m_word), m_mask(x.m_mask) {}
+
+	operator bool() const {
+		return (*m_word & m_mask) != 0;
+	}
+
+	bit_reference &operator=(bool x) {
+		if (x) {
+			*m_word |= m_mask;
+		} else {
+			*m_word &= ~m_mask;
+		}
+		return *this;
+	}
+
+	bit_reference &operator=(const bit_reference &x) {
+		return *this = bool(x);
+	}
+
+	bool operator~() const {
+		return !bool(*this);
+	}
+
+	void flip() {
+		*m_word ^= m_mask;
+	}
+
+  private:
+	bit_word *m_word;
+	bit_word  m_mask;
+};
+
+// A word and the offset of a bit in it
+template <bool isconst = false>
+class bit_iterator {
+  public:
+	typedef std::random_access_iterator_tag iterator_category;
+	typedef bool                            value_type;
+	typedef std::ptrdiff_t                  difference_type;
+	typedef void                            pointer;
+	typedef typename ft::choose<isconst, bool, bit_reference>::type reference;
+	typedef typename ft::choose<isconst, const bit_word *, bit_word *>::type
+		word_pointer;
+
+	bit_iterator(word_pointer word = 0, std::size_t offset = 0)
+		: m_word(word), m_offset(offset) {}
+
+	bit_iterator(const bit_iterator<false> &rhs)
+		: m_word(rhs.word()), m_offset(rhs.offset()) {}
+
+	bit_iterator &operator=(const bit_iterator<false> &rhs) {
+		m_word = rhs.word();
+		m_offset = rhs.offset();
+		return *this;
+	}
+
+	reference operator*() const {
+		return m_dereference(ft::integral_constant<bool, isconst>());
+	}
+
+	reference operator[](difference_type n) const {
+		return *(*this + n);
+	}
+
+	bit_iterator &operator++() {
+		if (++m_offset == bits_per_word) {
+			m_offset = 0;
+			++m_word;
+		}
+		return *this;
+	}
+
+	bit_iterator operator++(int) {
+		bit_iterator tmp(*this);
+		++*this;
+		return tmp;
+	}
+
+	bit_iterator &operator--() {
+		if (m_offset-- == 0) {
+			m_offset = bits_per_word - 1;
+			--m_word;
+		}
+		return *this;
+	}
+
+	bit_iterator operator--(int) {
+		bit_iterator tmp(*this);
+		--*this;
+		return tmp;
+	}
+
+	bit_iterator &operator+=(difference_type n) {
+		difference_type bit = n + static_cast<difference_type>(m_offset);
+		difference_type word = bit / difference_type(bits_per_word);
+		bit %= difference_type(bits_per_word);
+		if (bit < 0) {
+			bit += bits_per_word;
+			--word;
+		}
+		m_word += word;
+		m_offset = bit;
+		return *this;
+	}
+
+	bit_iterator &operator-=(difference_type n) {
+		return *this += -n;
+	}
+
+	bit_iterator operator+(difference_type n) const {
+		bit_iterator tmp(*this);
+		return tmp += n;
+	}
+
+	bit_iterator operator-(difference_type n) const {
+		bit_iterator tmp(*this);
+		return tmp -= n;
+	}
+
+	friend bit_iterator operator+(difference_type n, const bit_iterator &x) {
+		return x + n;
+	}
+
+	friend difference_type operator-(
+		const bit_iterator &x, const bit_iterator &y) {
+		return (x.m_word - y.m_word) * difference_type(bits_per_word)
+			+ difference_type(x.m_offset) - difference_type(y.m_offset);
+	}
+
+	friend bool operator==(const bit_iterator &x, const bit_iterator &y) {
+		return x.m_word == y.m_word && x.m_offset == y.m_offset;
+	}
+
+	friend bool operator!=(const bit_iterator &x, const bit_iterator &y) {
+		return !(x == y);
+	}
+
+	friend bool operator<(const bit_iterator &x, const bit_iterator &y) {
+		return x.m_word < y.m_word
+			|| (x.m_word == y.m_word && x.m_offset < y.m_offset);
+	}
+
+	friend bool operator>(const bit_iterator &x, const bit_iterator &y) {
+		return y < x;
+	}
+
+	friend bool operator<=(const bit_iterator &x, const bit_iterator &y) {
+		return !(y < x);
+	}
+
+	friend bool operator>=(const bit_iterator &x, const bit_iterator &y) {
+		return !(x < y);
+	}
+
+	word_pointer word() const {
+		return m_word;
+	}
+
+	std::size_t offset() const {
+		return m_offset;
+	}
+
+  protected:
+	word_pointer m_word;
+	std::size_t  m_offset;
+
+	bool m_dereference(true_type) const {
+		return (*m_word >> m_offset) & 1;
+	}
+
+	bit_reference m_dereference(false_type) const {
+		return bit_reference(m_word, bit_word(1) << m_offset);
+	}
+};
+
+}  // namespace detail
+
+// Swaps the bits two references stand for, ft::swap(v[i], v[j])
+inline void swap(detail::bit_reference x, detail::bit_reference y) {
+	const bool tmp = x;
+	x = y;
+	y = tmp;
+}
+
+inline void swap(detail::bit_reference x, bool &y) {
+	const bool tmp = x;
+	x = y;
+	y = tmp;
+}
+
+inline void swap(bool &x, detail::bit_reference y) {
+	swap(y, x);
+}
+
+// Packs the flags bits_per_word to an unsigned long, least significant bit
+// first, an eighth of the memory of one bool per element. Elements are read
+// and written through detail::bit_reference. count(), find_first(),
+// find_next() and the bitwise operators go a word at a time, insert() and
+// erase() shift the words after the position by whole words and bits.
+//
+// The bits past size() are kept clear, so that whole words can be counted,
+// compared and combined without masking the last one.
+template <class Allocator, class GrowthPolicy>
+class vector<bool, Allocator, GrowthPolicy> {
+  public:
+	// types
+	typedef detail::bit_reference                reference;
+	typedef bool                                 const_reference;
+	typedef detail::bit_iterator<false>          iterator;
+	typedef detail::bit_iterator<true>           const_iterator;
+	typedef std::size_t                          size_type;
+	typedef std::ptrdiff_t                       difference_type;
+	typedef bool                                 value_type;
+	typedef Allocator                            allocator_type;
+	typedef ft::reverse_iterator<iterator>       reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+	typedef GrowthPolicy                         growth_policy;
+	typedef detail::bit_word                     word_type;
+
+	static const size_type npos = static_cast<size_type>(-1);
+
+  private:
+	typedef typename Allocator::template rebind<word_type>::other
+		word_allocator_type;
+
+	static const size_type bits_per_word = detail::bits_per_word;
+
+  public:
+	// constructor/copy/destroy
+	explicit vector(const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_words(0), m_size(0), m_capacity(0) {}
+
+	explicit vector(size_type n, const bool &value = false,
+		const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_words(0), m_size(0), m_capacity(0) {
+		assign(n, value);
+	}
+
+	template <class InputIterator>
+	vector(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			   InputIterator>::type first,
+		InputIterator last, const Allocator &allocator = Allocator())
+		: m_allocator(allocator), m_words(0), m_size(0), m_capacity(0) {
+		assign(first, last);
+	}
+
+	vector(const vector<bool, Allocator, GrowthPolicy> &x)
+		: m_allocator(x.m_allocator), m_words(0), m_size(0), m_capacity(0) {
+		m_copy_words(x);
+	}
+
+	~vector() {
+		m_allocator.deallocate(m_words, m_capacity);
+	}
+
+	vector<bool, Allocator, GrowthPolicy> &operator=(
+		const vector<bool, Allocator, GrowthPolicy> &x) {
+		if (this != &x) {
+			m_copy_words(x);
+		}
+		return *this;
+	}
+
+#if __cplusplus >= 201103L
+	vector(vector<bool, Allocator, GrowthPolicy> &&x) noexcept
+		: m_allocator(x.m_allocator), m_words(x.m_words), m_size(x.m_size),
+		  m_capacity(x.m_capacity) {
+		x.m_words = 0;
+		x.m_size = x.m_capacity = 0;
+	}
+
+	vector<bool, Allocator, GrowthPolicy> &operator=(
+		vector<bool, Allocator, GrowthPolicy> &&x) noexcept {
+		if (this != &x) {
+			m_allocator.deallocate(m_words, m_capacity);
+			m_allocator = x.m_allocator;
+			m_words = x.m_words;
+			m_size = x.m_size;
+			m_capacity = x.m_capacity;
+			x.m_words = 0;
+			x.m_size = x.m_capacity = 0;
+		}
+		return *this;
+	}
+#endif
+
+	void assign(size_type n, const bool &value) {
+		m_reset(n);
+		detail::fill_bits(m_words, 0, n, value);
+		m_size = n;
+	}
+
+	template <class InputIterator>
+	void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+					InputIterator>::type first,
+		InputIterator                    last) {
+		m_range_assign(first, last,
+			typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	allocator_type get_allocator() const {
+		return allocator_type(m_allocator);
+	}
+
+	// iterators
+	iterator begin() {
+		return iterator(m_words, 0);
+	}
+
+	const_iterator begin() const {
+		return const_iterator(m_words, 0);
+	}
+
+	iterator end() {
+		return iterator(
+			m_words + m_size / bits_per_word, m_size % bits_per_word);
+	}
+
+	const_iterator end() const {
+		return const_iterator(
+			m_words + m_size / bits_per_word, m_size % bits_per_word);
+	}
+
+	reverse_iterator rbegin() {
+		return reverse_iterator(end());
+	}
+
+	const_reverse_iterator rbegin() const {
+		return const_reverse_iterator(end());
+	}
+
+	reverse_iterator rend() {
+		return reverse_iterator(begin());
+	}
+
+	const_reverse_iterator rend() const {
+		return const_reverse_iterator(begin());
+	}
+
+	// capacity
+	size_type size() const {
+		return m_size;
+	}
+
+	size_type max_size() const {
+		const size_type words = m_allocator.max_size();
+		return words > npos / bits_per_word ? npos : words * bits_per_word;
+	}
+
+	void resize(size_type n, bool value = false) {
+		if (n > capacity()) {
+			m_reallocate(m_calculate_new_capacity(n - m_size));
+		}
+		if (n < m_size) {
+			detail::fill_bits(m_words, n, m_size - n, false);
+		} else {
+			detail::fill_bits(m_words, m_size, n - m_size, value);
+		}
+		m_size = n;
+	}
+
+	size_type capacity() const {
+		return m_capacity * bits_per_word;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	void reserve(size_type n) {
+		if (n <= capacity()) {
+			return;
+		} else if (n > max_size()) {
+			throw std::length_error(
+				std::string("vector: reserve: n > max_size"));
+		}
+		m_reallocate(detail::bit_words(n));
+	}
+
+	// element access
+	reference operator[](size_type n) {
+		return reference(
+			m_words + n / bits_per_word, word_type(1) << n % bits_per_word);
+	}
+
+	const_reference operator[](size_type n) const {
+		return (m_words[n / bits_per_word] >> n % bits_per_word) & 1;
+	}
+
+	reference at(size_type n) {
+		if (n >= m_size) {
+			throw std::out_of_range(std::string("vector: index out of range"));
+		}
+		return (*this)[n];
+	}
+
+	const_reference at(size_type n) const {
+		if (n >= m_size) {
+			throw std::out_of_range(std::string("vector: index out of range"));
+		}
+		return (*this)[n];
+	}
+
+	reference front() {
+		return (*this)[0];
+	}
+
+	const_reference front() const {
+		return (*this)[0];
+	}
+
+	reference back() {
+		return (*this)[m_size - 1];
+	}
+
+	const_reference back() const {
+		return (*this)[m_size - 1];
+	}
+
+	// The bits, bit_words(size()) words of them
+	const word_type *words() const {
+		return m_words;
+	}
+
+	// bit operations
+	// Number of true elements
+	size_type count() const {
+		size_type       n = 0;
+		const size_type words = detail::bit_words(m_size);
+		for (size_type i = 0; i < words; i++) {
+			n += __builtin_popcountl(m_words[i]);
+		}
+		return n;
+	}
+
+	// Index of the first true element, npos if there is none
+	size_type find_first() const {
+		return m_size == 0 ? npos : m_find_from(0, m_words[0]);
+	}
+
+	// Index of the first true element after pos, npos if there is none
+	size_type find_next(size_type pos) const {
+		if (m_size == 0 || pos >= m_size - 1) {
+			return npos;
+		}
+		pos++;
+		const size_type i = pos / bits_per_word;
+		return m_find_from(
+			i, m_words[i] & ~detail::low_bits(pos % bits_per_word));
+	}
+
+	// Element-wise operators, both vectors have to be the same size
+	vector<bool, Allocator, GrowthPolicy> &operator&=(
+		const vector<bool, Allocator, GrowthPolicy> &x) {
+		m_check_size(x, "&=");
+		for (size_type i = 0; i < detail::bit_words(m_size); i++) {
+			m_words[i] &= x.m_words[i];
+		}
+		return *this;
+	}
+
+	vector<bool, Allocator, GrowthPolicy> &operator|=(
+		const vector<bool, Allocator, GrowthPolicy> &x) {
+		m_check_size(x, "|=");
+		for (size_type i = 0; i < detail::bit_words(m_size); i++) {
+			m_words[i] |= x.m_words[i];
+		}
+		return *this;
+	}
+
+	vector<bool, Allocator, GrowthPolicy> &operator^=(
+		const vector<bool, Allocator, GrowthPolicy> &x) {
+		m_check_size(x, "^=");
+		for (size_type i = 0; i < detail::bit_words(m_size); i++) {
+			m_words[i] ^= x.m_words[i];
+		}
+		return *this;
+	}
+
+	// Negates every element
+	void flip() {
+		const size_type words = detail::bit_words(m_size);
+		for (size_type i = 0; i < words; i++) {
+			m_words[i] = ~m_words[i];
+		}
+		if (m_size % bits_per_word != 0) {
+			m_words[words - 1] &= detail::low_bits(m_size % bits_per_word);
+		}
+	}
+
+	// modifiers
+	void push_back(const bool &x) {
+		if (m_size == capacity()) {
+			m_reallocate(m_calculate_new_capacity(1));
+		}
+		if (x) {
+			m_words[m_size / bits_per_word] |= word_type(1)
+				<< m_size % bits_per_word;
+		}
+		++m_size;
+	}
+
+	void pop_back() {
+		if (m_size) {
+			(*this)[--m_size] = false;
+		}
+	}
+
+	iterator insert(iterator position, const bool &x) {
+		const size_type pos = position - begin();
+		insert(position, 1, x);
+		return begin() + pos;
+	}
+
+	void insert(iterator position, size_type n, const bool &x) {
+		const size_type pos = position - begin();
+		const bool      value = x;
+		m_make_room(pos, n);
+		detail::fill_bits(m_words, pos, n, value);
+	}
+
+	template <class InputIterator>
+	void insert(iterator position,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value,
+			InputIterator>::type first,
+		InputIterator            last) {
+		m_range_insert(position, first, last,
+			typename ft::iterator_traits<InputIterator>::iterator_category());
+	}
+
+	iterator erase(iterator position) {
+		return erase(position, position + 1);
+	}
+
+	iterator erase(iterator first, iterator last) {
+		const size_type pos = first - begin();
+		const size_type n = last - first;
+		if (n != 0) {
+			detail::shift_bits_down(m_words, pos, n, m_size);
+			m_size -= n;
+		}
+		return begin() + pos;
+	}
+
+	void swap(vector<bool, Allocator, GrowthPolicy> &x) {
+		ft::swap(m_allocator, x.m_allocator);
+		ft::swap(m_words, x.m_words);
+		ft::swap(m_size, x.m_size);
+		ft::swap(m_capacity, x.m_capacity);
+	}
+
+	static void swap(reference x, reference y) {
+		ft::swap(x, y);
+	}
+
+	void clear() {
+		ft::fill(m_words, m_words + detail::bit_words(m_size), word_type(0));
+		m_size = 0;
+	}
+
+  private:
+	word_allocator_type m_allocator;
+	word_type          *m_words;
+	// In bits
+	size_type           m_size;
+	// In words
+	size_type           m_capacity;
+
+	// Words for size() + n bits, from the growth policy
+	size_type m_calculate_new_capacity(size_type n) {
+		if (max_size() - m_size < n) {
+			throw std::length_error(
+				std::string("vector: capacity: size() + n > max_size"));
+		}
+		const size_type words = detail::bit_words(m_size);
+		const size_type needed = detail::bit_words(m_size + n) - words;
+		const size_type max_words = max_size() / bits_per_word;
+		const size_type len =
+			GrowthPolicy::next_capacity(words, needed, sizeof(word_type));
+		return (len < words + needed || len > max_words) ? max_words : len;
+	}
+
+	// Moves the bits to a block of new_capacity words, the rest is cleared
+	void m_reallocate(size_type new_capacity) {
+		word_type      *words = m_allocator.allocate(new_capacity, this);
+		const size_type used = detail::bit_words(m_size);
+		ft::fill(ft::copy(m_words, m_words + used, words), words + new_capacity,
+			word_type(0));
+		m_allocator.deallocate(m_words, m_capacity);
+		m_words = words;
+		m_capacity = new_capacity;
+	}
+
+	// Empties the vector and gives it room for exactly n bits if it has less
+	void m_reset(size_type n) {
+		clear();
+		if (detail::bit_words(n) > m_capacity) {
+			m_allocator.deallocate(m_words, m_capacity);
+			m_words = 0;
+			m_capacity = 0;
+			m_reallocate(detail::bit_words(n));
+		}
+	}
+
+	void m_copy_words(const vector<bool, Allocator, GrowthPolicy> &x) {
+		m_reset(x.m_size);
+		ft::copy(x.m_words, x.m_words + detail::bit_words(x.m_size), m_words);
+		m_size = x.m_size;
+	}
+
+	// Shifts the bits from pos up to make room for n clear ones
+	void m_make_room(size_type pos, size_type n) {
+		if (n == 0) {
+			return;
+		}
+		if (n > capacity() - m_size) {
+			m_reallocate(m_calculate_new_capacity(n));
+		}
+		detail::shift_bits_up(m_words, pos, n, m_size);
+		m_size += n;
+	}
+
+	// Index of the first set bit of word, or of the words after it
+	size_type m_find_from(size_type i, word_type word) const {
+		const size_type words = detail::bit_words(m_size);
+		while (word == 0) {
+			if (++i == words) {
+				return npos;
+			}
+			word = m_words[i];
+		}
+		return i * bits_per_word + __builtin_ctzl(word);
+	}
+
+	void m_check_size(
+		const vector<bool, Allocator, GrowthPolicy> &x, const char *op) const {
+		if (x.m_size != m_size) {
+			throw std::invalid_argument(
+				std::string("vector: operator") + op + ": sizes differ");
+		}
+	}
+
+	template <class InputIterator>
+	void m_range_assign(InputIterator first, InputIterator last,
+		std::input_iterator_tag) {
+		clear();
+		for (; first != last; ++first) {
+			push_back(*first);
+		}
+	}
+
+	template <class ForwardIterator>
+	void m_range_assign(ForwardIterator first, ForwardIterator last,
+		std::forward_iterator_tag) {
+		const size_type n = ft::distance(first, last);
+		m_reset(n);
+		m_size = n;
+		m_set_bits(0, first, last);
+	}
+
+	// Input iterators are read once into a vector of their own
+	template <class InputIterator>
+	void m_range_insert(iterator position, InputIterator first,
+		InputIterator last, std::input_iterator_tag) {
+		const vector<bool, Allocator, GrowthPolicy> bits(first, last);
+		insert(position, bits.begin(), bits.end());
+	}
+
+	template <class ForwardIterator>
+	void m_range_insert(iterator position, ForwardIterator first,
+		ForwardIterator last, std::forward_iterator_tag) {
+		const size_type pos = position - begin();
+		m_make_room(pos, ft::distance(first, last));
+		m_set_bits(pos, first, last);
+	}
+
+	// Sets the clear bits from pos to the range
+	template <class ForwardIterator>
+	void m_set_bits(
+		size_type pos, ForwardIterator first, ForwardIterator last) {
+		for (; first != last; ++first, ++pos) {
+			if (*first) {
+				m_words[pos / bits_per_word] |= word_type(1)
+					<< pos % bits_per_word;
+			}
+		}
+	}
+};
+
+template <class Allocator, class GrowthPolicy>
+const typename vector<bool, Allocator, GrowthPolicy>::size_type
+	vector<bool, Allocator, GrowthPolicy>::npos;
+
+template <class Allocator, class GrowthPolicy>
+bool operator==(const vector<bool, Allocator, GrowthPolicy> &x,
+	const vector<bool, Allocator, GrowthPolicy> &y) {
+	return x.size() == y.size()
+		&& ft::equal(x.words(), x.words() + detail::bit_words(x.size()),
+			y.words());
+}
+
+// Compares the first differing word, its lowest differing bit is the first
+// element that differs
+template <class Allocator, class GrowthPolicy>
+bool operator<(const vector<bool, Allocator, GrowthPolicy> &x,
+	const vector<bool, Allocator, GrowthPolicy> &y) {
+	const std::size_t n = ft::min(x.size(), y.size());
+	for (std::size_t i = 0; i < detail::bit_words(n); i++) {
+		detail::bit_word diff = x.words()[i] ^ y.words()[i];
+		if (i == n / detail::bits_per_word) {
+			diff &= detail::low_bits(n % detail::bits_per_word);
+		}
+		if (diff != 0) {
+			return (y.words()[i] & diff & -diff) != 0;
+		}
+	}
+	return x.size() < y.size();
+}
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator&(
+	const vector<bool, Allocator, GrowthPolicy> &x,
+	const vector<bool, Allocator, GrowthPolicy> &y) {
+	vector<bool, Allocator, GrowthPolicy> result(x);
+	return result &= y;
+}
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator|(
+	const vector<bool, Allocator, GrowthPolicy> &x,
+	const vector<bool, Allocator, GrowthPolicy> &y) {
+	vector<bool, Allocator, GrowthPolicy> result(x);
+	return result |= y;
+}
+
+template <class Allocator, class GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator^(
+	const vector<bool, Allocator, GrowthPolicy> &x,
+	const vector<bool, Allocator, GrowthPolicy> &y) {
+	vector<bool, Allocator, GrowthPolicy> result(x);
+	return result ^= y;
+}
+
+}  // namespace ft